@@ -0,0 +1,49 @@
+#
+# short_vector_dispatch(<target> <source> ...)
+#
+# Compile each kernel source once for every instruction set enabled by
+# the SSE, AVX2 and AVX512 options, and once for the scalar baseline.
+# Each variant is compiled with SHORT_VECTOR_ISA naming its instruction
+# set, which gives the library of that variant names of its own, and the
+# target is given SHORT_VECTOR_DISPATCH_<ISA> definitions naming the
+# variants that were built.
+#
+function(short_vector_dispatch target)
+  set(isas scalar)
+  if(SSE)
+    list(APPEND isas sse)
+  endif()
+  if(AVX2)
+    list(APPEND isas avx2)
+  endif()
+  if(AVX512)
+    list(APPEND isas avx512)
+  endif()
+
+  foreach(source ${ARGN})
+    get_filename_component(source_path ${source} ABSOLUTE)
+    get_filename_component(source_name ${source} NAME_WE)
+    foreach(isa ${isas})
+      string(TOUPPER ${isa} ISA)
+      set(variant ${CMAKE_CURRENT_BINARY_DIR}/short_vector_dispatch/${target}/${source_name}_${isa}.cpp)
+      set(content "#include \"${source_path}\"\n")
+      if(EXISTS ${variant})
+        file(READ ${variant} old_content)
+      else()
+        set(old_content "")
+      endif()
+      if(NOT content STREQUAL old_content)
+        file(WRITE ${variant} ${content})
+      endif()
+      target_sources(${target} PRIVATE ${variant})
+      set_source_files_properties(${variant} PROPERTIES
+        COMPILE_DEFINITIONS SHORT_VECTOR_ISA=${isa}
+        COMPILE_OPTIONS "${short_vector_${ISA}_OPTIONS}")
+    endforeach()
+  endforeach()
+
+  foreach(isa ${isas})
+    string(TOUPPER ${isa} ISA)
+    target_compile_definitions(${target} PRIVATE SHORT_VECTOR_DISPATCH_${ISA})
+  endforeach()
+endfunction()
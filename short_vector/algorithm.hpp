@@ -0,0 +1,417 @@
+#ifndef ALGORITHM_HPP_INCLUDED_2960413351782054719
+#define ALGORITHM_HPP_INCLUDED_2960413351782054719 1
+
+//
+// ... Standard header files
+//
+#include <cstdint>
+#include <cstdlib>
+
+//
+// ... System header files
+//
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Loops over arrays of values, one short vector at a time
+ *
+ * Each algorithm takes the short vector type V as its first template
+ * argument, which selects the instruction set, and an array of any
+ * length and alignment.  The first values are handled with masked
+ * loads and stores, up to the first output address aligned to
+ * V::alignment, then the body runs on whole short vectors with
+ * aligned stores, and the last values are again masked, so that no
+ * value is handled one at a time.
+ *
+ * Outputs larger than streaming_threshold() bytes are written with
+ * non-temporal stores, which bypass the caches: a sweep over an array
+ * that does not fit in the last level cache would only evict the
+ * data around it.
+ */
+namespace ShortVector::Private
+{
+
+  namespace Algorithms
+  {
+    /** The size in bytes of the last level cache, if the system tells */
+    inline size_type
+    cache_size(){
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+      long l3 = sysconf( _SC_LEVEL3_CACHE_SIZE );
+      if( l3 > 0 ) return size_type( l3 );
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+      long l2 = sysconf( _SC_LEVEL2_CACHE_SIZE );
+      if( l2 > 0 ) return size_type( l2 );
+#endif
+      return size_type( 32 ) << 20;
+    }
+
+    /** The number of values before the first address aligned to
+     *  alignment, or 0 if the values are not themselves aligned */
+    template< typename T >
+    size_type
+    misalignment( T const* ptr, size_type alignment ){
+      std::uintptr_t offset = std::uintptr_t( ptr ) % std::uintptr_t( alignment );
+      if( offset == 0 || offset % sizeof(T) != 0 ) return 0;
+      return size_type(( std::uintptr_t( alignment ) - offset )/sizeof(T));
+    }
+
+    /** Order the non-temporal stores before any later store */
+    inline void
+    fence(){
+#if defined(__SSE2__)
+      _mm_sfence();
+#endif
+    }
+
+    /** Call body( i, m, whole ) for the masked head, every whole short
+     *  vector and the masked tail of n values from ptr
+     *
+     * The head ends at the first aligned address, and whole tells that
+     * the mask is full and ptr + i aligned.  Values not themselves
+     * aligned to their size are all handled with masks.
+     */
+    template< typename V, typename F >
+    void
+    sweep( typename V::value_type const* ptr, size_type n, F&& body ){
+      using mask_type = typename V::mask_type;
+      constexpr size_type extent = V::extent;
+
+      size_type head = misalignment( ptr, V::alignment );
+      head = head < n ? head : n;
+      if( head > 0 ){
+	body( size_type( 0 ), mask_type::first( head ), false );
+      }
+
+      bool aligned = std::uintptr_t( ptr + head ) % std::uintptr_t( V::alignment ) == 0;
+      size_type i = head;
+      for( ; i + extent <= n; i += extent ){
+	body( i, mask_type( true ), aligned );
+      }
+
+      if( i < n ){
+	body( i, mask_type::first( n - i ), false );
+      }
+    }
+
+  } // end of namespace Algorithms
+
+
+  /** The number of bytes written by an algorithm beyond which its
+   *  stores bypass the caches
+   *
+   * This is the size of the last level cache unless the environment
+   * variable SHORT_VECTOR_STREAM_THRESHOLD gives a number of bytes,
+   * and may be assigned.
+   */
+  inline size_type&
+  streaming_threshold(){
+    static size_type result = []{
+      if( char const* requested = std::getenv( "SHORT_VECTOR_STREAM_THRESHOLD" )){
+	return size_type( std::strtoll( requested, nullptr, 10 ));
+      }
+      return Algorithms::cache_size();
+    }();
+    return result;
+  }
+
+
+  namespace Algorithms
+  {
+    /** True if writing n values of type T should bypass the caches */
+    template< typename T >
+    bool
+    streams( size_type n ){
+      return size_type( sizeof(T))*n > streaming_threshold();
+    }
+
+    template< typename V, typename F >
+    void
+    transform( typename V::value_type const* in, size_type n, typename V::value_type* out, F&& f,
+	       bool streaming ){
+      using value_type = typename V::value_type;
+
+      sweep<V>( out, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	if( whole ){
+	  V x = V::load( unaligned<value_type>{ const_cast<value_type*>( in + i ) });
+	  if( streaming ){
+	    V( f( x )).store( stream<value_type>{ out + i });
+	  } else {
+	    V( f( x )).store( out + i );
+	  }
+	} else {
+	  V( f( V( in + i, m ))).store( out + i, m );
+	}
+      });
+
+      if( streaming ) fence();
+    }
+
+    template< typename V, typename F >
+    void
+    transform( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+	       typename V::value_type* out, F&& f, bool streaming ){
+      using value_type = typename V::value_type;
+
+      sweep<V>( out, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	if( whole ){
+	  V x = V::load( unaligned<value_type>{ const_cast<value_type*>( in1 + i ) });
+	  V y = V::load( unaligned<value_type>{ const_cast<value_type*>( in2 + i ) });
+	  if( streaming ){
+	    V( f( x, y )).store( stream<value_type>{ out + i });
+	  } else {
+	    V( f( x, y )).store( out + i );
+	  }
+	} else {
+	  V( f( V( in1 + i, m ), V( in2 + i, m ))).store( out + i, m );
+	}
+      });
+
+      if( streaming ) fence();
+    }
+
+    template< typename V, typename F >
+    void
+    for_each( typename V::value_type* data, size_type n, F&& f ){
+      sweep<V>( data, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	if( whole ){
+	  V x = V::load( data + i );
+	  f( x );
+	  x.store( data + i );
+	} else {
+	  V x( data + i, m );
+	  f( x );
+	  x.store( data + i, m );
+	}
+      });
+    }
+
+    template< typename V >
+    void
+    fill( typename V::value_type* data, size_type n, typename V::value_type x, bool streaming ){
+      using value_type = typename V::value_type;
+      V xs( x );
+
+      sweep<V>( data, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	if( whole && streaming ){
+	  xs.store( stream<value_type>{ data + i });
+	} else if( whole ){
+	  xs.store( data + i );
+	} else {
+	  xs.store( data + i, m );
+	}
+      });
+
+      if( streaming ) fence();
+    }
+
+    /** The reductions of the lanes of the values seen so far
+     *
+     * Lanes seen for the first time take the value itself, so that
+     * no identity of the reduction is needed.
+     */
+    template< typename V >
+    struct Accumulator
+    {
+      using value_type = typename V::value_type;
+      using mask_type = typename V::mask_type;
+
+      explicit
+      Accumulator( value_type init ) : result( init ), seen( false ), full( false )
+      {}
+
+      template< typename R >
+      void
+      add( R& reduce, V const& x, mask_type const& m ){
+	if( full && all( m )){
+	  result = reduce( result, x );
+	} else {
+	  result = cond( m, cond( seen, V( reduce( result, x )), x ), result );
+	  seen = seen | m;
+	  full = all( seen );
+	}
+      }
+
+      /** The reduction of total and the lanes seen */
+      template< typename R >
+      value_type
+      fold( value_type total, R& reduce ) const {
+	for( size_type k = 0; k < V::extent; ++k ){
+	  if( seen[k] ) total = reduce( total, result[k] );
+	}
+	return total;
+      }
+
+      V result;
+      mask_type seen;
+      bool full;
+    }; // end of struct Accumulator
+
+    template< typename V, typename R, typename F >
+    void
+    transform_reduce( typename V::value_type const* in, size_type n, Accumulator<V>& accumulator,
+		      R& reduce, F& f ){
+      sweep<V>( in, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	accumulator.add( reduce, V( f( whole ? V::load( in + i ) : V( in + i, m ))), m );
+      });
+    }
+
+    template< typename V, typename R, typename F >
+    void
+    transform_reduce( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+		      Accumulator<V>& accumulator, R& reduce, F& f ){
+      using value_type = typename V::value_type;
+
+      sweep<V>( in1, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	if( whole ){
+	  V x = V::load( in1 + i );
+	  V y = V::load( unaligned<value_type>{ const_cast<value_type*>( in2 + i ) });
+	  accumulator.add( reduce, V( f( x, y )), m );
+	} else {
+	  accumulator.add( reduce, V( f( V( in1 + i, m ), V( in2 + i, m ))), m );
+	}
+      });
+    }
+
+    /** The function returning its argument */
+    struct Identity
+    {
+      template< typename X >
+      X const&
+      operator ()( X const& x ) const { return x; }
+    }; // end of struct Identity
+
+    /** The sums of init and the values up to each value, or below it if
+     *  Exclusive, returning init and the sum of all the values
+     *
+     * Each short vector is scanned in its lanes, and the running total
+     * of the vectors before it, in every lane, is added to the scan.
+     */
+    template< bool Exclusive, typename V >
+    typename V::value_type
+    scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+	  typename V::value_type init, bool streaming ){
+      using value_type = typename V::value_type;
+      V carry( init );
+
+      sweep<V>( out, n, [&]( size_type i, typename V::mask_type const& m, bool whole ){
+	V x = whole ? V::load( unaligned<value_type>{ const_cast<value_type*>( in + i ) }) : V( in + i, m );
+	V sums = inclusive_scan( x );
+	V y = carry + ( Exclusive ? shift_up<1>( sums, V( value_type( 0 ))) : sums );
+	if( whole && streaming ){
+	  y.store( stream<value_type>{ out + i });
+	} else if( whole ){
+	  y.store( out + i );
+	} else {
+	  y.store( out + i, m );
+	}
+	carry = carry + broadcast<V::extent - 1>( sums );
+      });
+
+      if( streaming ) fence();
+      return carry[0];
+    }
+
+  } // end of namespace Algorithms
+
+
+  /** out[i] = f( in[i] ), f taking and returning short vectors of type V */
+  template< typename V, typename F >
+  void
+  transform( typename V::value_type const* in, size_type n, typename V::value_type* out, F&& f ){
+    Algorithms::transform<V>( in, n, out, f, Algorithms::streams<typename V::value_type>( n ));
+  }
+
+  /** out[i] = f( in1[i], in2[i] ) */
+  template< typename V, typename F >
+  void
+  transform( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+	     typename V::value_type* out, F&& f ){
+    Algorithms::transform<V>( in1, in2, n, out, f, Algorithms::streams<typename V::value_type>( n ));
+  }
+
+  /** Call f on each short vector of the values, storing what f leaves
+   *  in it, f taking a short vector of type V by reference */
+  template< typename V, typename F >
+  void
+  for_each( typename V::value_type* data, size_type n, F&& f ){
+    Algorithms::for_each<V>( data, n, f );
+  }
+
+  /** Set the values to x */
+  template< typename V >
+  void
+  fill( typename V::value_type* data, size_type n, typename V::value_type x ){
+    Algorithms::fill<V>( data, n, x, Algorithms::streams<typename V::value_type>( n ));
+  }
+
+  /** The reduction of init and f( in[i] ) for every i
+   *
+   * The reduction must be associative and commutative, as the values
+   * are reduced lane by lane before the lanes are, and is called both
+   * on short vectors of type V and on values, as a generic lambda or
+   * std::plus<> are.
+   */
+  template< typename V, typename R, typename F >
+  typename V::value_type
+  transform_reduce( typename V::value_type const* in, size_type n, typename V::value_type init,
+		    R&& reduce, F&& f ){
+    Algorithms::Accumulator<V> accumulator( init );
+    Algorithms::transform_reduce<V>( in, n, accumulator, reduce, f );
+    return accumulator.fold( init, reduce );
+  }
+
+  /** The reduction of init and f( in1[i], in2[i] ) for every i */
+  template< typename V, typename R, typename F >
+  typename V::value_type
+  transform_reduce( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+		    typename V::value_type init, R&& reduce, F&& f ){
+    Algorithms::Accumulator<V> accumulator( init );
+    Algorithms::transform_reduce<V>( in1, in2, n, accumulator, reduce, f );
+    return accumulator.fold( init, reduce );
+  }
+
+  /** The reduction of init and the values */
+  template< typename V, typename R >
+  typename V::value_type
+  reduce( typename V::value_type const* in, size_type n, typename V::value_type init, R&& reduce ){
+    return transform_reduce<V>( in, n, init, reduce, Algorithms::Identity{} );
+  }
+
+  /** out[i] = init + in[0] + ... + in[i], returning the sum of init and
+   *  all the values
+   *
+   * The values are added in a tree within each short vector, so that
+   * floating point sums may differ from those added one by one.  The
+   * output may be the input.
+   */
+  template< typename V >
+  typename V::value_type
+  inclusive_scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+		  typename V::value_type init = typename V::value_type( 0 )){
+    return Algorithms::scan<false,V>( in, n, out, init, Algorithms::streams<typename V::value_type>( n ));
+  }
+
+  /** out[i] = init + in[0] + ... + in[i-1], returning the sum of init
+   *  and all the values */
+  template< typename V >
+  typename V::value_type
+  exclusive_scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+		  typename V::value_type init = typename V::value_type( 0 )){
+    return Algorithms::scan<true,V>( in, n, out, init, Algorithms::streams<typename V::value_type>( n ));
+  }
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined ALGORITHM_HPP_INCLUDED_2960413351782054719
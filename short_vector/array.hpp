@@ -0,0 +1,232 @@
+#ifndef ARRAY_HPP_INCLUDED_8830142567301927645
+#define ARRAY_HPP_INCLUDED_8830142567301927645 1
+
+//
+// ... Standard header files
+//
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+namespace ShortVector::Private
+{
+
+  /** Arrays of values of type T stored as whole short vectors
+   *
+   * The values of each field are padded with zeros to a whole number
+   * of tiles of N values, and each field begins on a cache line, so
+   * that every tile is aligned and no loop over the tiles needs a
+   * scalar tail.  The fields of a structure of arrays, such as the
+   * coordinates and masses of particles, share a single allocation.
+   */
+  template< typename T, size_type N, size_type Align, typename Inst = auto_tag >
+  class Short_vector_array
+  {
+  public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+
+    using short_vector = Short_vector<T,N,Align,Inst>;
+    using view_type = Short_view<T,N,Align,Inst>;
+
+    static constexpr size_type extent = N;
+    static constexpr size_type cache_line = 64;
+    static constexpr size_type alignment = Align > cache_line ? Align : cache_line;
+
+    static_assert( std::is_trivially_copyable_v<T>, "The values must be trivially copyable" );
+    static_assert( N*size_type( sizeof(T)) % Align == 0,
+		   "Every tile must be as aligned as the first" );
+
+    /** The tiles of a field, as views */
+    class Tiles
+    {
+    public:
+      class iterator
+      {
+      public:
+	using value_type = view_type;
+	using reference = view_type;
+	using difference_type = size_type;
+	using iterator_category = std::input_iterator_tag;
+
+	explicit
+	iterator( pointer input ) : ptr( input )
+	{}
+
+	view_type
+	operator *() const { return view_type( ptr ); }
+
+	iterator&
+	operator ++(){
+	  ptr += extent;
+	  return *this;
+	}
+
+	iterator
+	operator ++( int ){
+	  iterator result = *this;
+	  ptr += extent;
+	  return result;
+	}
+
+	friend bool
+	operator ==( iterator const& a, iterator const& b ){
+	  return a.ptr == b.ptr;
+	}
+
+	friend bool
+	operator !=( iterator const& a, iterator const& b ){
+	  return a.ptr != b.ptr;
+	}
+
+      private:
+	pointer ptr;
+      }; // end of class iterator
+
+      Tiles( pointer input, size_type n ) : ptr( input ), count( n )
+      {}
+
+      iterator
+      begin() const { return iterator( ptr ); }
+
+      iterator
+      end() const { return iterator( ptr + count*extent ); }
+
+      size_type
+      size() const { return count; }
+
+      view_type
+      operator []( size_type k ) const { return view_type( ptr + k*extent ); }
+
+    private:
+      pointer ptr;
+      size_type count;
+    }; // end of class Tiles
+
+
+    /** An array of size values in each of its fields, all zero */
+    explicit
+    Short_vector_array( size_type size, size_type fields = 1 )
+      : length( size ), width( fields ), spacing( padded( size )), values( allocate( fields*spacing ))
+    {}
+
+    Short_vector_array( Short_vector_array const& input )
+      : length( input.length ), width( input.width ), spacing( input.spacing ),
+	values( allocate( width*spacing ))
+    {
+      std::copy_n( input.values.get(), width*spacing, values.get());
+    }
+
+    Short_vector_array( Short_vector_array&& input ) = default;
+
+    Short_vector_array&
+    operator =( Short_vector_array const& input ){
+      if( this != &input ){
+	*this = Short_vector_array( input );
+      }
+      return *this;
+    }
+
+    Short_vector_array&
+    operator =( Short_vector_array&& input ) = default;
+
+    /** The number of values in each field */
+    size_type
+    size() const { return length; }
+
+    size_type
+    fields() const { return width; }
+
+    /** The number of tiles in each field, including the padding */
+    size_type
+    tiles() const { return spacing/extent; }
+
+    /** The number of values from one field to the next */
+    size_type
+    stride() const { return spacing; }
+
+    pointer
+    data( size_type f = 0 ){ return values.get() + f*spacing; }
+
+    const_pointer
+    data( size_type f = 0 ) const { return values.get() + f*spacing; }
+
+    reference
+    operator []( size_type i ){ return values[ i ]; }
+
+    const_reference
+    operator []( size_type i ) const { return values[ i ]; }
+
+    /** Value i of field f */
+    reference
+    operator ()( size_type f, size_type i ){ return values[ f*spacing + i ]; }
+
+    const_reference
+    operator ()( size_type f, size_type i ) const { return values[ f*spacing + i ]; }
+
+    /** Tile k of field f */
+    view_type
+    tile( size_type f, size_type k ){
+      assert( f < width && k < tiles());
+      return view_type( data( f ) + k*extent );
+    }
+
+    view_type
+    tile( size_type k ){ return tile( 0, k ); }
+
+    Tiles
+    field( size_type f ){
+      assert( f < width );
+      return Tiles( data( f ), tiles());
+    }
+
+    /** The tiles of the first field */
+    typename Tiles::iterator
+    begin(){ return field( 0 ).begin(); }
+
+    typename Tiles::iterator
+    end(){ return field( 0 ).end(); }
+
+  private:
+    struct Deallocate
+    {
+      void
+      operator ()( pointer ptr ) const {
+	::operator delete( ptr, std::align_val_t( alignment ));
+      }
+    }; // end of struct Deallocate
+
+    /** The size rounded up to whole tiles and whole cache lines, the
+     *  least common multiple of the two */
+    static constexpr size_type
+    padded( size_type size ){
+      constexpr size_type unit = std::lcm( alignment/size_type( sizeof(T)), extent );
+      return ( size + unit - 1 )/unit*unit;
+    }
+
+    static std::unique_ptr<value_type[],Deallocate>
+    allocate( size_type count ){
+      pointer ptr = static_cast<pointer>(
+	::operator new( size_type( sizeof(T))*( count > 0 ? count : 1 ), std::align_val_t( alignment )));
+      std::fill_n( ptr, count, value_type( 0 ));
+      return std::unique_ptr<value_type[],Deallocate>( ptr );
+    }
+
+    size_type length;
+    size_type width;
+    size_type spacing;
+    std::unique_ptr<value_type[],Deallocate> values;
+  }; // end of class Short_vector_array
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined ARRAY_HPP_INCLUDED_8830142567301927645
@@ -0,0 +1,22 @@
+#ifndef AVX_COMPLEX_HPP_INCLUDED_8853102476619302587
+#define AVX_COMPLEX_HPP_INCLUDED_8853102476619302587 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/complex.hpp>
+#include <short_vector/avx/m256.hpp>
+#include <short_vector/avx/m256d.hpp>
+
+namespace AVX
+{
+
+  /** Four complex floats, interleaved */
+  using complex_m256 = ShortVector::Private::Interleaved_complex<m256>;
+
+  /** Two complex doubles, interleaved */
+  using complex_m256d = ShortVector::Private::Interleaved_complex<m256d>;
+
+} // end of namespace AVX
+
+#endif // ! defined AVX_COMPLEX_HPP_INCLUDED_8853102476619302587
@@ -0,0 +1,113 @@
+#ifndef AVX_CONVERT_HPP_INCLUDED_5120688379412650321
+#define AVX_CONVERT_HPP_INCLUDED_5120688379412650321 1
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/half.hpp>
+#include <short_vector/avx/m256.hpp>
+#include <short_vector/avx/m256d.hpp>
+
+/** Conversions between the lane types of the AVX registers
+ *
+ * A register of floats widens to two registers of doubles, the first
+ * holding its first four lanes, and two registers of doubles narrow to
+ * one of floats, rounding to nearest even.  Halves and bfloat16 values
+ * are loaded and stored eight at a time, at any alignment, through the
+ * F16C instructions where the compiler targets them.
+ */
+namespace AVX
+{
+
+  using ShortVector::Private::half;
+  using ShortVector::Private::bfloat16;
+
+  inline array<m256d,2>
+  widen( m256 const& a ){
+    return {{ m256d( _mm256_cvtps_pd( _mm256_castps256_ps128( a.bits()))),
+	      m256d( _mm256_cvtps_pd( _mm256_extractf128_ps( a.bits(), 1 ))) }};
+  }
+
+  inline m256
+  narrow( m256d const& lo, m256d const& hi ){
+    return m256( _mm256_set_m128( _mm256_cvtpd_ps( hi.bits()), _mm256_cvtpd_ps( lo.bits())));
+  }
+
+  inline m256
+  widen( half const* ptr ){
+#if defined(__F16C__)
+    return m256( _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<__m128i const*>( ptr ))));
+#else
+    alignas(32) float buffer[8];
+    for( size_type i = 0; i < 8; ++i ){
+      buffer[i] = float( ptr[i] );
+    }
+    return m256( buffer );
+#endif
+  }
+
+  inline void
+  narrow( m256 const& a, half* ptr ){
+#if defined(__F16C__)
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( ptr ), _mm256_cvtps_ph( a.bits(), _MM_FROUND_TO_NEAREST_INT ));
+#else
+    alignas(32) float buffer[8];
+    a.store( buffer );
+    for( size_type i = 0; i < 8; ++i ){
+      ptr[i] = half( buffer[i] );
+    }
+#endif
+  }
+
+  inline m256
+  widen( bfloat16 const* ptr ){
+    __m256i x = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<__m128i const*>( ptr )));
+    return m256( _mm256_castsi256_ps( _mm256_slli_epi32( x, 16 )));
+  }
+
+  /** Store the upper halves of the lanes, rounded to nearest even,
+   *  with NaNs kept quiet */
+  inline void
+  narrow( m256 const& a, bfloat16* ptr ){
+    __m256i x = _mm256_castps_si256( a.bits());
+    __m256i odd = _mm256_and_si256( _mm256_srli_epi32( x, 16 ), _mm256_set1_epi32( 1 ));
+    __m256i rounded = _mm256_add_epi32( x, _mm256_add_epi32( _mm256_set1_epi32( 0x7fff ), odd ));
+    __m256i quiet = _mm256_or_si256( x, _mm256_set1_epi32( 0x400000 ));
+    __m256 nan = _mm256_cmp_ps( a.bits(), a.bits(), _CMP_UNORD_Q );
+    __m256i y = _mm256_srli_epi32( _mm256_castps_si256(
+      _mm256_blendv_ps( _mm256_castsi256_ps( rounded ), _mm256_castsi256_ps( quiet ), nan )), 16 );
+    // The pack works within the halves of the register
+    __m256i packed = _mm256_permute4x64_epi64( _mm256_packus_epi32( y, y ), 0x08 );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( ptr ), _mm256_castsi256_si128( packed ));
+  }
+
+} // end of namespace AVX
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Conversions<avx_tag>
+  {
+    static array<AVX::m256d,2>
+    widen( AVX::m256 const& a ){ return AVX::widen( a ); }
+
+    static AVX::m256
+    narrow( AVX::m256d const& lo, AVX::m256d const& hi ){ return AVX::narrow( lo, hi ); }
+
+    template< typename H >
+    static AVX::m256
+    widen( H const* ptr ){ return AVX::widen( ptr ); }
+
+    template< typename H >
+    static void
+    narrow( AVX::m256 const& a, H* ptr ){ AVX::narrow( a, ptr ); }
+  };
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined AVX_CONVERT_HPP_INCLUDED_5120688379412650321
@@ -10,21 +10,145 @@
 // ... Short Vector header files
 //
 #include <short_vector/avx/utility.hpp>
+#include <short_vector/avx/m256i.hpp>
 
 namespace AVX
 {
   struct unaligned_tag{};
   struct stream_tag{};
   
+  /** The result of comparing two m256 registers
+   *
+   * Each lane holds the raw bits of the comparison, all set where it
+   * holds and all clear elsewhere, as used by the blend instructions.
+   */
+  class m256_mask
+  {
+  public:
+
+    static constexpr size_type extent = 8;
+
+    m256_mask(){}
+
+    m256_mask( m256_mask const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m256_mask( __m256 input ){
+      data = input;
+    }
+
+    explicit
+    m256_mask( bool input ){
+      data = input ? all_set() : _mm256_setzero_ps();
+    }
+
+    m256_mask&
+    operator =( m256_mask const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    /** The raw bits of the comparison */
+    __m256
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static m256_mask
+    first( size_type n ){
+      return m256_mask( _mm256_castsi256_ps( leading_bytes( n*size_type( sizeof(float) ))));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( _mm256_movemask_ps( data ) >> i ) & 1;
+    }
+
+    friend m256_mask
+    operator &( m256_mask const& a, m256_mask const& b ){
+      return m256_mask( _mm256_and_ps( a.data, b.data ));
+    }
+
+    friend m256_mask
+    operator |( m256_mask const& a, m256_mask const& b ){
+      return m256_mask( _mm256_or_ps( a.data, b.data ));
+    }
+
+    friend m256_mask
+    operator ^( m256_mask const& a, m256_mask const& b ){
+      return m256_mask( _mm256_xor_ps( a.data, b.data ));
+    }
+
+    friend m256_mask
+    operator ~( m256_mask const& a ){
+      return m256_mask( _mm256_xor_ps( a.data, all_set()));
+    }
+
+    friend bool
+    any( m256_mask const& a ){
+      return _mm256_movemask_ps( a.data ) != 0;
+    }
+
+    friend bool
+    all( m256_mask const& a ){
+      return _mm256_movemask_ps( a.data ) == 0xFF;
+    }
+
+    friend bool
+    none( m256_mask const& a ){
+      return _mm256_movemask_ps( a.data ) == 0;
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( m256_mask const& a ){
+      int lanes = _mm256_movemask_ps( a.data );
+      return lanes ? __builtin_ctz( lanes ) : extent;
+    }
+
+    friend size_type
+    popcount( m256_mask const& a ){
+      return __builtin_popcount( _mm256_movemask_ps( a.data ));
+    }
+
+  private:
+
+    static __m256
+    all_set(){
+      return _mm256_castsi256_ps( _mm256_set1_epi32( -1 ));
+    }
+
+    __m256 data;
+  }; // end of class m256_mask
+
   class m256
   {
   public:
 
+    using value_type = float;
+
+    static constexpr size_type extent = 8;
+
+    /** The bits of precision of the estimates rsqrt and rcp */
+    static constexpr size_type estimate_precision = 12;
+
+    using mask_type = m256_mask;
+
     //
     // constructors
     // 
     m256(){}
 
+    m256( m256 const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m256( __m256 input ){
+      data = input;
+    }
+
     m256( float input ){
       data = _mm256_set1_ps(input);
     }
@@ -41,20 +165,110 @@ namespace AVX
       data =_mm256_castsi256_ps(_mm256_stream_load_si256((__m256i const*)s.ptr));
     }
 
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m256( float const* ptr, m256_mask const& m ){
+      data = _mm256_maskload_ps( ptr, _mm256_castps_si256( m.bits()));
+    }
+
     
     //
     // store
     //
     void
-    store( float* ptr ){
+    store( float* ptr ) const {
       _mm256_store_ps( ptr, data );
     }
 
     void
-    store( float* ptr, stream_tag){
+    store( float* ptr, stream_tag) const {
       _mm256_stream_ps( ptr, data );
     }
 
+    void
+    store( unaligned<float> const& u ) const {
+      _mm256_storeu_ps( u.ptr, data );
+    }
+
+    void
+    store( stream<float> const& s ) const {
+      _mm256_stream_ps( s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( float* ptr, m256_mask const& m ) const {
+      _mm256_maskstore_ps( ptr, _mm256_castps_si256( m.bits()), data );
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order */
+    static m256
+    gather( float const* base, m256i<std::int32_t> const& index ){
+      m256 result;
+      result.data = _mm256_i32gather_ps( base, index.bits(), 4 );
+      return result;
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m256
+    gather( float const* base, m256i<std::int32_t> const& index, m256_mask const& m ){
+      m256 result;
+      result.data = _mm256_mask_i32gather_ps( _mm256_setzero_ps(), base, index.bits(), m.bits(), 4 );
+      return result;
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.  AVX2
+     * has no scatter, so the lanes are stored one at a time unless
+     * AVX512VL provides the instruction.
+     */
+    void
+    scatter( float* base, m256i<std::int32_t> const& index ) const {
+#if defined(__AVX512VL__)
+      _mm256_i32scatter_ps( base, index.bits(), data, 4 );
+#else
+      alignas(32) std::int32_t offsets[ extent ];
+      alignas(32) float lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	base[ offsets[i] ] = lanes[i];
+      }
+#endif
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( float* base, m256i<std::int32_t> const& index, m256_mask const& m ) const {
+#if defined(__AVX512VL__)
+      _mm256_mask_i32scatter_ps( base, __mmask8( _mm256_movemask_ps( m.bits())), index.bits(), data, 4 );
+#else
+      alignas(32) std::int32_t offsets[ extent ];
+      alignas(32) float lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) base[ offsets[i] ] = lanes[i];
+      }
+#endif
+    }
+
     //
     // assignment
     //
@@ -165,6 +379,40 @@ namespace AVX
       return result;
     }
 
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for normal finite a.  Zero, subnormal and
+     * non-finite values are left to the caller.
+     */
+    friend m256
+    frexp( m256 const& a, m256& e ){
+      __m256i bits = _mm256_castps_si256( a.data );
+      __m256i biased = _mm256_srli_epi32( _mm256_slli_epi32( bits, 1 ), 24 );
+      e.data = _mm256_cvtepi32_ps( _mm256_sub_epi32( biased, _mm256_set1_epi32( 126 )));
+      m256 result;
+      result.data = _mm256_castsi256_ps( _mm256_or_si256( _mm256_and_si256( bits, _mm256_set1_epi32( int( 0x807FFFFF ))),
+							  _mm256_set1_epi32( 0x3F000000 )));
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e in [-252, 254]
+     *
+     * The power is applied in two halves, so that the result
+     * overflows to infinity and underflows gradually as std::ldexp.
+     */
+    friend m256
+    ldexp( m256 const& a, m256 const& e ){
+      __m256i n = _mm256_cvtps_epi32( e.data );
+      __m256i half = _mm256_srai_epi32( n, 1 );
+      m256 result;
+      result.data = _mm256_mul_ps( _mm256_mul_ps( a.data, power( half )), power( _mm256_sub_epi32( n, half )));
+      return result;
+    }
+
     //
     // binary operators
     //
@@ -196,6 +444,20 @@ namespace AVX
       return result;
     }
 
+    friend m256
+    min( m256 const& a, m256 const& b ){
+      m256 result;
+      result.data = _mm256_min_ps( a.data, b.data );
+      return result;
+    }
+
+    friend m256
+    max( m256 const& a, m256 const& b ){
+      m256 result;
+      result.data = _mm256_max_ps( a.data, b.data );
+      return result;
+    }
+
     //
     // trinary arithmetic
     //
@@ -228,71 +490,225 @@ namespace AVX
       return result;
     }
 
-    //
-    // binary comparison
-    //
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
     friend m256
-    operator ==( m256 const& a, m256 const& b ){
+    fmaddsub( m256 const& a, m256 const& b, m256 const& c ){
       m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_EQ_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
+      result.data = _mm256_fmaddsub_ps(a.data, b.data, c.data);
       return result;
     }
 
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
     friend m256
-    operator !=( m256 const& a, m256 const& b ){
-      m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_NEQ_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
-      return result;
+    add( m256_mask const& m, m256 const& a, m256 const& b ){
+      return cond( m, a + b, a );
     }
 
     friend m256
-    operator <( m256 const& a, m256 const& b ){
-      m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_LT_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
-      return result;
+    subtract( m256_mask const& m, m256 const& a, m256 const& b ){
+      return cond( m, a - b, a );
+    }
+
+    friend m256
+    multiply( m256_mask const& m, m256 const& a, m256 const& b ){
+      return cond( m, a*b, a );
     }
 
     friend m256
+    divide( m256_mask const& m, m256 const& a, m256 const& b ){
+      return cond( m, a/b, a );
+    }
+
+    //
+    // binary comparison
+    //
+    friend m256_mask
+    operator ==( m256 const& a, m256 const& b ){
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_EQ_OS) );
+    }
+
+    friend m256_mask
+    operator !=( m256 const& a, m256 const& b ){
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_NEQ_UQ) );
+    }
+
+    friend m256_mask
+    operator <( m256 const& a, m256 const& b ){
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_LT_OS) );
+    }
+
+    friend m256_mask
     operator <=( m256 const& a, m256 const& b ){
-      m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_LE_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
-      return result;
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_LE_OS) );
     }
 
     
-    friend m256
+    friend m256_mask
     operator >( m256 const& a, m256 const& b ){
-      m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_GT_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
-      return result;
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_GT_OS) );
     }
 
     
-    friend m256
+    friend m256_mask
     operator >=( m256 const& a, m256 const& b ){
-      m256 result;
-      result.data = _mm256_cmp_ps(a.data, b.data, _CMP_GE_OS);
-      result.data = _mm256_and_ps(result.data, _mm256_set1_ps(1.0f));
-      return result;
+      return m256_mask( _mm256_cmp_ps(a.data, b.data, _CMP_GE_OS) );
     }
 
     //
     // conditional
     //
     friend m256
-    cond( m256 const& test, m256 const& pass, m256 const& fail ){
-      return test*pass + (1.0f-test)*fail;
+    cond( m256_mask const& test, m256 const& pass, m256 const& fail ){
+      m256 result;
+      result.data = _mm256_blendv_ps( fail.data, pass.data, test.bits() );
+      return result;
     }
     
+    //
+    // horizontal reductions
+    //
+    friend float
+    hsum( m256 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_add_ps( x, y ); });
+    }
+
+    friend float
+    hprod( m256 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_mul_ps( x, y ); });
+    }
+
+    friend float
+    hmin( m256 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_min_ps( x, y ); });
+    }
+
+    friend float
+    hmax( m256 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_max_ps( x, y ); });
+    }
+
+    friend float
+    dot( m256 const& a, m256 const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m256 const& a ){
+      return find_first( a == m256( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m256 const& a ){
+      return find_first( a == m256( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type ... I >
+    static m256
+    shuffle( m256 const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m256 result;
+      if constexpr ( Lanes::repeats_in_blocks( index, 4 )){
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm256_permute_ps( a.data, immediate );
+      }
+      else if constexpr ( Lanes::moves_blocks( index, 4 )){
+	constexpr int immediate = int( index[0]/4 | index[4]/4 << 4 );
+	result.data = _mm256_permute2f128_ps( a.data, a.data, immediate );
+      }
+      else if constexpr ( Lanes::within_blocks( index, 4 )){
+	result.data = _mm256_permutevar_ps( a.data, _mm256_setr_epi32( int( I%4 ) ... ));
+      }
+      else {
+	result.data = _mm256_permutevar8x32_ps( a.data, _mm256_setr_epi32( int( I ) ... ));
+      }
+      return result;
+    }
+
+    template< size_type ... I >
+    static m256
+    shuffle( m256 const& a, m256 const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m256 result;
+      if constexpr ( Lanes::all_below( index, extent )){
+	result = shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	result = shuffle<( I - extent ) ...>( b );
+      }
+      else if constexpr ( Lanes::pairs_in_blocks( index, 4, extent )){
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm256_shuffle_ps( a.data, b.data, immediate );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, extent, false )){
+	result.data = _mm256_unpacklo_ps( a.data, b.data );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, extent, true )){
+	result.data = _mm256_unpackhi_ps( a.data, b.data );
+      }
+      else if constexpr ( Lanes::moves_blocks( index, 4 )){
+	constexpr int immediate = int( index[0]/4 | index[4]/4 << 4 );
+	result.data = _mm256_permute2f128_ps( a.data, b.data, immediate );
+      }
+      else {
+	constexpr int immediate = int( Lanes::beyond( index, extent ));
+	result.data = _mm256_blend_ps( shuffle<( I%extent ) ...>( a ).data,
+				       shuffle<( I%extent ) ...>( b ).data,
+				       immediate );
+      }
+      return result;
+    }
+
+    /** The raw register */
+    __m256
+    bits() const { return data; }
+
   private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines the upper half of the remaining lanes with
+     * the lower half, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static float
+    reduce( __m256 a, Op op ){
+      __m128 x = op( _mm256_castps256_ps128( a ), _mm256_extractf128_ps( a, 1 ));
+      x = op( x, _mm_movehl_ps( x, x ));
+      x = op( x, _mm_shuffle_ps( x, x, _MM_SHUFFLE( 1, 1, 1, 1 )));
+      return _mm_cvtss_f32( x );
+    }
+
+    /** 2 to the power n, for n in [-126, 127] */
+    static __m256
+    power( __m256i n ){
+      return _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_add_epi32( n, _mm256_set1_epi32( 127 )), 23 ));
+    }
+
     __m256 data;
-  }; // end of class 
+  }; // end of class m256
+  
+} // end of namespace AVX
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<float,avx_tag>
+  {
+    using type = AVX::m256;
+  };
   
-} // end of namespace AVX2
+} // end of namespace ShortVector::Private
 
 #endif // ! defined AVX_HPP_INCLUDED_1088355495191842989
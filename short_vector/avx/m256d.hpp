@@ -1,19 +1,143 @@
 #ifndef M256D_HPP_INCLUDED_558823014661372481
 #define M256D_HPP_INCLUDED_558823014661372481 1
 
-
+//
+// ... Intrinsics
+//
 #include <immintrin.h>
 
+//
+// ... Short Vector header files
+//
+#include <short_vector/avx/utility.hpp>
+#include <short_vector/avx/m256i.hpp>
 
 namespace AVX
 {
 
+  /** The result of comparing two m256d registers
+   *
+   * Each lane holds the raw bits of the comparison, all set where it
+   * holds and all clear elsewhere, as used by the blend instructions.
+   */
+  class m256d_mask
+  {
+  public:
+
+    static constexpr size_type extent = 4;
+
+    m256d_mask(){}
+
+    m256d_mask( m256d_mask const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m256d_mask( __m256d input ){
+      data = input;
+    }
+
+    explicit
+    m256d_mask( bool input ){
+      data = input ? all_set() : _mm256_setzero_pd();
+    }
+
+    m256d_mask&
+    operator =( m256d_mask const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    /** The raw bits of the comparison */
+    __m256d
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static m256d_mask
+    first( size_type n ){
+      return m256d_mask( _mm256_castsi256_pd( leading_bytes( n*size_type( sizeof(double) ))));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( _mm256_movemask_pd( data ) >> i ) & 1;
+    }
+
+    friend m256d_mask
+    operator &( m256d_mask const& a, m256d_mask const& b ){
+      return m256d_mask( _mm256_and_pd( a.data, b.data ));
+    }
+
+    friend m256d_mask
+    operator |( m256d_mask const& a, m256d_mask const& b ){
+      return m256d_mask( _mm256_or_pd( a.data, b.data ));
+    }
+
+    friend m256d_mask
+    operator ^( m256d_mask const& a, m256d_mask const& b ){
+      return m256d_mask( _mm256_xor_pd( a.data, b.data ));
+    }
+
+    friend m256d_mask
+    operator ~( m256d_mask const& a ){
+      return m256d_mask( _mm256_xor_pd( a.data, all_set()));
+    }
+
+    friend bool
+    any( m256d_mask const& a ){
+      return _mm256_movemask_pd( a.data ) != 0;
+    }
+
+    friend bool
+    all( m256d_mask const& a ){
+      return _mm256_movemask_pd( a.data ) == 0xF;
+    }
+
+    friend bool
+    none( m256d_mask const& a ){
+      return _mm256_movemask_pd( a.data ) == 0;
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( m256d_mask const& a ){
+      int lanes = _mm256_movemask_pd( a.data );
+      return lanes ? __builtin_ctz( lanes ) : extent;
+    }
+
+    friend size_type
+    popcount( m256d_mask const& a ){
+      return __builtin_popcount( _mm256_movemask_pd( a.data ));
+    }
+
+  private:
+
+    static __m256d
+    all_set(){
+      return _mm256_castsi256_pd( _mm256_set1_epi32( -1 ));
+    }
+
+    __m256d data;
+  }; // end of class m256d_mask
+
   class m256d
   {
   public:
 
     using value_type = double;
 
+    static constexpr size_type extent = 4;
+
+    /** The bits of precision of the estimates rsqrt and rcp, which
+     *  divide exactly without AVX512VL */
+#if defined(__AVX512VL__)
+    static constexpr size_type estimate_precision = 14;
+#else
+    static constexpr size_type estimate_precision = 53;
+#endif
+
+    using mask_type = m256d_mask;
+
     //
     // construction
     //
@@ -23,21 +147,34 @@ namespace AVX
     m256d(m256d const& input ){
       data = input.data;
     }
+
+    explicit
+    m256d( __m256d input ){
+      data = input;
+    }
     
     m256d(double input){
       data = _mm256_set1_pd(input);
     }
     
     m256d(double const* ptr ){
-      data = _m256_load_pd(ptr);
+      data = _mm256_load_pd(ptr);
     }
 
-    m256(unaligned<double> const& u ){
+    m256d(unaligned<double> const& u ){
       data = _mm256_loadu_pd(u.ptr);
     }
 
     m256d(stream<double> const& s){
-      data =_mm256_castsi256_psd(_mm256_stream_load_si256((__m256i const*)s.ptr));
+      data =_mm256_castsi256_pd(_mm256_stream_load_si256((__m256i const*)s.ptr));
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m256d( double const* ptr, m256d_mask const& m ){
+      data = _mm256_maskload_pd( ptr, _mm256_castpd_si256( m.bits()));
     }
 
     //
@@ -45,15 +182,92 @@ namespace AVX
     //
 
     void
-    store( double* ptr ){
+    store( double* ptr ) const {
       _mm256_store_pd( ptr, data );
     }
 
     void
-    store( stream<double>& s ){
+    store( unaligned<double> const& u ) const {
+      _mm256_storeu_pd( u.ptr, data );
+    }
+
+    void
+    store( stream<double> const& s ) const {
       _mm256_stream_pd( s.ptr, data );
     }
 
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( double* ptr, m256d_mask const& m ) const {
+      _mm256_maskstore_pd( ptr, _mm256_castpd_si256( m.bits()), data );
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order */
+    static m256d
+    gather( double const* base, m256i<std::int64_t> const& index ){
+      m256d result;
+      result.data = _mm256_i64gather_pd( base, index.bits(), 8 );
+      return result;
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m256d
+    gather( double const* base, m256i<std::int64_t> const& index, m256d_mask const& m ){
+      m256d result;
+      result.data = _mm256_mask_i64gather_pd( _mm256_setzero_pd(), base, index.bits(), m.bits(), 8 );
+      return result;
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.  AVX2
+     * has no scatter, so the lanes are stored one at a time unless
+     * AVX512VL provides the instruction.
+     */
+    void
+    scatter( double* base, m256i<std::int64_t> const& index ) const {
+#if defined(__AVX512VL__)
+      _mm256_i64scatter_pd( base, index.bits(), data, 8 );
+#else
+      alignas(32) std::int64_t offsets[ extent ];
+      alignas(32) double lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	base[ offsets[i] ] = lanes[i];
+      }
+#endif
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( double* base, m256i<std::int64_t> const& index, m256d_mask const& m ) const {
+#if defined(__AVX512VL__)
+      _mm256_mask_i64scatter_pd( base, __mmask8( _mm256_movemask_pd( m.bits())), index.bits(), data, 8 );
+#else
+      alignas(32) std::int64_t offsets[ extent ];
+      alignas(32) double lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) base[ offsets[i] ] = lanes[i];
+      }
+#endif
+    }
+
     //
     // assignment
     //
@@ -78,7 +292,7 @@ namespace AVX
 
     m256d&
     operator =(stream<double> const& s){
-      data = _mm256_castsi256_psd(_mm256_stream_load_si256((__m256i const*)s.ptr));
+      data = _mm256_castsi256_pd(_mm256_stream_load_si256((__m256i const*)s.ptr));
       return *this;
     }
 
@@ -86,7 +300,7 @@ namespace AVX
     // compound assignment
     // 
     m256d&
-    operator +=( m256 const& b ){
+    operator +=( m256d const& b ){
       data = _mm256_add_pd(data, b.data);
       return *this;
     }
@@ -97,14 +311,14 @@ namespace AVX
       return *this;
     }
 
-    m256&
-    operator *=( m256 const& b ){
+    m256d&
+    operator *=( m256d const& b ){
       data = _mm256_mul_pd(data, b.data);
       return *this;
     }
 
-    m256&
-    operator /=( m256 const& b ){
+    m256d&
+    operator /=( m256d const& b ){
       data = _mm256_div_pd(data, b.data);
       return *this;
     }
@@ -119,7 +333,7 @@ namespace AVX
     
     friend m256d
     abs(m256d const& a){
-      return cond(a < 0.0f, neg(a ), a);
+      return cond(a < 0.0, neg(a), a);
     }
 
     friend m256d
@@ -152,141 +366,349 @@ namespace AVX
 
     friend m256d
     rsqrt(m256d const& a){
+#if defined(__AVX512VL__)
+      m256d result;
+      result.data = _mm256_rsqrt14_pd(a.data);
+      return result;
+#else
       return 1.0/sqrt(a);
+#endif
     }
 
     friend m256d
     rcp(m256d const& a){
+#if defined(__AVX512VL__)
+      m256d result;
+      result.data = _mm256_rcp14_pd(a.data);
+      return result;
+#else
       return 1.0/a;
+#endif
+    }
+
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for normal finite a.  Zero, subnormal and
+     * non-finite values are left to the caller.  The exponent is
+     * converted by placing it in the significand of 2^52.
+     */
+    friend m256d
+    frexp( m256d const& a, m256d& e ){
+      __m256i bits = _mm256_castpd_si256( a.data );
+      __m256i biased = _mm256_srli_epi64( _mm256_slli_epi64( bits, 1 ), 53 );
+      e.data = _mm256_sub_pd( _mm256_castsi256_pd( _mm256_or_si256( biased, _mm256_set1_epi64x( 0x4330000000000000ll ))),
+			      _mm256_set1_pd( 4503599627370496.0 + 1022.0 ));
+      m256d result;
+      result.data = _mm256_castsi256_pd( _mm256_or_si256( _mm256_and_si256( bits, _mm256_set1_epi64x( 0x800FFFFFFFFFFFFFll )),
+							 _mm256_set1_epi64x( 0x3FE0000000000000ll )));
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e in [-2044, 2046]
+     *
+     * The power is applied in two halves, so that the result
+     * overflows to infinity and underflows gradually as std::ldexp.
+     */
+    friend m256d
+    ldexp( m256d const& a, m256d const& e ){
+      __m128i n = _mm256_cvtpd_epi32( e.data );
+      __m128i half = _mm_srai_epi32( n, 1 );
+      m256d result;
+      result.data = _mm256_mul_pd( _mm256_mul_pd( a.data, power( half )), power( _mm_sub_epi32( n, half )));
+      return result;
     }
     
     //
     // binary arithmetic operators
     // 
     friend m256d
-    operator +(m256 const& a, m256 const& b ){
-      m256 result;
+    operator +(m256d const& a, m256d const& b ){
+      m256d result;
       result.data = _mm256_add_pd( a.data, b.data );
       return result;
     }
 
     friend m256d
-    operator -(m256 const& a, m256 const& b ){
-      m256 result;
+    operator -(m256d const& a, m256d const& b ){
+      m256d result;
       result.data = _mm256_sub_pd( a.data, b.data );
       return result;
     }
 
     friend m256d
-    operator *(m256 const& a, m256 const& b ){
-      m256 result;
+    operator *(m256d const& a, m256d const& b ){
+      m256d result;
       result.data = _mm256_mul_pd( a.data, b.data );
       return result;
     }
 
     friend m256d
-    operator /(m256 const& a, m256 const& b ){
-      m256 result;
+    operator /(m256d const& a, m256d const& b ){
+      m256d result;
       result.data = _mm256_div_pd( a.data, b.data );
       return result;
     }
+
+    friend m256d
+    min( m256d const& a, m256d const& b ){
+      m256d result;
+      result.data = _mm256_min_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m256d
+    max( m256d const& a, m256d const& b ){
+      m256d result;
+      result.data = _mm256_max_pd( a.data, b.data );
+      return result;
+    }
     
     //
     // trinary arithmetic
     //
     
     friend m256d
-    fmadd(m256d const& a, m256d const& b, m256d const& c){
+    fma(m256d const& a, m256d const& b, m256d const& c){
       m256d result;
-      result.data = _m256_fmadd_pd(a.data, b.data, c.data);
+      result.data = _mm256_fmadd_pd(a.data, b.data, c.data);
       return result;
     }
 
     friend m256d
-    fmsub(m256d const& a, m256d const& b, m256d const& c){
+    fms(m256d const& a, m256d const& b, m256d const& c){
       m256d result;
-      result.data = _m256_fmsub_pd(a.data, b.data, c.data);
+      result.data = _mm256_fmsub_pd(a.data, b.data, c.data);
       return result;
     }
 
     friend m256d
-    fnmadd(m256d const& a, m256d const& b, m256d const& c){
+    fnma(m256d const& a, m256d const& b, m256d const& c){
       m256d result;
-      result.data = _m256_fnmadd_pd(a.data, b.data, c.data);
+      result.data = _mm256_fnmadd_pd(a.data, b.data, c.data);
       return result;
     }
 
     friend m256d
-    fnmsub(m256d const& a, m256d const& b, m256d const& c){
+    fnms(m256d const& a, m256d const& b, m256d const& c){
       m256d result;
-      result.data = _m256_fnmsub_pd(a.data, b.data, c.data);
+      result.data = _mm256_fnmsub_pd(a.data, b.data, c.data);
       return result;
     }
 
-    //
-    // binary comparison
-    //
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
     friend m256d
-    operator ==( m256d const& a, m256d const& b ){
+    fmaddsub(m256d const& a, m256d const& b, m256d const& c){
       m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_EQ_OS );
-      result.data = _mm256_xor_pd( result.data, _mm256_set1_pd( 1.0 ));
+      result.data = _mm256_fmaddsub_pd(a.data, b.data, c.data);
       return result;
     }
 
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m256d
+    add( m256d_mask const& m, m256d const& a, m256d const& b ){
+      return cond( m, a + b, a );
+    }
+
+    friend m256d
+    subtract( m256d_mask const& m, m256d const& a, m256d const& b ){
+      return cond( m, a - b, a );
+    }
+
+    friend m256d
+    multiply( m256d_mask const& m, m256d const& a, m256d const& b ){
+      return cond( m, a*b, a );
+    }
+
     friend m256d
+    divide( m256d_mask const& m, m256d const& a, m256d const& b ){
+      return cond( m, a/b, a );
+    }
+
+    //
+    // binary comparison
+    //
+    friend m256d_mask
+    operator ==( m256d const& a, m256d const& b ){
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_EQ_OS ) );
+    }
+
+    friend m256d_mask
     operator !=( m256d const& a, m256d const& b ){
-      m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_NEQ_OS );
-      result.data = _mm256_and_pd( result.data, _mm256_set1_pd( 1.0 ));
-      return result;
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_NEQ_UQ ) );
     }
     
-    friend m256d
+    friend m256d_mask
     operator <( m256d const& a, m256d const& b ){
-      m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_LT_OS );
-      result.data = _mm256_andn_pd( result.data, _mm256_set1_pd( 1.0 ));
-      return result;
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_LT_OS ) );
     }
 
-    friend m256d
+    friend m256d_mask
     operator <=( m256d const& a, m256d const& b ){
-      m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_LE_OS );
-      result.data = _mm256_and_pd( result.data, _mm256_set1_pd( 1.0 ));
-      return result;
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_LE_OS ) );
     }
 
-    friend m256d
+    friend m256d_mask
     operator >( m256d const& a, m256d const& b ){
-      m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_GT_OS );
-      result.data = _mm256_and_pd( result.data, _mm256_set1_pd( 1.0 ));
-      return result;
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_GT_OS ) );
     }
     
-    friend m256d
+    friend m256d_mask
     operator >=( m256d const& a, m256d const& b ){
-      m256d result;
-      result.data = _mm256_cmp_pd( a.data, b.data, _CMP_GE_OS );
-      result.data = _mm256_and_pd( result.data, _mm256_set1_pd( 1.0 ));
-      return result;
+      return m256d_mask( _mm256_cmp_pd( a.data, b.data, _CMP_GE_OS ) );
     }
 
     //
     // conditional
     //
     friend m256d
-    cond( m256d const& test, m256d const& pass, m256d const& fail ){
-      return test*pass + (1.0-test)*fail;
+    cond( m256d_mask const& test, m256d const& pass, m256d const& fail ){
+      m256d result;
+      result.data = _mm256_blendv_pd( fail.data, pass.data, test.bits() );
+      return result;
     }
     
+    //
+    // horizontal reductions
+    //
+    friend double
+    hsum( m256d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_add_pd( x, y ); });
+    }
+
+    friend double
+    hprod( m256d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_mul_pd( x, y ); });
+    }
+
+    friend double
+    hmin( m256d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_min_pd( x, y ); });
+    }
+
+    friend double
+    hmax( m256d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_max_pd( x, y ); });
+    }
+
+    friend double
+    dot( m256d const& a, m256d const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m256d const& a ){
+      return find_first( a == m256d( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m256d const& a ){
+      return find_first( a == m256d( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type ... I >
+    static m256d
+    shuffle( m256d const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m256d result;
+      if constexpr ( Lanes::within_blocks( index, 2 )){
+	constexpr int immediate = Lanes::immediate2( index );
+	result.data = _mm256_permute_pd( a.data, immediate );
+      }
+      else if constexpr ( Lanes::moves_blocks( index, 2 )){
+	constexpr int immediate = int( index[0]/2 | index[2]/2 << 4 );
+	result.data = _mm256_permute2f128_pd( a.data, a.data, immediate );
+      }
+      else {
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm256_permute4x64_pd( a.data, immediate );
+      }
+      return result;
+    }
+
+    template< size_type ... I >
+    static m256d
+    shuffle( m256d const& a, m256d const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m256d result;
+      if constexpr ( Lanes::all_below( index, extent )){
+	result = shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	result = shuffle<( I - extent ) ...>( b );
+      }
+      else if constexpr ( Lanes::pairs_in_blocks( index, 2, extent )){
+	constexpr int immediate = Lanes::immediate2( index );
+	result.data = _mm256_shuffle_pd( a.data, b.data, immediate );
+      }
+      else if constexpr ( Lanes::moves_blocks( index, 2 )){
+	constexpr int immediate = int( index[0]/2 | index[2]/2 << 4 );
+	result.data = _mm256_permute2f128_pd( a.data, b.data, immediate );
+      }
+      else {
+	constexpr int immediate = int( Lanes::beyond( index, extent ));
+	result.data = _mm256_blend_pd( shuffle<( I%extent ) ...>( a ).data,
+				       shuffle<( I%extent ) ...>( b ).data,
+				       immediate );
+      }
+      return result;
+    }
+
+    /** The raw register */
+    __m256d
+    bits() const { return data; }
+
   private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines the upper half of the remaining lanes with
+     * the lower half, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static double
+    reduce( __m256d a, Op op ){
+      __m128d x = op( _mm256_castpd256_pd128( a ), _mm256_extractf128_pd( a, 1 ));
+      x = op( x, _mm_unpackhi_pd( x, x ));
+      return _mm_cvtsd_f64( x );
+    }
+
+    /** 2 to the power of the 32 bit n, for n in [-1022, 1023] */
+    static __m256d
+    power( __m128i n ){
+      __m256i biased = _mm256_add_epi64( _mm256_cvtepi32_epi64( n ), _mm256_set1_epi64x( 1023 ));
+      return _mm256_castsi256_pd( _mm256_slli_epi64( biased, 52 ));
+    }
+
     __m256d data;
-  }; // end of class m245d
+  }; // end of class m256d
   
   
 } // end of namespace AVX
 
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<double,avx_tag>
+  {
+    using type = AVX::m256d;
+  };
+  
+} // end of namespace ShortVector::Private
+
 #endif // ! defined M256D_HPP_INCLUDED_558823014661372481
@@ -0,0 +1,922 @@
+#ifndef M256I_HPP_INCLUDED_2039817420776136958
+#define M256I_HPP_INCLUDED_2039817420776136958 1
+
+//
+// ... Standard header files
+//
+#include <cstdint>
+#include <type_traits>
+
+//
+// ... Intrinsics
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/avx/utility.hpp>
+
+namespace AVX
+{
+
+  template< typename T >
+  class m256i;
+
+  /** The result of comparing two m256i<T> registers
+   *
+   * Each lane holds all ones where the comparison holds and zero
+   * elsewhere, as used by the byte blend instruction.
+   */
+  template< typename T >
+  class m256i_mask
+  {
+  public:
+
+    static constexpr size_type extent = 32/sizeof(T);
+
+    m256i_mask(){}
+
+    m256i_mask( m256i_mask const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m256i_mask( __m256i input ){
+      data = input;
+    }
+
+    explicit
+    m256i_mask( bool input ){
+      data = input ? _mm256_set1_epi32( -1 ) : _mm256_setzero_si256();
+    }
+
+    m256i_mask&
+    operator =( m256i_mask const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    /** The raw bits of the comparison */
+    __m256i
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static m256i_mask
+    first( size_type n ){
+      return m256i_mask( leading_bytes( n*size_type( sizeof(T) )));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( unsigned( _mm256_movemask_epi8( data )) >> ( i*sizeof(T) )) & 1;
+    }
+
+    friend m256i_mask
+    operator &( m256i_mask const& a, m256i_mask const& b ){
+      return m256i_mask( _mm256_and_si256( a.data, b.data ));
+    }
+
+    friend m256i_mask
+    operator |( m256i_mask const& a, m256i_mask const& b ){
+      return m256i_mask( _mm256_or_si256( a.data, b.data ));
+    }
+
+    friend m256i_mask
+    operator ^( m256i_mask const& a, m256i_mask const& b ){
+      return m256i_mask( _mm256_xor_si256( a.data, b.data ));
+    }
+
+    friend m256i_mask
+    operator ~( m256i_mask const& a ){
+      return m256i_mask( _mm256_xor_si256( a.data, _mm256_set1_epi32( -1 )));
+    }
+
+    friend bool
+    any( m256i_mask const& a ){
+      return ! _mm256_testz_si256( a.data, a.data );
+    }
+
+    friend bool
+    all( m256i_mask const& a ){
+      return _mm256_movemask_epi8( a.data ) == -1;
+    }
+
+    friend bool
+    none( m256i_mask const& a ){
+      return _mm256_testz_si256( a.data, a.data );
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( m256i_mask const& a ){
+      unsigned bytes = unsigned( _mm256_movemask_epi8( a.data ));
+      return bytes ? __builtin_ctz( bytes )/sizeof(T) : extent;
+    }
+
+    /** The byte mask holds one bit per byte, so sizeof(T) per lane */
+    friend size_type
+    popcount( m256i_mask const& a ){
+      return __builtin_popcount( unsigned( _mm256_movemask_epi8( a.data )))/sizeof(T);
+    }
+
+  private:
+
+    __m256i data;
+  }; // end of class m256i_mask
+
+  /** A register of 256 bits viewed as lanes of the integer type T
+   *
+   * The lanes may be signed or unsigned integers of 8, 16, 32 or 64
+   * bits.  Operations without an AVX2 instruction for the lane width,
+   * such as the 8 bit shifts and the 64 bit multiplication, are
+   * composed from instructions on wider or narrower lanes.
+   */
+  template< typename T >
+  class m256i
+  {
+  public:
+
+    static_assert( std::is_integral_v<T> && ! std::is_same_v<T,bool>,
+		   "The lanes of m256i must be integers" );
+
+    using value_type = T;
+
+    static constexpr size_type extent = 32/sizeof(T);
+
+    using mask_type = m256i_mask<T>;
+
+    /** The lanes of the indices of gathers and scatters */
+    using index_type = std::make_signed_t<T>;
+
+    //
+    // constructors
+    //
+    m256i(){}
+
+    m256i( m256i const& input ){
+      data = input.data;
+    }
+
+    m256i( value_type input ){
+      data = set1( input );
+    }
+
+    m256i( value_type const* ptr ){
+      data = _mm256_load_si256( (__m256i const*)ptr );
+    }
+
+    m256i( unaligned<value_type> const& u ){
+      data = _mm256_loadu_si256( (__m256i const*)u.ptr );
+    }
+
+    m256i( stream<value_type> const& s ){
+      data = _mm256_stream_load_si256( (__m256i const*)s.ptr );
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     * AVX2 masks loads of 32 and 64 bit lanes only, so narrower lanes
+     * are loaded one at a time.
+     */
+    m256i( value_type const* ptr, mask_type const& m ){
+      if constexpr ( sizeof(value_type) == 4 ){
+	data = _mm256_maskload_epi32( (int const*)ptr, m.bits());
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	data = _mm256_maskload_epi64( (long long const*)ptr, m.bits());
+      }
+      else {
+	alignas(32) value_type buffer[ extent ] = {};
+	for( size_type i = 0; i < extent; ++i ){
+	  if( m[i] ) buffer[i] = ptr[i];
+	}
+	data = _mm256_load_si256( (__m256i const*)buffer );
+      }
+    }
+
+    //
+    // store
+    //
+    void
+    store( value_type* ptr ) const {
+      _mm256_store_si256( (__m256i*)ptr, data );
+    }
+
+    void
+    store( unaligned<value_type> const& u ) const {
+      _mm256_storeu_si256( (__m256i*)u.ptr, data );
+    }
+
+    void
+    store( stream<value_type> const& s ) const {
+      _mm256_stream_si256( (__m256i*)s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( value_type* ptr, mask_type const& m ) const {
+      if constexpr ( sizeof(value_type) == 4 ){
+	_mm256_maskstore_epi32( (int*)ptr, m.bits(), data );
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	_mm256_maskstore_epi64( (long long*)ptr, m.bits(), data );
+      }
+      else {
+	alignas(32) value_type buffer[ extent ];
+	_mm256_store_si256( (__m256i*)buffer, data );
+	for( size_type i = 0; i < extent; ++i ){
+	  if( m[i] ) ptr[i] = buffer[i];
+	}
+      }
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order
+     *
+     * The indices are signed lanes of the width of value_type.  AVX2
+     * gathers lanes of 32 and 64 bits; narrower lanes are read one at
+     * a time.
+     */
+    static m256i
+    gather( value_type const* base, m256i<index_type> const& index ){
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_i32gather_epi32( (int const*)base, index.bits(), scale ));
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm256_i64gather_epi64( (long long const*)base, index.bits(), scale ));
+      }
+      else {
+	alignas(32) index_type offsets[ extent ];
+	alignas(32) value_type lanes[ extent ];
+	index.store( offsets );
+	for( size_type i = 0; i < extent; ++i ){
+	  lanes[i] = base[ offsets[i] ];
+	}
+	return m256i( lanes );
+      }
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m256i
+    gather( value_type const* base, m256i<index_type> const& index, mask_type const& m ){
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_mask_i32gather_epi32( _mm256_setzero_si256(), (int const*)base, index.bits(), m.bits(), scale ));
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm256_mask_i64gather_epi64( _mm256_setzero_si256(), (long long const*)base, index.bits(), m.bits(), scale ));
+      }
+      else {
+	alignas(32) index_type offsets[ extent ];
+	alignas(32) value_type lanes[ extent ] = {};
+	index.store( offsets );
+	for( size_type i = 0; i < extent; ++i ){
+	  if( m[i] ) lanes[i] = base[ offsets[i] ];
+	}
+	return m256i( lanes );
+      }
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.  AVX2
+     * has no scatter, so the lanes are stored one at a time unless
+     * AVX512VL provides the instruction.
+     */
+    void
+    scatter( value_type* base, m256i<index_type> const& index ) const {
+#if defined(__AVX512VL__)
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	_mm256_i32scatter_epi32( base, index.bits(), data, scale );
+	return;
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	_mm256_i64scatter_epi64( base, index.bits(), data, scale );
+	return;
+      }
+#endif
+      alignas(32) index_type offsets[ extent ];
+      alignas(32) value_type lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	base[ offsets[i] ] = lanes[i];
+      }
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( value_type* base, m256i<index_type> const& index, mask_type const& m ) const {
+#if defined(__AVX512VL__)
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	__mmask8 k = __mmask8( _mm256_movemask_ps( _mm256_castsi256_ps( m.bits())));
+	_mm256_mask_i32scatter_epi32( base, k, index.bits(), data, scale );
+	return;
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	__mmask8 k = __mmask8( _mm256_movemask_pd( _mm256_castsi256_pd( m.bits())));
+	_mm256_mask_i64scatter_epi64( base, k, index.bits(), data, scale );
+	return;
+      }
+#endif
+      alignas(32) index_type offsets[ extent ];
+      alignas(32) value_type lanes[ extent ];
+      index.store( offsets );
+      store( lanes );
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) base[ offsets[i] ] = lanes[i];
+      }
+    }
+
+    /** The lanes as an intrinsic register */
+    __m256i
+    bits() const { return data; }
+
+    //
+    // assignment
+    //
+    m256i&
+    operator =( m256i const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    m256i&
+    operator =( value_type const* ptr ){
+      data = _mm256_load_si256( (__m256i const*)ptr );
+      return *this;
+    }
+
+    m256i&
+    operator =( unaligned<value_type> const& u ){
+      data = _mm256_loadu_si256( (__m256i const*)u.ptr );
+      return *this;
+    }
+
+    m256i&
+    operator =( stream<value_type> const& s ){
+      data = _mm256_stream_load_si256( (__m256i const*)s.ptr );
+      return *this;
+    }
+
+    //
+    // compound assignment
+    //
+    m256i&
+    operator +=( m256i const& b ){
+      return *this = *this + b;
+    }
+
+    m256i&
+    operator -=( m256i const& b ){
+      return *this = *this - b;
+    }
+
+    m256i&
+    operator *=( m256i const& b ){
+      return *this = *this * b;
+    }
+
+    m256i&
+    operator &=( m256i const& b ){
+      return *this = *this & b;
+    }
+
+    m256i&
+    operator |=( m256i const& b ){
+      return *this = *this | b;
+    }
+
+    m256i&
+    operator ^=( m256i const& b ){
+      return *this = *this ^ b;
+    }
+
+    m256i&
+    operator <<=( int n ){
+      return *this = *this << n;
+    }
+
+    m256i&
+    operator >>=( int n ){
+      return *this = *this >> n;
+    }
+
+    //
+    // unary operators
+    //
+    friend m256i
+    neg( m256i const& a ){
+      return m256i( value_type(0) ) - a;
+    }
+
+    friend m256i
+    abs( m256i const& a ){
+      if constexpr ( std::is_unsigned_v<value_type> ){
+	return a;
+      }
+      else if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm256_abs_epi8( a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm256_abs_epi16( a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_abs_epi32( a.data ));
+      }
+      else {
+	return make( _mm256_blendv_epi8( a.data, neg( a ).data,
+					 _mm256_cmpgt_epi64( _mm256_setzero_si256(), a.data )));
+      }
+    }
+
+    friend m256i
+    operator ~( m256i const& a ){
+      return make( _mm256_xor_si256( a.data, _mm256_set1_epi32( -1 )));
+    }
+
+    //
+    // binary arithmetic
+    //
+    friend m256i
+    operator +( m256i const& a, m256i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm256_add_epi8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm256_add_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_add_epi32( a.data, b.data ));
+      }
+      else {
+	return make( _mm256_add_epi64( a.data, b.data ));
+      }
+    }
+
+    friend m256i
+    operator -( m256i const& a, m256i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm256_sub_epi8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm256_sub_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_sub_epi32( a.data, b.data ));
+      }
+      else {
+	return make( _mm256_sub_epi64( a.data, b.data ));
+      }
+    }
+
+    /** The low half of the product of each lane */
+    friend m256i
+    operator *( m256i const& a, m256i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	__m256i even = _mm256_mullo_epi16( a.data, b.data );
+	__m256i odd = _mm256_mullo_epi16( _mm256_srli_epi16( a.data, 8 ), _mm256_srli_epi16( b.data, 8 ));
+	return make( _mm256_or_si256( _mm256_slli_epi16( odd, 8 ),
+				      _mm256_and_si256( even, _mm256_set1_epi16( 0x00FF ))));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm256_mullo_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_mullo_epi32( a.data, b.data ));
+      }
+      else {
+#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+	return make( _mm256_mullo_epi64( a.data, b.data ));
+#else
+	__m256i low = _mm256_mul_epu32( a.data, b.data );
+	__m256i cross = _mm256_add_epi64( _mm256_mul_epu32( _mm256_srli_epi64( a.data, 32 ), b.data ),
+					  _mm256_mul_epu32( a.data, _mm256_srli_epi64( b.data, 32 )));
+	return make( _mm256_add_epi64( low, _mm256_slli_epi64( cross, 32 )));
+#endif
+      }
+    }
+
+    friend m256i
+    min( m256i const& a, m256i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_min_epi8( a.data, b.data )
+		     : _mm256_min_epu8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_min_epi16( a.data, b.data )
+		     : _mm256_min_epu16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_min_epi32( a.data, b.data )
+		     : _mm256_min_epu32( a.data, b.data ));
+      }
+      else {
+	return make( _mm256_blendv_epi8( a.data, b.data, greater( a.data, b.data )));
+      }
+    }
+
+    friend m256i
+    max( m256i const& a, m256i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_max_epi8( a.data, b.data )
+		     : _mm256_max_epu8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_max_epi16( a.data, b.data )
+		     : _mm256_max_epu16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_max_epi32( a.data, b.data )
+		     : _mm256_max_epu32( a.data, b.data ));
+      }
+      else {
+	return make( _mm256_blendv_epi8( b.data, a.data, greater( a.data, b.data )));
+      }
+    }
+
+    //
+    // bitwise operators
+    //
+    friend m256i
+    operator &( m256i const& a, m256i const& b ){
+      return make( _mm256_and_si256( a.data, b.data ));
+    }
+
+    friend m256i
+    operator |( m256i const& a, m256i const& b ){
+      return make( _mm256_or_si256( a.data, b.data ));
+    }
+
+    friend m256i
+    operator ^( m256i const& a, m256i const& b ){
+      return make( _mm256_xor_si256( a.data, b.data ));
+    }
+
+    /** The bits of b that are not set in a */
+    friend m256i
+    andnot( m256i const& a, m256i const& b ){
+      return make( _mm256_andnot_si256( a.data, b.data ));
+    }
+
+    //
+    // shifts
+    //
+    friend m256i
+    operator <<( m256i const& a, int n ){
+      __m128i count = _mm_cvtsi32_si128( n );
+      if constexpr ( sizeof(value_type) == 1 ){
+	unsigned k = unsigned( n ) < 8u ? unsigned( n ) : 8u;
+	return make( _mm256_and_si256( _mm256_sll_epi16( a.data, count ),
+				       _mm256_set1_epi8( char( 0xFFu << k ))));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm256_sll_epi16( a.data, count ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_sll_epi32( a.data, count ));
+      }
+      else {
+	return make( _mm256_sll_epi64( a.data, count ));
+      }
+    }
+
+    /** Shift right, arithmetic for signed lanes and logical for unsigned lanes
+     *
+     * As with the shift instructions, n is read as unsigned, and counts
+     * of the lane width or more leave zeros in unsigned lanes and copies
+     * of the sign bit in signed lanes.
+     */
+    friend m256i
+    operator >>( m256i const& a, int n ){
+      __m128i count = _mm_cvtsi32_si128( n );
+      if constexpr ( sizeof(value_type) == 1 ){
+	// a signed shift by 7 already leaves only copies of the sign bit
+	unsigned limit = std::is_signed_v<value_type> ? 7u : 8u;
+	unsigned k = unsigned( n ) < limit ? unsigned( n ) : limit;
+	__m256i shifted = _mm256_and_si256( _mm256_srl_epi16( a.data, _mm_cvtsi32_si128( int( k ))),
+					    _mm256_set1_epi8( char( 0xFFu >> k )));
+	if constexpr ( std::is_signed_v<value_type> ){
+	  __m256i sign = _mm256_set1_epi8( char( 0x80u >> k ));
+	  shifted = _mm256_sub_epi8( _mm256_xor_si256( shifted, sign ), sign );
+	}
+	return make( shifted );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_sra_epi16( a.data, count )
+		     : _mm256_srl_epi16( a.data, count ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm256_sra_epi32( a.data, count )
+		     : _mm256_srl_epi32( a.data, count ));
+      }
+      else {
+	unsigned limit = std::is_signed_v<value_type> ? 63u : 64u;
+	unsigned k = unsigned( n ) < limit ? unsigned( n ) : limit;
+	__m256i shifted = _mm256_srl_epi64( a.data, _mm_cvtsi32_si128( int( k )));
+	if constexpr ( std::is_signed_v<value_type> ){
+	  __m256i sign = _mm256_set1_epi64x( (long long)( 0x8000000000000000ull >> k ));
+	  shifted = _mm256_sub_epi64( _mm256_xor_si256( shifted, sign ), sign );
+	}
+	return make( shifted );
+      }
+    }
+
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m256i
+    add( mask_type const& m, m256i const& a, m256i const& b ){
+      return cond( m, a + b, a );
+    }
+
+    friend m256i
+    subtract( mask_type const& m, m256i const& a, m256i const& b ){
+      return cond( m, a - b, a );
+    }
+
+    friend m256i
+    multiply( mask_type const& m, m256i const& a, m256i const& b ){
+      return cond( m, a*b, a );
+    }
+
+    //
+    // binary comparison
+    //
+    friend mask_type
+    operator ==( m256i const& a, m256i const& b ){
+      return mask_type( equal( a.data, b.data ));
+    }
+
+    friend mask_type
+    operator !=( m256i const& a, m256i const& b ){
+      return ~mask_type( equal( a.data, b.data ));
+    }
+
+    friend mask_type
+    operator <( m256i const& a, m256i const& b ){
+      return mask_type( greater( b.data, a.data ));
+    }
+
+    friend mask_type
+    operator <=( m256i const& a, m256i const& b ){
+      return ~mask_type( greater( a.data, b.data ));
+    }
+
+    friend mask_type
+    operator >( m256i const& a, m256i const& b ){
+      return mask_type( greater( a.data, b.data ));
+    }
+
+    friend mask_type
+    operator >=( m256i const& a, m256i const& b ){
+      return ~mask_type( greater( b.data, a.data ));
+    }
+
+    //
+    // conditional
+    //
+    friend m256i
+    cond( mask_type const& test, m256i const& pass, m256i const& fail ){
+      return make( _mm256_blendv_epi8( fail.data, pass.data, test.bits() ));
+    }
+
+    //
+    // horizontal reductions, wrapping around like the lane arithmetic
+    //
+    friend value_type
+    hsum( m256i const& a ){
+      return reduce( a, []( m256i const& x, m256i const& y ){ return x + y; });
+    }
+
+    friend value_type
+    hprod( m256i const& a ){
+      return reduce( a, []( m256i const& x, m256i const& y ){ return x*y; });
+    }
+
+    friend value_type
+    hmin( m256i const& a ){
+      return reduce( a, []( m256i const& x, m256i const& y ){ return min( x, y ); });
+    }
+
+    friend value_type
+    hmax( m256i const& a ){
+      return reduce( a, []( m256i const& x, m256i const& y ){ return max( x, y ); });
+    }
+
+    friend value_type
+    dot( m256i const& a, m256i const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m256i const& a ){
+      return find_first( a == m256i( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m256i const& a ){
+      return find_first( a == m256i( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+
+    /** AVX2 only moves bytes within halves of the register, so lanes
+     *  narrower than 32 bits are moved across halves by shuffling a
+     *  copy with its halves swapped. */
+    template< size_type ... I >
+    static m256i
+    shuffle( m256i const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      constexpr size_type half = extent/2;
+      if constexpr ( sizeof(value_type) == 8 ){
+	constexpr int immediate = Lanes::immediate4( index );
+	return make( _mm256_permute4x64_epi64( a.data, immediate ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 && Lanes::repeats_in_blocks( index, 4 )){
+	constexpr int immediate = Lanes::immediate4( index );
+	return make( _mm256_shuffle_epi32( a.data, immediate ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm256_permutevar8x32_epi32( a.data, _mm256_setr_epi32( int( I ) ... )));
+      }
+      else {
+	__m256i control = constant( Lanes::byte_control<32>( index, sizeof(value_type) ));
+	__m256i within = _mm256_shuffle_epi8( a.data, control );
+	if constexpr ( Lanes::within_blocks( index, half )){
+	  return make( within );
+	}
+	else {
+	  __m256i swapped = _mm256_permute2x128_si256( a.data, a.data, 1 );
+	  __m256i across = _mm256_shuffle_epi8( swapped, control );
+	  __m256i crossing = constant( Lanes::expand<value_type,extent>( Lanes::crossing( index, half )));
+	  return make( _mm256_blendv_epi8( within, across, crossing ));
+	}
+      }
+    }
+
+    template< size_type ... I >
+    static m256i
+    shuffle( m256i const& a, m256i const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      if constexpr ( Lanes::all_below( index, extent )){
+	return shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	return shuffle<( I - extent ) ...>( b );
+      }
+      else {
+	__m256i beyond = constant( Lanes::expand<value_type,extent>( Lanes::beyond( index, extent )));
+	return make( _mm256_blendv_epi8( shuffle<( I%extent ) ...>( a ).data,
+					 shuffle<( I%extent ) ...>( b ).data, beyond ));
+      }
+    }
+
+  private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines every lane with the lane half the remaining
+     * distance above it, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static value_type
+    reduce( m256i a, Op op ){
+      a = op( a, make( _mm256_permute2x128_si256( a.data, a.data, 1 )));
+      a = op( a, make( _mm256_shuffle_epi32( a.data, _MM_SHUFFLE( 1, 0, 3, 2 ))));
+      if constexpr ( sizeof(value_type) <= 4 ){
+	a = op( a, make( _mm256_shuffle_epi32( a.data, _MM_SHUFFLE( 2, 3, 0, 1 ))));
+      }
+      if constexpr ( sizeof(value_type) <= 2 ){
+	a = op( a, make( _mm256_srli_epi32( a.data, 16 )));
+      }
+      if constexpr ( sizeof(value_type) == 1 ){
+	a = op( a, make( _mm256_srli_epi16( a.data, 8 )));
+      }
+      return value_type( _mm_cvtsi128_si64( _mm256_castsi256_si128( a.data )));
+    }
+
+    static m256i
+    make( __m256i input ){
+      m256i result;
+      result.data = input;
+      return result;
+    }
+
+    /** A register holding the 32 bytes of a compile time table */
+    template< typename U, std::size_t N >
+    static __m256i
+    constant( array<U,N> const& table ){
+      static_assert( sizeof(U)*N == 32, "a table of 32 bytes" );
+      return _mm256_loadu_si256( (__m256i const*)table.data());
+    }
+
+    static __m256i
+    set1( value_type x ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return _mm256_set1_epi8( char(x) );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return _mm256_set1_epi16( short(x) );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return _mm256_set1_epi32( int(x) );
+      }
+      else {
+	return _mm256_set1_epi64x( (long long)(x) );
+      }
+    }
+
+    /** Lanes of all ones where a equals b */
+    static __m256i
+    equal( __m256i a, __m256i b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return _mm256_cmpeq_epi8( a, b );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return _mm256_cmpeq_epi16( a, b );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return _mm256_cmpeq_epi32( a, b );
+      }
+      else {
+	return _mm256_cmpeq_epi64( a, b );
+      }
+    }
+
+    /** Lanes of all ones where a is greater than b
+     *
+     * AVX2 only compares signed lanes, so unsigned lanes are compared
+     * after flipping their sign bits.
+     */
+    static __m256i
+    greater( __m256i a, __m256i b ){
+      if constexpr ( std::is_unsigned_v<value_type> ){
+	__m256i bias = set1( value_type( value_type(1) << (8*sizeof(value_type) - 1)));
+	a = _mm256_xor_si256( a, bias );
+	b = _mm256_xor_si256( b, bias );
+      }
+      if constexpr ( sizeof(value_type) == 1 ){
+	return _mm256_cmpgt_epi8( a, b );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return _mm256_cmpgt_epi16( a, b );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return _mm256_cmpgt_epi32( a, b );
+      }
+      else {
+	return _mm256_cmpgt_epi64( a, b );
+      }
+    }
+
+    __m256i data;
+  }; // end of class m256i
+
+} // end of namespace AVX
+
+namespace ShortVector::Private
+{
+  template< typename T >
+  struct Register<T,avx_tag,std::enable_if_t<std::is_integral_v<T> && ! std::is_same_v<T,bool>>>
+  {
+    using type = AVX::m256i<T>;
+  };
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined M256I_HPP_INCLUDED_2039817420776136958
@@ -1,16 +1,41 @@
-#ifndef UTILITY_HPP_INCLUDED_622411775145667441
-#define UTILITY_HPP_INCLUDED_622411775145667441 1
+#ifndef AVX_UTILITY_HPP_INCLUDED_1461532938270193417
+#define AVX_UTILITY_HPP_INCLUDED_1461532938270193417 1
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/utility.hpp>
 
 namespace AVX
 {
 
-  template< typename T >
-  struct unaligned{ T* ptr; };
+  using ShortVector::size_type;
+
+  using ShortVector::Private::unaligned;
+  using ShortVector::Private::stream;
 
-  template< typename T >
-  struct stream { T* ptr; };
+  using ShortVector::array;
+
+  namespace Lanes = ShortVector::Private::Lanes;
     
   
+  /** All ones in the first n bytes of a register and zero elsewhere
+   *
+   * The masks of the first lanes of every lane width are made from it.
+   */
+  inline __m256i
+  leading_bytes( size_type n ){
+    n = n < 0 ? 0 : n < 32 ? n : 32;
+    __m256i index = _mm256_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+				     16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 );
+    return _mm256_cmpgt_epi8( _mm256_set1_epi8( char( n )), index );
+  }
+
 } // end of namespace AVX
 
-#endif // ! defined UTILITY_HPP_INCLUDED_622411775145667441
+#endif // ! defined AVX_UTILITY_HPP_INCLUDED_1461532938270193417
@@ -0,0 +1,22 @@
+#ifndef AVX512_COMPLEX_HPP_INCLUDED_3069925718846420761
+#define AVX512_COMPLEX_HPP_INCLUDED_3069925718846420761 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/complex.hpp>
+#include <short_vector/avx512/m512.hpp>
+#include <short_vector/avx512/m512d.hpp>
+
+namespace AVX512
+{
+
+  /** Eight complex floats, interleaved */
+  using complex_m512 = ShortVector::Private::Interleaved_complex<m512>;
+
+  /** Four complex doubles, interleaved */
+  using complex_m512d = ShortVector::Private::Interleaved_complex<m512d>;
+
+} // end of namespace AVX512
+
+#endif // ! defined AVX512_COMPLEX_HPP_INCLUDED_3069925718846420761
@@ -0,0 +1,93 @@
+#ifndef AVX512_CONVERT_HPP_INCLUDED_2291847736620519043
+#define AVX512_CONVERT_HPP_INCLUDED_2291847736620519043 1
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/half.hpp>
+#include <short_vector/avx512/m512.hpp>
+#include <short_vector/avx512/m512d.hpp>
+
+/** Conversions between the lane types of the AVX-512 registers
+ *
+ * As for AVX, with sixteen halves or bfloat16 values at a time.
+ */
+namespace AVX512
+{
+
+  using ShortVector::Private::half;
+  using ShortVector::Private::bfloat16;
+
+  inline array<m512d,2>
+  widen( m512 const& a ){
+    __m256 hi = _mm256_castpd_ps( _mm512_extractf64x4_pd( _mm512_castps_pd( a.bits()), 1 ));
+    return {{ m512d( _mm512_cvtps_pd( _mm512_castps512_ps256( a.bits()))),
+	      m512d( _mm512_cvtps_pd( hi )) }};
+  }
+
+  inline m512
+  narrow( m512d const& lo, m512d const& hi ){
+    __m512d x = _mm512_castps_pd( _mm512_castps256_ps512( _mm512_cvtpd_ps( lo.bits())));
+    return m512( _mm512_castpd_ps( _mm512_insertf64x4( x, _mm256_castps_pd( _mm512_cvtpd_ps( hi.bits())), 1 )));
+  }
+
+  inline m512
+  widen( half const* ptr ){
+    return m512( _mm512_cvtph_ps( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( ptr ))));
+  }
+
+  inline void
+  narrow( m512 const& a, half* ptr ){
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( ptr ),
+			 _mm512_cvtps_ph( a.bits(), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ));
+  }
+
+  inline m512
+  widen( bfloat16 const* ptr ){
+    __m512i x = _mm512_cvtepu16_epi32( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( ptr )));
+    return m512( _mm512_castsi512_ps( _mm512_slli_epi32( x, 16 )));
+  }
+
+  /** Store the upper halves of the lanes, rounded to nearest even,
+   *  with NaNs kept quiet */
+  inline void
+  narrow( m512 const& a, bfloat16* ptr ){
+    __m512i x = _mm512_castps_si512( a.bits());
+    __m512i odd = _mm512_and_si512( _mm512_srli_epi32( x, 16 ), _mm512_set1_epi32( 1 ));
+    __m512i rounded = _mm512_add_epi32( x, _mm512_add_epi32( _mm512_set1_epi32( 0x7fff ), odd ));
+    __m512i quiet = _mm512_or_si512( x, _mm512_set1_epi32( 0x400000 ));
+    __mmask16 nan = _mm512_cmp_ps_mask( a.bits(), a.bits(), _CMP_UNORD_Q );
+    __m512i y = _mm512_srli_epi32( _mm512_mask_blend_epi32( nan, rounded, quiet ), 16 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( ptr ), _mm512_cvtepi32_epi16( y ));
+  }
+
+} // end of namespace AVX512
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Conversions<avx512_tag>
+  {
+    static array<AVX512::m512d,2>
+    widen( AVX512::m512 const& a ){ return AVX512::widen( a ); }
+
+    static AVX512::m512
+    narrow( AVX512::m512d const& lo, AVX512::m512d const& hi ){ return AVX512::narrow( lo, hi ); }
+
+    template< typename H >
+    static AVX512::m512
+    widen( H const* ptr ){ return AVX512::widen( ptr ); }
+
+    template< typename H >
+    static void
+    narrow( AVX512::m512 const& a, H* ptr ){ AVX512::narrow( a, ptr ); }
+  };
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined AVX512_CONVERT_HPP_INCLUDED_2291847736620519043
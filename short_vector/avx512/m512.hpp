@@ -10,31 +10,26 @@
 //
 // ... Short Vector header files
 //
-#include <short_vector/utility.hpp>
+#include <short_vector/avx512/mask.hpp>
+#include <short_vector/avx512/m512i.hpp>
 
 
 
 namespace AVX512
 {
 
-  using ShortVector::Private::unaligned;
-  using ShortVector::Private::stream;
-
-
-
   class m512
   {
   public:
 
-    enum{
-      NEAREST_EVEN_INTEGER = 0,
-      EQUAL_OR_SMALLER_INTEGER = 1,
-      EQUAL_OR_LARGER_INTEGER =2,
-      NEAREST_SMALLEST_MAGNITUDE_INTEGER=3
-    };
+    using value_type = float;
+
+    static constexpr size_type extent = 16;
+
+    /** The bits of precision of the estimates rsqrt and rcp */
+    static constexpr size_type estimate_precision = 14;
 
-    static m512 const zero;
-    static m512 const one;
+    using mask_type = mask<16>;
     
     //
     // constructors
@@ -45,6 +40,11 @@ namespace AVX512
       data = input.data;
     }
 
+    explicit
+    m512( __m512 input ){
+      data = input;
+    }
+
     m512( float input ){
       data = _mm512_set1_ps( input );
     }
@@ -57,28 +57,86 @@ namespace AVX512
       data = _mm512_loadu_ps(u.ptr);
     }
 
-    m512( stream<float> const& u ){
-      data = _mm512_casti512_ps( _mm512_stream_load_si512((void const*)(u.ptr)));
+    m512( stream<float> const& s ){
+      data = _mm512_castsi512_ps( _mm512_stream_load_si512((void*)(s.ptr)));
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m512( float const* ptr, mask_type const& m ){
+      data = _mm512_maskz_loadu_ps( m.bits(), ptr );
     }
 
     //
     // store
     //
     void
-    store( float* ptr ){
+    store( float* ptr ) const {
       _mm512_store_ps( ptr, data );
     }
 
     void
-    store(unaligned<float>& u){
+    store( unaligned<float> const& u ) const {
       _mm512_storeu_ps( u.ptr, data );
     }
 
     void
-    store(stream<float>& s){
+    store( stream<float> const& s ) const {
       _mm512_stream_ps( s.ptr, data );
     }
 
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( float* ptr, mask_type const& m ) const {
+      _mm512_mask_storeu_ps( ptr, m.bits(), data );
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order */
+    static m512
+    gather( float const* base, m512i<std::int32_t> const& index ){
+      m512 result;
+      result.data = _mm512_i32gather_ps( index.bits(), base, 4 );
+      return result;
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m512
+    gather( float const* base, m512i<std::int32_t> const& index, mask_type const& m ){
+      m512 result;
+      result.data = _mm512_mask_i32gather_ps( _mm512_setzero_ps(), m.bits(), index.bits(), base, 4 );
+      return result;
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.
+     */
+    void
+    scatter( float* base, m512i<std::int32_t> const& index ) const {
+      _mm512_i32scatter_ps( base, index.bits(), data, 4 );
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( float* base, m512i<std::int32_t> const& index, mask_type const& m ) const {
+      _mm512_mask_i32scatter_ps( base, m.bits(), index.bits(), data, 4 );
+    }
+
 
     //
     // assignment
@@ -98,7 +156,7 @@ namespace AVX512
 
     m512&
     operator =(float const* ptr){
-      data = _mm512_load_ps(input);
+      data = _mm512_load_ps(ptr);
       return *this;
     }
 
@@ -110,7 +168,7 @@ namespace AVX512
 
     m512&
     operator =(stream<float> const& s){
-      data = _mm512_casti512_ps( _mm512_stream_load_si512((void const*)(u.ptr)));
+      data = _mm512_castsi512_ps( _mm512_stream_load_si512((void*)(s.ptr)));
       return *this;
     }
 
@@ -147,34 +205,86 @@ namespace AVX512
 
     friend m512
     neg(m512 const& a){
-      return -1.0*a;
+      return -1.0f*a;
     }
 
     friend m512
     abs(m512 const& a){
       m512 result;
-      result.data = _mm512_abs_ps( a.data());
+      result.data = _mm512_abs_ps( a.data );
+      return result;
     }
 
     friend m512
     ceil( m512 const& a ){
       m512 result;
-      result.data = _mm512_roundscale_ps( a.data(), EQUAL_OR_LARGER_INTEGER);
+      result.data = _mm512_roundscale_ps( a.data, EQUAL_OR_LARGER_INTEGER);
       return result;
     }
 
     friend m512
     floor( m512 const& a ){
       m512 result;
-      result.data = _mm512_roundscale_ps( a.data(), EQUAL_OR_SMALLER_INTEGER);
+      result.data = _mm512_roundscale_ps( a.data, EQUAL_OR_SMALLER_INTEGER);
       return result;
     }
 
+    friend m512
+    round( m512 const& a ){
+      m512 result;
+      result.data = _mm512_roundscale_ps( a.data, NEAREST_EVEN_INTEGER);
+      return result;
+    }
 
     friend m512
     trunc( m512 const& a ){
       m512 result;
-      result.data = _mm512_roundscale_ps( a.data(), NEAREST_SMALLEST_MAGNITUDE_INTEGER);
+      result.data = _mm512_roundscale_ps( a.data, NEAREST_SMALLEST_MAGNITUDE_INTEGER);
+      return result;
+    }
+
+    friend m512
+    sqrt( m512 const& a ){
+      m512 result;
+      result.data = _mm512_sqrt_ps( a.data );
+      return result;
+    }
+
+    friend m512
+    rsqrt( m512 const& a ){
+      m512 result;
+      result.data = _mm512_rsqrt14_ps( a.data );
+      return result;
+    }
+
+    friend m512
+    rcp( m512 const& a ){
+      m512 result;
+      result.data = _mm512_rcp14_ps( a.data );
+      return result;
+    }
+
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for finite nonzero a, subnormal values included.
+     */
+    friend m512
+    frexp( m512 const& a, m512& e ){
+      e.data = _mm512_add_ps( _mm512_getexp_ps( a.data ), _mm512_set1_ps( 1 ));
+      m512 result;
+      result.data = _mm512_getmant_ps( a.data, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src );
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e */
+    friend m512
+    ldexp( m512 const& a, m512 const& e ){
+      m512 result;
+      result.data = _mm512_scalef_ps( a.data, e.data );
       return result;
     }
     
@@ -210,112 +320,244 @@ namespace AVX512
       return result;
     }
 
+    friend m512
+    min( m512 const& a, m512 const& b ){
+      m512 result;
+      result.data = _mm512_min_ps( a.data, b.data );
+      return result;
+    }
+
+    friend m512
+    max( m512 const& a, m512 const& b ){
+      m512 result;
+      result.data = _mm512_max_ps( a.data, b.data );
+      return result;
+    }
+
     //
     // trinary arithmetic
     //
     friend m512
-    operator fmadd(m512 const& a, m512 const& b, m512 const& c){
+    fma(m512 const& a, m512 const& b, m512 const& c){
       m512 result;
       result.data = _mm512_fmadd_ps(a.data, b.data, c.data);
       return result;
     }
 
     friend m512
-    operator fmsub(m512 const& a, m512 const& b, m512 const& c){
+    fms(m512 const& a, m512 const& b, m512 const& c){
       m512 result;
       result.data = _mm512_fmsub_ps(a.data, b.data, c.data);
       return result;
     }
 
     friend m512
-    operator fnmadd(m512 const& a, m512 const& b, m512 const& c){
+    fnma(m512 const& a, m512 const& b, m512 const& c){
       m512 result;
       result.data = _mm512_fnmadd_ps(a.data, b.data, c.data);
       return result;
     }
 
     friend m512
-    operator fnmsub(m512 const& a, m512 const& b, m512 const& c){
+    fnms(m512 const& a, m512 const& b, m512 const& c){
       m512 result;
       result.data = _mm512_fnmsub_ps(a.data, b.data, c.data);
       return result;
     }
 
-    //
-    // binary comparison
-    //
-    
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
     friend m512
-    operator ==(m512 const& a, m512 const& b){
+    fmaddsub(m512 const& a, m512 const& b, m512 const& c){
       m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_EQ_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
+      result.data = _mm512_fmaddsub_ps(a.data, b.data, c.data);
       return result;
     }
 
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
     friend m512
-    operator !=(m512 const& a, m512 const& b){
+    add( mask_type const& m, m512 const& a, m512 const& b ){
       m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_NEQ_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
+      result.data = _mm512_mask_add_ps( a.data, m.bits(), a.data, b.data );
       return result;
     }
 
     friend m512
-    operator <(m512 const& a, m512 const& b){
+    subtract( mask_type const& m, m512 const& a, m512 const& b ){
       m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_LT_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
+      result.data = _mm512_mask_sub_ps( a.data, m.bits(), a.data, b.data );
       return result;
     }
 
     friend m512
-    operator <=(m512 const& a, m512 const& b){
+    multiply( mask_type const& m, m512 const& a, m512 const& b ){
       m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_LE_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
+      result.data = _mm512_mask_mul_ps( a.data, m.bits(), a.data, b.data );
       return result;
     }
 
     friend m512
-    operator >(m512 const& a, m512 const& b){
+    divide( mask_type const& m, m512 const& a, m512 const& b ){
       m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_GT_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
+      result.data = _mm512_mask_div_ps( a.data, m.bits(), a.data, b.data );
       return result;
     }
 
-    friend m512
+    //
+    // binary comparison
+    //
+    friend mask_type
+    operator ==(m512 const& a, m512 const& b){
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_EQ_OS ));
+    }
+
+    friend mask_type
+    operator !=(m512 const& a, m512 const& b){
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_NEQ_UQ ));
+    }
+
+    friend mask_type
+    operator <(m512 const& a, m512 const& b){
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_LT_OS ));
+    }
+
+    friend mask_type
+    operator <=(m512 const& a, m512 const& b){
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_LE_OS ));
+    }
+
+    friend mask_type
+    operator >(m512 const& a, m512 const& b){
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_GT_OS ));
+    }
+
+    friend mask_type
     operator >=(m512 const& a, m512 const& b){
-      m512 result;
-      __mmask16 mask;
-      mask = _mm512_cmp_ps_mash( a.data(), b.data(), _CMP_GE_OS);
-      result.data = _mm512_mask_blend_ps(mask, one.data, zero.data);
-      return result;
+      return mask_type( _mm512_cmp_ps_mask( a.data, b.data, _CMP_GE_OS ));
     }
 
     //
     // conditional
     //
-
     friend m512
-    cond( m512 const& test, m512 const& pass, m512 const& fail ){
-      return test*pass + (one-test)*fail;
+    cond( mask_type const& test, m512 const& pass, m512 const& fail ){
+      m512 result;
+      result.data = _mm512_mask_blend_ps( test.bits(), fail.data, pass.data );
+      return result;
     }
     
+    //
+    // horizontal reductions
+    //
+    friend float
+    hsum( m512 const& a ){
+      return _mm512_reduce_add_ps( a.data );
+    }
+
+    friend float
+    hprod( m512 const& a ){
+      return _mm512_reduce_mul_ps( a.data );
+    }
+
+    friend float
+    hmin( m512 const& a ){
+      return _mm512_reduce_min_ps( a.data );
+    }
+
+    friend float
+    hmax( m512 const& a ){
+      return _mm512_reduce_max_ps( a.data );
+    }
+
+    friend float
+    dot( m512 const& a, m512 const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m512 const& a ){
+      return find_first( a == m512( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m512 const& a ){
+      return find_first( a == m512( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type ... I >
+    static m512
+    shuffle( m512 const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m512 result;
+      if constexpr ( Lanes::repeats_in_blocks( index, 4 )){
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm512_permute_ps( a.data, immediate );
+      }
+      else {
+	constexpr array<int,extent> lanes{{ int( I ) ... }};
+	result.data = _mm512_permutexvar_ps( _mm512_loadu_si512( lanes.data()), a.data );
+      }
+      return result;
+    }
+
+    template< size_type ... I >
+    static m512
+    shuffle( m512 const& a, m512 const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m512 result;
+      if constexpr ( Lanes::all_below( index, extent )){
+	result = shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	result = shuffle<( I - extent ) ...>( b );
+      }
+      else if constexpr ( Lanes::pairs_in_blocks( index, 4, extent )){
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm512_shuffle_ps( a.data, b.data, immediate );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, extent, false )){
+	result.data = _mm512_unpacklo_ps( a.data, b.data );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, extent, true )){
+	result.data = _mm512_unpackhi_ps( a.data, b.data );
+      }
+      else {
+	constexpr array<int,extent> lanes{{ int( I ) ... }};
+	result.data = _mm512_permutex2var_ps( a.data, _mm512_loadu_si512( lanes.data()), b.data );
+      }
+      return result;
+    }
+
+    /** The raw register */
+    __m512
+    bits() const { return data; }
+
   private:
     __m512 data;
   }; // end of class m512
-  
-  m512 const m512::zero(0.0f);
-  m512 const m512::one(1.0f);
 
   
 } // end of namespace AVX512
 
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<float,avx512_tag>
+  {
+    using type = AVX512::m512;
+  };
+  
+} // end of namespace ShortVector::Private
+
 #endif // ! defined M512_HPP_INCLUDED_97185451340719794
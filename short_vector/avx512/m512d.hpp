@@ -0,0 +1,557 @@
+#ifndef M512D_HPP_INCLUDED_1769424350919374416
+#define M512D_HPP_INCLUDED_1769424350919374416 1
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/avx512/mask.hpp>
+#include <short_vector/avx512/m512i.hpp>
+
+
+
+namespace AVX512
+{
+
+  class m512d
+  {
+  public:
+
+    using value_type = double;
+
+    static constexpr size_type extent = 8;
+
+    /** The bits of precision of the estimates rsqrt and rcp */
+    static constexpr size_type estimate_precision = 14;
+
+    using mask_type = mask<8>;
+    
+    //
+    // constructors
+    //
+    m512d(){}
+
+    m512d( m512d const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m512d( __m512d input ){
+      data = input;
+    }
+
+    m512d( double input ){
+      data = _mm512_set1_pd( input );
+    }
+
+    m512d( double const* input ){
+      data = _mm512_load_pd( input );
+    }
+
+    m512d( unaligned<double> const& u ){
+      data = _mm512_loadu_pd(u.ptr);
+    }
+
+    m512d( stream<double> const& s ){
+      data = _mm512_castsi512_pd( _mm512_stream_load_si512((void*)(s.ptr)));
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m512d( double const* ptr, mask_type const& m ){
+      data = _mm512_maskz_loadu_pd( m.bits(), ptr );
+    }
+
+    //
+    // store
+    //
+    void
+    store( double* ptr ) const {
+      _mm512_store_pd( ptr, data );
+    }
+
+    void
+    store( unaligned<double> const& u ) const {
+      _mm512_storeu_pd( u.ptr, data );
+    }
+
+    void
+    store( stream<double> const& s ) const {
+      _mm512_stream_pd( s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( double* ptr, mask_type const& m ) const {
+      _mm512_mask_storeu_pd( ptr, m.bits(), data );
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order */
+    static m512d
+    gather( double const* base, m512i<std::int64_t> const& index ){
+      m512d result;
+      result.data = _mm512_i64gather_pd( index.bits(), base, 8 );
+      return result;
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m512d
+    gather( double const* base, m512i<std::int64_t> const& index, mask_type const& m ){
+      m512d result;
+      result.data = _mm512_mask_i64gather_pd( _mm512_setzero_pd(), m.bits(), index.bits(), base, 8 );
+      return result;
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.
+     */
+    void
+    scatter( double* base, m512i<std::int64_t> const& index ) const {
+      _mm512_i64scatter_pd( base, index.bits(), data, 8 );
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( double* base, m512i<std::int64_t> const& index, mask_type const& m ) const {
+      _mm512_mask_i64scatter_pd( base, m.bits(), index.bits(), data, 8 );
+    }
+
+
+    //
+    // assignment
+    //
+
+    m512d&
+    operator =(m512d const& input){
+      data = input.data;
+      return *this;
+    }
+
+    m512d&
+    operator =(double input){
+      data = _mm512_set1_pd(input);
+      return *this;
+    }
+
+    m512d&
+    operator =(double const* ptr){
+      data = _mm512_load_pd(ptr);
+      return *this;
+    }
+
+    m512d&
+    operator =(unaligned<double> const& u){
+      data = _mm512_loadu_pd(u.ptr);
+      return *this;
+    }
+
+    m512d&
+    operator =(stream<double> const& s){
+      data = _mm512_castsi512_pd( _mm512_stream_load_si512((void*)(s.ptr)));
+      return *this;
+    }
+
+    //
+    // compound assignment
+    //
+    m512d&
+    operator +=(m512d const& b){
+      data = _mm512_add_pd(data, b.data);
+      return *this;
+    }
+
+    m512d&
+    operator -=(m512d const& b){
+      data = _mm512_sub_pd(data, b.data);
+      return *this;
+    }
+
+    m512d&
+    operator *=(m512d const& b){
+      data = _mm512_mul_pd(data, b.data);
+      return *this;
+    }
+
+    m512d&
+    operator /=(m512d const& b){
+      data = _mm512_div_pd(data, b.data);
+      return *this;
+    }
+
+    //
+    // unary operators
+    //
+
+    friend m512d
+    neg(m512d const& a){
+      return -1.0*a;
+    }
+
+    friend m512d
+    abs(m512d const& a){
+      m512d result;
+      result.data = _mm512_abs_pd( a.data );
+      return result;
+    }
+
+    friend m512d
+    ceil( m512d const& a ){
+      m512d result;
+      result.data = _mm512_roundscale_pd( a.data, EQUAL_OR_LARGER_INTEGER);
+      return result;
+    }
+
+    friend m512d
+    floor( m512d const& a ){
+      m512d result;
+      result.data = _mm512_roundscale_pd( a.data, EQUAL_OR_SMALLER_INTEGER);
+      return result;
+    }
+
+    friend m512d
+    round( m512d const& a ){
+      m512d result;
+      result.data = _mm512_roundscale_pd( a.data, NEAREST_EVEN_INTEGER);
+      return result;
+    }
+
+    friend m512d
+    trunc( m512d const& a ){
+      m512d result;
+      result.data = _mm512_roundscale_pd( a.data, NEAREST_SMALLEST_MAGNITUDE_INTEGER);
+      return result;
+    }
+
+    friend m512d
+    sqrt( m512d const& a ){
+      m512d result;
+      result.data = _mm512_sqrt_pd( a.data );
+      return result;
+    }
+
+    friend m512d
+    rsqrt( m512d const& a ){
+      m512d result;
+      result.data = _mm512_rsqrt14_pd( a.data );
+      return result;
+    }
+
+    friend m512d
+    rcp( m512d const& a ){
+      m512d result;
+      result.data = _mm512_rcp14_pd( a.data );
+      return result;
+    }
+
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for finite nonzero a, subnormal values included.
+     */
+    friend m512d
+    frexp( m512d const& a, m512d& e ){
+      e.data = _mm512_add_pd( _mm512_getexp_pd( a.data ), _mm512_set1_pd( 1 ));
+      m512d result;
+      result.data = _mm512_getmant_pd( a.data, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src );
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e */
+    friend m512d
+    ldexp( m512d const& a, m512d const& e ){
+      m512d result;
+      result.data = _mm512_scalef_pd( a.data, e.data );
+      return result;
+    }
+    
+    //
+    // binary arithmetic
+    //
+   
+    friend m512d
+    operator +(m512d const& a, m512d const& b){
+      m512d result;
+      result.data = _mm512_add_pd(a.data, b.data);
+      return result;
+    }
+
+    friend m512d
+    operator -(m512d const& a, m512d const& b){
+      m512d result;
+      result.data = _mm512_sub_pd(a.data, b.data);
+      return result;
+    }
+
+    friend m512d
+    operator *(m512d const& a, m512d const& b){
+      m512d result;
+      result.data = _mm512_mul_pd(a.data, b.data);
+      return result;
+    }
+
+    friend m512d
+    operator /(m512d const& a, m512d const& b){
+      m512d result;
+      result.data = _mm512_div_pd(a.data, b.data);
+      return result;
+    }
+
+    friend m512d
+    min( m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_min_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m512d
+    max( m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_max_pd( a.data, b.data );
+      return result;
+    }
+
+    //
+    // trinary arithmetic
+    //
+    friend m512d
+    fma(m512d const& a, m512d const& b, m512d const& c){
+      m512d result;
+      result.data = _mm512_fmadd_pd(a.data, b.data, c.data);
+      return result;
+    }
+
+    friend m512d
+    fms(m512d const& a, m512d const& b, m512d const& c){
+      m512d result;
+      result.data = _mm512_fmsub_pd(a.data, b.data, c.data);
+      return result;
+    }
+
+    friend m512d
+    fnma(m512d const& a, m512d const& b, m512d const& c){
+      m512d result;
+      result.data = _mm512_fnmadd_pd(a.data, b.data, c.data);
+      return result;
+    }
+
+    friend m512d
+    fnms(m512d const& a, m512d const& b, m512d const& c){
+      m512d result;
+      result.data = _mm512_fnmsub_pd(a.data, b.data, c.data);
+      return result;
+    }
+
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
+    friend m512d
+    fmaddsub(m512d const& a, m512d const& b, m512d const& c){
+      m512d result;
+      result.data = _mm512_fmaddsub_pd(a.data, b.data, c.data);
+      return result;
+    }
+
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m512d
+    add( mask_type const& m, m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_mask_add_pd( a.data, m.bits(), a.data, b.data );
+      return result;
+    }
+
+    friend m512d
+    subtract( mask_type const& m, m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_mask_sub_pd( a.data, m.bits(), a.data, b.data );
+      return result;
+    }
+
+    friend m512d
+    multiply( mask_type const& m, m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_mask_mul_pd( a.data, m.bits(), a.data, b.data );
+      return result;
+    }
+
+    friend m512d
+    divide( mask_type const& m, m512d const& a, m512d const& b ){
+      m512d result;
+      result.data = _mm512_mask_div_pd( a.data, m.bits(), a.data, b.data );
+      return result;
+    }
+
+    //
+    // binary comparison
+    //
+    friend mask_type
+    operator ==(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_EQ_OS ));
+    }
+
+    friend mask_type
+    operator !=(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_NEQ_UQ ));
+    }
+
+    friend mask_type
+    operator <(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_LT_OS ));
+    }
+
+    friend mask_type
+    operator <=(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_LE_OS ));
+    }
+
+    friend mask_type
+    operator >(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_GT_OS ));
+    }
+
+    friend mask_type
+    operator >=(m512d const& a, m512d const& b){
+      return mask_type( _mm512_cmp_pd_mask( a.data, b.data, _CMP_GE_OS ));
+    }
+
+    //
+    // conditional
+    //
+    friend m512d
+    cond( mask_type const& test, m512d const& pass, m512d const& fail ){
+      m512d result;
+      result.data = _mm512_mask_blend_pd( test.bits(), fail.data, pass.data );
+      return result;
+    }
+    
+    //
+    // horizontal reductions
+    //
+    friend double
+    hsum( m512d const& a ){
+      return _mm512_reduce_add_pd( a.data );
+    }
+
+    friend double
+    hprod( m512d const& a ){
+      return _mm512_reduce_mul_pd( a.data );
+    }
+
+    friend double
+    hmin( m512d const& a ){
+      return _mm512_reduce_min_pd( a.data );
+    }
+
+    friend double
+    hmax( m512d const& a ){
+      return _mm512_reduce_max_pd( a.data );
+    }
+
+    friend double
+    dot( m512d const& a, m512d const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m512d const& a ){
+      return find_first( a == m512d( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m512d const& a ){
+      return find_first( a == m512d( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type ... I >
+    static m512d
+    shuffle( m512d const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m512d result;
+      if constexpr ( Lanes::within_blocks( index, 2 )){
+	constexpr int immediate = Lanes::immediate2( index );
+	result.data = _mm512_permute_pd( a.data, immediate );
+      }
+      else {
+	constexpr array<long long,extent> lanes{{ (long long)( I ) ... }};
+	result.data = _mm512_permutexvar_pd( _mm512_loadu_si512( lanes.data()), a.data );
+      }
+      return result;
+    }
+
+    template< size_type ... I >
+    static m512d
+    shuffle( m512d const& a, m512d const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      m512d result;
+      if constexpr ( Lanes::all_below( index, extent )){
+	result = shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	result = shuffle<( I - extent ) ...>( b );
+      }
+      else if constexpr ( Lanes::pairs_in_blocks( index, 2, extent )){
+	constexpr int immediate = Lanes::immediate2( index );
+	result.data = _mm512_shuffle_pd( a.data, b.data, immediate );
+      }
+      else {
+	constexpr array<long long,extent> lanes{{ (long long)( I ) ... }};
+	result.data = _mm512_permutex2var_pd( a.data, _mm512_loadu_si512( lanes.data()), b.data );
+      }
+      return result;
+    }
+
+    /** The raw register */
+    __m512d
+    bits() const { return data; }
+
+  private:
+    __m512d data;
+  }; // end of class m512d
+
+  
+} // end of namespace AVX512
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<double,avx512_tag>
+  {
+    using type = AVX512::m512d;
+  };
+  
+} // end of namespace ShortVector::Private
+
+#endif // ! defined M512D_HPP_INCLUDED_1769424350919374416
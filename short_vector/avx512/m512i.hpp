@@ -0,0 +1,802 @@
+#ifndef M512I_HPP_INCLUDED_1254873089964513760
+#define M512I_HPP_INCLUDED_1254873089964513760 1
+
+//
+// ... Standard header files
+//
+#include <cstdint>
+#include <type_traits>
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/avx512/mask.hpp>
+
+namespace AVX512
+{
+
+  /** A register of 512 bits viewed as lanes of the integer type T
+   *
+   * The lanes may be signed or unsigned integers of 8, 16, 32 or 64
+   * bits; lanes of 8 and 16 bits require AVX512BW.  The 8 bit shifts
+   * and multiplication are composed from 16 bit instructions.
+   */
+  template< typename T >
+  class m512i
+  {
+  public:
+
+    static_assert( std::is_integral_v<T> && ! std::is_same_v<T,bool>,
+		   "The lanes of m512i must be integers" );
+
+    using value_type = T;
+
+    static constexpr size_type extent = 64/sizeof(T);
+
+    using mask_type = mask<extent>;
+
+    /** The lanes of the indices of gathers and scatters */
+    using index_type = std::make_signed_t<T>;
+
+    //
+    // constructors
+    //
+    m512i(){}
+
+    m512i( m512i const& input ){
+      data = input.data;
+    }
+
+    m512i( value_type input ){
+      data = set1( input );
+    }
+
+    m512i( value_type const* ptr ){
+      data = _mm512_load_si512( (void const*)ptr );
+    }
+
+    m512i( unaligned<value_type> const& u ){
+      data = _mm512_loadu_si512( (void const*)u.ptr );
+    }
+
+    m512i( stream<value_type> const& s ){
+      data = _mm512_stream_load_si512( (void*)s.ptr );
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m512i( value_type const* ptr, mask_type const& m ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	data = _mm512_maskz_loadu_epi8( m.bits(), ptr );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	data = _mm512_maskz_loadu_epi16( m.bits(), ptr );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	data = _mm512_maskz_loadu_epi32( m.bits(), ptr );
+      }
+      else {
+	data = _mm512_maskz_loadu_epi64( m.bits(), ptr );
+      }
+    }
+
+    //
+    // store
+    //
+    void
+    store( value_type* ptr ) const {
+      _mm512_store_si512( (void*)ptr, data );
+    }
+
+    void
+    store( unaligned<value_type> const& u ) const {
+      _mm512_storeu_si512( (void*)u.ptr, data );
+    }
+
+    void
+    store( stream<value_type> const& s ) const {
+      _mm512_stream_si512( (__m512i*)s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( value_type* ptr, mask_type const& m ) const {
+      if constexpr ( sizeof(value_type) == 1 ){
+	_mm512_mask_storeu_epi8( ptr, m.bits(), data );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	_mm512_mask_storeu_epi16( ptr, m.bits(), data );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	_mm512_mask_storeu_epi32( ptr, m.bits(), data );
+      }
+      else {
+	_mm512_mask_storeu_epi64( ptr, m.bits(), data );
+      }
+    }
+
+    //
+    // gather and scatter
+    //
+
+    /** The lanes base[index[i]], for indices in any order
+     *
+     * The indices are signed lanes of the width of value_type.
+     * AVX-512 gathers lanes of 32 and 64 bits; narrower lanes are read
+     * one at a time.
+     */
+    static m512i
+    gather( value_type const* base, m512i<index_type> const& index ){
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_i32gather_epi32( index.bits(), base, scale ));
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm512_i64gather_epi64( index.bits(), base, scale ));
+      }
+      else {
+	alignas(64) index_type offsets[ extent ];
+	alignas(64) value_type lanes[ extent ];
+	index.store( offsets );
+	for( size_type i = 0; i < extent; ++i ){
+	  lanes[i] = base[ offsets[i] ];
+	}
+	return m512i( lanes );
+      }
+    }
+
+    /** Gather the lanes of the mask
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    static m512i
+    gather( value_type const* base, m512i<index_type> const& index, mask_type const& m ){
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_mask_i32gather_epi32( _mm512_setzero_si512(), m.bits(), index.bits(), base, scale ));
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm512_mask_i64gather_epi64( _mm512_setzero_si512(), m.bits(), index.bits(), base, scale ));
+      }
+      else {
+	alignas(64) index_type offsets[ extent ];
+	alignas(64) value_type lanes[ extent ] = {};
+	index.store( offsets );
+	for( size_type i = 0; i < extent; ++i ){
+	  if( m[i] ) lanes[i] = base[ offsets[i] ];
+	}
+	return m512i( lanes );
+      }
+    }
+
+    /** Store the lanes to base[index[i]]
+     *
+     * Where indices repeat, the highest of their lanes is stored.
+     * Lanes of 8 and 16 bits are stored one at a time.
+     */
+    void
+    scatter( value_type* base, m512i<index_type> const& index ) const {
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	_mm512_i32scatter_epi32( base, index.bits(), data, scale );
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	_mm512_i64scatter_epi64( base, index.bits(), data, scale );
+      }
+      else {
+	alignas(64) index_type offsets[ extent ];
+	alignas(64) value_type lanes[ extent ];
+	index.store( offsets );
+	store( lanes );
+	for( size_type i = 0; i < extent; ++i ){
+	  base[ offsets[i] ] = lanes[i];
+	}
+      }
+    }
+
+    /** Scatter the lanes of the mask
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    scatter( value_type* base, m512i<index_type> const& index, mask_type const& m ) const {
+      constexpr int scale = sizeof(value_type);
+      if constexpr ( sizeof(value_type) == 4 ){
+	_mm512_mask_i32scatter_epi32( base, m.bits(), index.bits(), data, scale );
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	_mm512_mask_i64scatter_epi64( base, m.bits(), index.bits(), data, scale );
+      }
+      else {
+	alignas(64) index_type offsets[ extent ];
+	alignas(64) value_type lanes[ extent ];
+	index.store( offsets );
+	store( lanes );
+	for( size_type i = 0; i < extent; ++i ){
+	  if( m[i] ) base[ offsets[i] ] = lanes[i];
+	}
+      }
+    }
+
+    /** The lanes as an intrinsic register */
+    __m512i
+    bits() const { return data; }
+
+    //
+    // assignment
+    //
+    m512i&
+    operator =( m512i const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    m512i&
+    operator =( value_type const* ptr ){
+      data = _mm512_load_si512( (void const*)ptr );
+      return *this;
+    }
+
+    m512i&
+    operator =( unaligned<value_type> const& u ){
+      data = _mm512_loadu_si512( (void const*)u.ptr );
+      return *this;
+    }
+
+    m512i&
+    operator =( stream<value_type> const& s ){
+      data = _mm512_stream_load_si512( (void*)s.ptr );
+      return *this;
+    }
+
+    //
+    // compound assignment
+    //
+    m512i&
+    operator +=( m512i const& b ){
+      return *this = *this + b;
+    }
+
+    m512i&
+    operator -=( m512i const& b ){
+      return *this = *this - b;
+    }
+
+    m512i&
+    operator *=( m512i const& b ){
+      return *this = *this * b;
+    }
+
+    m512i&
+    operator &=( m512i const& b ){
+      return *this = *this & b;
+    }
+
+    m512i&
+    operator |=( m512i const& b ){
+      return *this = *this | b;
+    }
+
+    m512i&
+    operator ^=( m512i const& b ){
+      return *this = *this ^ b;
+    }
+
+    m512i&
+    operator <<=( int n ){
+      return *this = *this << n;
+    }
+
+    m512i&
+    operator >>=( int n ){
+      return *this = *this >> n;
+    }
+
+    //
+    // unary operators
+    //
+    friend m512i
+    neg( m512i const& a ){
+      return m512i( value_type(0) ) - a;
+    }
+
+    friend m512i
+    abs( m512i const& a ){
+      if constexpr ( std::is_unsigned_v<value_type> ){
+	return a;
+      }
+      else if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm512_abs_epi8( a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_abs_epi16( a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_abs_epi32( a.data ));
+      }
+      else {
+	return make( _mm512_abs_epi64( a.data ));
+      }
+    }
+
+    friend m512i
+    operator ~( m512i const& a ){
+      return make( _mm512_ternarylogic_epi32( a.data, a.data, a.data, 0x55 ));
+    }
+
+    //
+    // binary arithmetic
+    //
+    friend m512i
+    operator +( m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm512_add_epi8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_add_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_add_epi32( a.data, b.data ));
+      }
+      else {
+	return make( _mm512_add_epi64( a.data, b.data ));
+      }
+    }
+
+    friend m512i
+    operator -( m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm512_sub_epi8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_sub_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_sub_epi32( a.data, b.data ));
+      }
+      else {
+	return make( _mm512_sub_epi64( a.data, b.data ));
+      }
+    }
+
+    /** The low half of the product of each lane */
+    friend m512i
+    operator *( m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	__m512i even = _mm512_mullo_epi16( a.data, b.data );
+	__m512i odd = _mm512_mullo_epi16( _mm512_srli_epi16( a.data, 8 ), _mm512_srli_epi16( b.data, 8 ));
+	return make( _mm512_or_si512( _mm512_slli_epi16( odd, 8 ),
+				      _mm512_and_si512( even, _mm512_set1_epi16( 0x00FF ))));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_mullo_epi16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_mullo_epi32( a.data, b.data ));
+      }
+      else {
+	return make( _mm512_mullo_epi64( a.data, b.data ));
+      }
+    }
+
+    friend m512i
+    min( m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_min_epi8( a.data, b.data )
+		     : _mm512_min_epu8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_min_epi16( a.data, b.data )
+		     : _mm512_min_epu16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_min_epi32( a.data, b.data )
+		     : _mm512_min_epu32( a.data, b.data ));
+      }
+      else {
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_min_epi64( a.data, b.data )
+		     : _mm512_min_epu64( a.data, b.data ));
+      }
+    }
+
+    friend m512i
+    max( m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_max_epi8( a.data, b.data )
+		     : _mm512_max_epu8( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_max_epi16( a.data, b.data )
+		     : _mm512_max_epu16( a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_max_epi32( a.data, b.data )
+		     : _mm512_max_epu32( a.data, b.data ));
+      }
+      else {
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_max_epi64( a.data, b.data )
+		     : _mm512_max_epu64( a.data, b.data ));
+      }
+    }
+
+    //
+    // bitwise operators
+    //
+    friend m512i
+    operator &( m512i const& a, m512i const& b ){
+      return make( _mm512_and_si512( a.data, b.data ));
+    }
+
+    friend m512i
+    operator |( m512i const& a, m512i const& b ){
+      return make( _mm512_or_si512( a.data, b.data ));
+    }
+
+    friend m512i
+    operator ^( m512i const& a, m512i const& b ){
+      return make( _mm512_xor_si512( a.data, b.data ));
+    }
+
+    /** The bits of b that are not set in a */
+    friend m512i
+    andnot( m512i const& a, m512i const& b ){
+      return make( _mm512_andnot_si512( a.data, b.data ));
+    }
+
+    //
+    // shifts
+    //
+    friend m512i
+    operator <<( m512i const& a, int n ){
+      __m128i count = _mm_cvtsi32_si128( n );
+      if constexpr ( sizeof(value_type) == 1 ){
+	unsigned k = unsigned( n ) < 8u ? unsigned( n ) : 8u;
+	return make( _mm512_and_si512( _mm512_sll_epi16( a.data, count ),
+				       _mm512_set1_epi8( char( 0xFFu << k ))));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_sll_epi16( a.data, count ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_sll_epi32( a.data, count ));
+      }
+      else {
+	return make( _mm512_sll_epi64( a.data, count ));
+      }
+    }
+
+    /** Shift right, arithmetic for signed lanes and logical for unsigned lanes
+     *
+     * As with the shift instructions, n is read as unsigned, and counts
+     * of the lane width or more leave zeros in unsigned lanes and copies
+     * of the sign bit in signed lanes.
+     */
+    friend m512i
+    operator >>( m512i const& a, int n ){
+      __m128i count = _mm_cvtsi32_si128( n );
+      if constexpr ( sizeof(value_type) == 1 ){
+	// a signed shift by 7 already leaves only copies of the sign bit
+	unsigned limit = std::is_signed_v<value_type> ? 7u : 8u;
+	unsigned k = unsigned( n ) < limit ? unsigned( n ) : limit;
+	__m512i shifted = _mm512_and_si512( _mm512_srl_epi16( a.data, _mm_cvtsi32_si128( int( k ))),
+					    _mm512_set1_epi8( char( 0xFFu >> k )));
+	if constexpr ( std::is_signed_v<value_type> ){
+	  __m512i sign = _mm512_set1_epi8( char( 0x80u >> k ));
+	  shifted = _mm512_sub_epi8( _mm512_xor_si512( shifted, sign ), sign );
+	}
+	return make( shifted );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_sra_epi16( a.data, count )
+		     : _mm512_srl_epi16( a.data, count ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_sra_epi32( a.data, count )
+		     : _mm512_srl_epi32( a.data, count ));
+      }
+      else {
+	return make( std::is_signed_v<value_type>
+		     ? _mm512_sra_epi64( a.data, count )
+		     : _mm512_srl_epi64( a.data, count ));
+      }
+    }
+
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m512i
+    add( mask_type const& m, m512i const& a, m512i const& b ){
+      return blend( m, a, a + b );
+    }
+
+    friend m512i
+    subtract( mask_type const& m, m512i const& a, m512i const& b ){
+      return blend( m, a, a - b );
+    }
+
+    friend m512i
+    multiply( mask_type const& m, m512i const& a, m512i const& b ){
+      return blend( m, a, a*b );
+    }
+
+    //
+    // binary comparison
+    //
+    friend mask_type
+    operator ==( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_EQ>( a.data, b.data );
+    }
+
+    friend mask_type
+    operator !=( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_NE>( a.data, b.data );
+    }
+
+    friend mask_type
+    operator <( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_LT>( a.data, b.data );
+    }
+
+    friend mask_type
+    operator <=( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_LE>( a.data, b.data );
+    }
+
+    friend mask_type
+    operator >( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_NLE>( a.data, b.data );
+    }
+
+    friend mask_type
+    operator >=( m512i const& a, m512i const& b ){
+      return compare<_MM_CMPINT_NLT>( a.data, b.data );
+    }
+
+    //
+    // conditional
+    //
+    friend m512i
+    cond( mask_type const& test, m512i const& pass, m512i const& fail ){
+      return blend( test, fail, pass );
+    }
+
+    //
+    // horizontal reductions, wrapping around like the lane arithmetic
+    //
+    friend value_type
+    hsum( m512i const& a ){
+      return reduce( a, []( m512i const& x, m512i const& y ){ return x + y; });
+    }
+
+    friend value_type
+    hprod( m512i const& a ){
+      return reduce( a, []( m512i const& x, m512i const& y ){ return x*y; });
+    }
+
+    friend value_type
+    hmin( m512i const& a ){
+      return reduce( a, []( m512i const& x, m512i const& y ){ return min( x, y ); });
+    }
+
+    friend value_type
+    hmax( m512i const& a ){
+      return reduce( a, []( m512i const& x, m512i const& y ){ return max( x, y ); });
+    }
+
+    friend value_type
+    dot( m512i const& a, m512i const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m512i const& a ){
+      return find_first( a == m512i( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m512i const& a ){
+      return find_first( a == m512i( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+
+    /** Without AVX512VBMI, bytes only move within blocks of 16, so
+     *  bytes moving across blocks are moved one at a time. */
+    template< size_type ... I >
+    static m512i
+    shuffle( m512i const& a ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm512_permutexvar_epi64( constant( array<long long,extent>{{ (long long)( I ) ... }} ), a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_permutexvar_epi32( constant( array<int,extent>{{ int( I ) ... }} ), a.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_permutexvar_epi16( constant( array<short,extent>{{ short( I ) ... }} ), a.data ));
+      }
+#if defined(__AVX512VBMI__)
+      else {
+	return make( _mm512_permutexvar_epi8( constant( array<char,extent>{{ char( I ) ... }} ), a.data ));
+      }
+#else
+      else if constexpr ( Lanes::within_blocks( index, 16 )){
+	return make( _mm512_shuffle_epi8( a.data, constant( Lanes::byte_control<64>( index, 1 ))));
+      }
+      else {
+	alignas(64) value_type lanes[ extent ];
+	a.store( lanes );
+	alignas(64) value_type result[ extent ] = { lanes[ I ] ... };
+	return m512i( result );
+      }
+#endif
+    }
+
+    template< size_type ... I >
+    static m512i
+    shuffle( m512i const& a, m512i const& b ){
+      static_assert( sizeof...(I) == extent, "one lane index per lane" );
+      static_assert((( I < 2*extent ) && ... ), "lane index out of range" );
+      constexpr array<size_type,extent> index{{ I ... }};
+      if constexpr ( Lanes::all_below( index, extent )){
+	return shuffle<I...>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, extent )){
+	return shuffle<( I - extent ) ...>( b );
+      }
+      else if constexpr ( sizeof(value_type) == 8 ){
+	return make( _mm512_permutex2var_epi64( a.data, constant( array<long long,extent>{{ (long long)( I ) ... }} ), b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_permutex2var_epi32( a.data, constant( array<int,extent>{{ int( I ) ... }} ), b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_permutex2var_epi16( a.data, constant( array<short,extent>{{ short( I ) ... }} ), b.data ));
+      }
+#if defined(__AVX512VBMI__)
+      else {
+	return make( _mm512_permutex2var_epi8( a.data, constant( array<char,extent>{{ char( I ) ... }} ), b.data ));
+      }
+#else
+      else {
+	return blend( mask_type( typename mask_type::bits_type( Lanes::beyond( index, extent ))),
+		      shuffle<( I%extent ) ...>( a ), shuffle<( I%extent ) ...>( b ));
+      }
+#endif
+    }
+
+  private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines every lane with the lane half the remaining
+     * distance above it, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static value_type
+    reduce( m512i a, Op op ){
+      a = op( a, make( _mm512_shuffle_i64x2( a.data, a.data, _MM_SHUFFLE( 1, 0, 3, 2 ))));
+      a = op( a, make( _mm512_shuffle_i64x2( a.data, a.data, _MM_SHUFFLE( 2, 3, 0, 1 ))));
+      a = op( a, make( _mm512_shuffle_epi32( a.data, _MM_PERM_ENUM( _MM_SHUFFLE( 1, 0, 3, 2 )))));
+      if constexpr ( sizeof(value_type) <= 4 ){
+	a = op( a, make( _mm512_shuffle_epi32( a.data, _MM_PERM_ENUM( _MM_SHUFFLE( 2, 3, 0, 1 )))));
+      }
+      if constexpr ( sizeof(value_type) <= 2 ){
+	a = op( a, make( _mm512_srli_epi32( a.data, 16 )));
+      }
+      if constexpr ( sizeof(value_type) == 1 ){
+	a = op( a, make( _mm512_srli_epi16( a.data, 8 )));
+      }
+      return value_type( _mm_cvtsi128_si64( _mm512_castsi512_si128( a.data )));
+    }
+
+    static m512i
+    make( __m512i input ){
+      m512i result;
+      result.data = input;
+      return result;
+    }
+
+    /** A register holding the 64 bytes of a compile time table */
+    template< typename U, std::size_t N >
+    static __m512i
+    constant( array<U,N> const& table ){
+      static_assert( sizeof(U)*N == 64, "a table of 64 bytes" );
+      return _mm512_loadu_si512( table.data());
+    }
+
+    static __m512i
+    set1( value_type x ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return _mm512_set1_epi8( char(x) );
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return _mm512_set1_epi16( short(x) );
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return _mm512_set1_epi32( int(x) );
+      }
+      else {
+	return _mm512_set1_epi64( (long long)(x) );
+      }
+    }
+
+    /** The mask of the lanes where the predicate P holds for a and b */
+    template< int P >
+    static mask_type
+    compare( __m512i a, __m512i b ){
+      constexpr bool is_signed = std::is_signed_v<value_type>;
+      if constexpr ( sizeof(value_type) == 1 ){
+	return mask_type( is_signed ? _mm512_cmp_epi8_mask( a, b, P ) : _mm512_cmp_epu8_mask( a, b, P ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return mask_type( is_signed ? _mm512_cmp_epi16_mask( a, b, P ) : _mm512_cmp_epu16_mask( a, b, P ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return mask_type( is_signed ? _mm512_cmp_epi32_mask( a, b, P ) : _mm512_cmp_epu32_mask( a, b, P ));
+      }
+      else {
+	return mask_type( is_signed ? _mm512_cmp_epi64_mask( a, b, P ) : _mm512_cmp_epu64_mask( a, b, P ));
+      }
+    }
+
+    /** The lanes of b where the mask is set and of a elsewhere */
+    static m512i
+    blend( mask_type const& m, m512i const& a, m512i const& b ){
+      if constexpr ( sizeof(value_type) == 1 ){
+	return make( _mm512_mask_blend_epi8( m.bits(), a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 2 ){
+	return make( _mm512_mask_blend_epi16( m.bits(), a.data, b.data ));
+      }
+      else if constexpr ( sizeof(value_type) == 4 ){
+	return make( _mm512_mask_blend_epi32( m.bits(), a.data, b.data ));
+      }
+      else {
+	return make( _mm512_mask_blend_epi64( m.bits(), a.data, b.data ));
+      }
+    }
+
+    __m512i data;
+  }; // end of class m512i
+
+} // end of namespace AVX512
+
+namespace ShortVector::Private
+{
+  template< typename T >
+  struct Register<T,avx512_tag,std::enable_if_t<std::is_integral_v<T> && ! std::is_same_v<T,bool>>>
+  {
+    using type = AVX512::m512i<T>;
+  };
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined M512I_HPP_INCLUDED_1254873089964513760
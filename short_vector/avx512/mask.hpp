@@ -0,0 +1,125 @@
+#ifndef AVX512_MASK_HPP_INCLUDED_1742096385127740461
+#define AVX512_MASK_HPP_INCLUDED_1742096385127740461 1
+
+//
+// ... Standard header files
+//
+#include <type_traits>
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/avx512/utility.hpp>
+
+namespace AVX512
+{
+
+  /** The result of comparing two registers of N lanes
+   *
+   * One bit per lane, held in the narrowest of the opmask types
+   * __mmask8, __mmask16, __mmask32 and __mmask64 that fits N lanes.
+   */
+  template< size_type N >
+  class mask
+  {
+  public:
+
+    static_assert( N == 8 || N == 16 || N == 32 || N == 64,
+		   "An opmask has 8, 16, 32 or 64 lanes" );
+
+    using bits_type =
+      std::conditional_t<N == 8, __mmask8,
+      std::conditional_t<N == 16, __mmask16,
+      std::conditional_t<N == 32, __mmask32, __mmask64>>>;
+
+    static constexpr size_type extent = N;
+
+    mask(){}
+
+    explicit
+    mask( bool input )
+      : data( input ? full : bits_type(0) )
+    {}
+
+    explicit
+    mask( bits_type input )
+      : data( input )
+    {}
+
+    bits_type
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static mask
+    first( size_type n ){
+      return mask( n <= 0 ? bits_type(0)
+		   : n >= N ? full
+		   : bits_type( ( 1ull << n ) - 1 ));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( data >> i ) & 1;
+    }
+
+    friend mask
+    operator &( mask const& a, mask const& b ){
+      return mask( bits_type( a.data & b.data ));
+    }
+
+    friend mask
+    operator |( mask const& a, mask const& b ){
+      return mask( bits_type( a.data | b.data ));
+    }
+
+    friend mask
+    operator ^( mask const& a, mask const& b ){
+      return mask( bits_type( a.data ^ b.data ));
+    }
+
+    friend mask
+    operator ~( mask const& a ){
+      return mask( bits_type( ~a.data ));
+    }
+
+    friend bool
+    any( mask const& a ){
+      return a.data != 0;
+    }
+
+    friend bool
+    all( mask const& a ){
+      return a.data == full;
+    }
+
+    friend bool
+    none( mask const& a ){
+      return a.data == 0;
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( mask const& a ){
+      return a.data ? __builtin_ctzll( a.data ) : extent;
+    }
+
+    friend size_type
+    popcount( mask const& a ){
+      return __builtin_popcountll( a.data );
+    }
+
+  private:
+
+    static constexpr bits_type full = bits_type( ~0ull );
+
+    bits_type data;
+  }; // end of class mask
+
+} // end of namespace AVX512
+
+#endif // ! defined AVX512_MASK_HPP_INCLUDED_1742096385127740461
@@ -0,0 +1,31 @@
+#ifndef AVX512_UTILITY_HPP_INCLUDED_830117265498123745
+#define AVX512_UTILITY_HPP_INCLUDED_830117265498123745 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/utility.hpp>
+
+namespace AVX512
+{
+
+  using ShortVector::size_type;
+
+  using ShortVector::Private::unaligned;
+  using ShortVector::Private::stream;
+
+  using ShortVector::array;
+
+  namespace Lanes = ShortVector::Private::Lanes;
+
+  /** Rounding modes of the roundscale instructions */
+  enum{
+    NEAREST_EVEN_INTEGER = 0,
+    EQUAL_OR_SMALLER_INTEGER = 1,
+    EQUAL_OR_LARGER_INTEGER =2,
+    NEAREST_SMALLEST_MAGNITUDE_INTEGER=3
+  };
+  
+} // end of namespace AVX512
+
+#endif // ! defined AVX512_UTILITY_HPP_INCLUDED_830117265498123745
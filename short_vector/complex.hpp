@@ -0,0 +1,411 @@
+#ifndef COMPLEX_HPP_INCLUDED_4417960382215637094
+#define COMPLEX_HPP_INCLUDED_4417960382215637094 1
+
+//
+// ... Standard header files
+//
+#include <complex>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Complex values in short vectors and registers
+ *
+ * Interleaved_complex<V> holds complex values in a vector V of their
+ * parts, the real part of each value followed by its imaginary part,
+ * as std::complex lays them out in memory, so that they load and
+ * store as they are.  A product is three shuffles of the parts, a
+ * multiply and an fmaddsub.  The arithmetic is that of the textbook
+ * formulas: unlike std::complex, nothing is recomputed where a product
+ * or a quotient overflows or gives NaN.
+ *
+ * Split_complex<V> holds the real and the imaginary parts in vectors
+ * of their own, where a product is four multiplies and no shuffles.
+ * split and interleave convert between the two, two interleaved
+ * vectors at a time.
+ */
+namespace ShortVector::Private
+{
+
+  namespace Complexes
+  {
+    /** The lanes of the parts of V */
+    template< typename V >
+    using Parts = typename Generate_indices<V::extent>::type;
+
+    /** The real part of each value in both its lanes */
+    template< typename V, size_type ... I >
+    V
+    real_parts( V const& x, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I & ~size_type( 1 )) ...>( x );
+    }
+
+    /** The imaginary part of each value in both its lanes */
+    template< typename V, size_type ... I >
+    V
+    imag_parts( V const& x, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I | 1 ) ...>( x );
+    }
+
+    /** The parts of each value exchanged */
+    template< typename V, size_type ... I >
+    V
+    swap_parts( V const& x, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I ^ 1 ) ...>( x );
+    }
+
+    /** The lanes of x at the real parts and of y at the imaginary ones */
+    template< typename V, size_type ... I >
+    V
+    alternate( V const& x, V const& y, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I % 2 ? I + sizeof...(I) : I ) ...>( x, y );
+    }
+
+    /** The even lanes of x followed by y */
+    template< typename V, size_type ... I >
+    V
+    evens( V const& x, V const& y, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( 2*I ) ...>( x, y );
+    }
+
+    template< typename V, size_type ... I >
+    V
+    odds( V const& x, V const& y, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( 2*I + 1 ) ...>( x, y );
+    }
+
+    /** The lanes of the first halves of x and y, alternately */
+    template< typename V, size_type ... I >
+    V
+    low_pairs( V const& x, V const& y, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I/2 + I%2*sizeof...(I) ) ...>( x, y );
+    }
+
+    template< typename V, size_type ... I >
+    V
+    high_pairs( V const& x, V const& y, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( sizeof...(I)/2 + I/2 + I%2*sizeof...(I) ) ...>( x, y );
+    }
+
+    /** The arithmetic of complex values interleaved in a vector V of
+     *  their parts, for the class Self deriving from it */
+    template< typename V, typename Self >
+    class Interleaved
+    {
+    public:
+
+      using parts_type = V;
+      using real_type = typename V::value_type;
+      using value_type = std::complex<real_type>;
+
+      static constexpr size_type extent = V::extent/2;
+
+      static_assert( V::extent % 2 == 0, "The parts come in pairs" );
+
+      explicit
+      Interleaved( parts_type const& input ) : values( input )
+      {}
+
+      Interleaved( value_type input )
+	: values( alternate( V( input.real()), V( input.imag()), Parts<V>{} ))
+      {}
+
+      /** The parts of the values, real and imaginary alternately */
+      parts_type const&
+      parts() const { return values; }
+
+      Self&
+      operator +=( Self const& input ){
+	return self() = self() + input;
+      }
+
+      Self&
+      operator -=( Self const& input ){
+	return self() = self() - input;
+      }
+
+      Self&
+      operator *=( Self const& input ){
+	return self() = self()*input;
+      }
+
+      Self&
+      operator /=( Self const& input ){
+	return self() = self()/input;
+      }
+
+    private:
+
+      Self&
+      self(){ return static_cast<Self&>( *this ); }
+
+      /** The squared magnitude of each value in both its lanes */
+      static V
+      magnitudes( V const& xs ){
+	V squares = xs*xs;
+	return squares + swap_parts( squares, Parts<V>{} );
+      }
+
+      friend Self
+      operator +( Self const& xs, Self const& ys ){ return Self( xs.values + ys.values ); }
+
+      friend Self
+      operator -( Self const& xs, Self const& ys ){ return Self( xs.values - ys.values ); }
+
+      friend Self
+      operator -( Self const& xs ){ return Self( xs.values*V( real_type( -1 ))); }
+
+      friend Self
+      operator *( Self const& xs, Self const& ys ){
+	Parts<V> lanes;
+	return Self( fmaddsub( xs.values, real_parts( ys.values, lanes ),
+			       swap_parts( xs.values, lanes )*imag_parts( ys.values, lanes )));
+      }
+
+      friend Self
+      operator *( Self const& xs, real_type y ){ return Self( xs.values*V( y )); }
+
+      friend Self
+      operator *( real_type x, Self const& ys ){ return Self( V( x )*ys.values ); }
+
+      friend Self
+      operator /( Self const& xs, Self const& ys ){
+	return Self(( xs*conj( ys )).values/magnitudes( ys.values ));
+      }
+
+      friend Self
+      operator /( Self const& xs, real_type y ){ return Self( xs.values/V( y )); }
+
+      friend Self
+      conj( Self const& xs ){
+	return Self( xs.values*alternate( V( real_type( 1 )), V( real_type( -1 )), Parts<V>{} ));
+      }
+
+      /** The squared magnitudes, as values of zero imaginary part */
+      friend Self
+      norm( Self const& xs ){
+	return Self( alternate( magnitudes( xs.values ), V( real_type( 0 )), Parts<V>{} ));
+      }
+
+      parts_type values;
+    }; // end of class Interleaved
+
+  } // end of namespace Complexes
+
+
+  /** Complex values interleaved in a register V of their parts */
+  template< typename V >
+  class Interleaved_complex : public Complexes::Interleaved<V,Interleaved_complex<V>>
+  {
+    using base_type = Complexes::Interleaved<V,Interleaved_complex>;
+
+  public:
+
+    using typename base_type::real_type;
+    using typename base_type::value_type;
+
+    using base_type::base_type;
+
+    /** The values at an address aligned to the register */
+    explicit
+    Interleaved_complex( value_type const* ptr )
+      : base_type( V( reinterpret_cast<real_type const*>( ptr )))
+    {}
+
+    void
+    store( value_type* ptr ) const {
+      this->parts().store( reinterpret_cast<real_type*>( ptr ));
+    }
+  }; // end of class Interleaved_complex
+
+  /** Short vectors of N complex values, interleaved in a short vector
+   *  of 2*N parts */
+  template< typename T, size_type N, size_type Align, typename Inst >
+  class alignas(Align) Short_vector<std::complex<T>,N,Align,Inst>
+    : public Complexes::Interleaved<Short_vector<T,2*N,Align,Inst>,Short_vector<std::complex<T>,N,Align,Inst>>
+  {
+    using base_type = Complexes::Interleaved<Short_vector<T,2*N,Align,Inst>,Short_vector>;
+
+  public:
+
+    using typename base_type::parts_type;
+    using typename base_type::value_type;
+
+    using base_type::base_type;
+
+    template< typename F >
+    Short_vector( F&& f, function_tag )
+      : base_type( parts_type( [&f]( size_type i ){
+	  value_type x = f( i/2 );
+	  return i % 2 ? x.imag() : x.real();
+	}, function_tag{} ))
+    {}
+
+    /** The value i; the values cannot be written one by one */
+    value_type
+    operator []( size_type i ) const {
+      return value_type( this->parts()[2*i], this->parts()[2*i + 1] );
+    }
+
+    static constexpr size_type
+    size() { return N; }
+
+    /** The values at an address aligned to Align */
+    static Short_vector
+    load( value_type const* ptr ){
+      return Short_vector( parts_type::load( reinterpret_cast<T const*>( ptr )));
+    }
+
+    /** The values at an address of any alignment */
+    static Short_vector
+    load( unaligned<value_type> const& u ){
+      return Short_vector( parts_type::load( unaligned<T>{ reinterpret_cast<T*>( u.ptr ) }));
+    }
+
+    /** Store the values to an address aligned to Align */
+    void
+    store( value_type* ptr ) const {
+      this->parts().store( reinterpret_cast<T*>( ptr ));
+    }
+
+    void
+    store( unaligned<value_type> const& u ) const {
+      this->parts().store( unaligned<T>{ reinterpret_cast<T*>( u.ptr ) });
+    }
+
+    void
+    store( stream<value_type> const& s ) const {
+      this->parts().store( stream<T>{ reinterpret_cast<T*>( s.ptr ) });
+    }
+  }; // end of class Short_vector
+
+
+  /** Complex values with their real and imaginary parts in vectors V
+   *  of their own */
+  template< typename V >
+  class Split_complex
+  {
+  public:
+
+    using parts_type = V;
+    using real_type = typename V::value_type;
+    using value_type = std::complex<real_type>;
+
+    static constexpr size_type extent = V::extent;
+
+    Split_complex( parts_type const& re, parts_type const& im ) : real_parts( re ), imag_parts( im )
+    {}
+
+    Split_complex( value_type input ) : real_parts( input.real()), imag_parts( input.imag())
+    {}
+
+    parts_type const&
+    real() const { return real_parts; }
+
+    parts_type const&
+    imag() const { return imag_parts; }
+
+    Split_complex&
+    operator +=( Split_complex const& input ){
+      return *this = *this + input;
+    }
+
+    Split_complex&
+    operator -=( Split_complex const& input ){
+      return *this = *this - input;
+    }
+
+    Split_complex&
+    operator *=( Split_complex const& input ){
+      return *this = *this*input;
+    }
+
+    Split_complex&
+    operator /=( Split_complex const& input ){
+      return *this = *this/input;
+    }
+
+  private:
+
+    friend Split_complex
+    operator +( Split_complex const& xs, Split_complex const& ys ){
+      return Split_complex( xs.real_parts + ys.real_parts, xs.imag_parts + ys.imag_parts );
+    }
+
+    friend Split_complex
+    operator -( Split_complex const& xs, Split_complex const& ys ){
+      return Split_complex( xs.real_parts - ys.real_parts, xs.imag_parts - ys.imag_parts );
+    }
+
+    friend Split_complex
+    operator -( Split_complex const& xs ){
+      V minus( real_type( -1 ));
+      return Split_complex( xs.real_parts*minus, xs.imag_parts*minus );
+    }
+
+    friend Split_complex
+    operator *( Split_complex const& xs, Split_complex const& ys ){
+      return Split_complex( fms( xs.real_parts, ys.real_parts, xs.imag_parts*ys.imag_parts ),
+			    fma( xs.real_parts, ys.imag_parts, xs.imag_parts*ys.real_parts ));
+    }
+
+    friend Split_complex
+    operator /( Split_complex const& xs, Split_complex const& ys ){
+      V scale = V( real_type( 1 ))/norm( ys );
+      return Split_complex( fma( xs.real_parts, ys.real_parts, xs.imag_parts*ys.imag_parts )*scale,
+			    fms( xs.imag_parts, ys.real_parts, xs.real_parts*ys.imag_parts )*scale );
+    }
+
+    friend Split_complex
+    conj( Split_complex const& xs ){
+      return Split_complex( xs.real_parts, xs.imag_parts*V( real_type( -1 )));
+    }
+
+    /** The squared magnitudes */
+    friend V
+    norm( Split_complex const& xs ){
+      return fma( xs.real_parts, xs.real_parts, xs.imag_parts*xs.imag_parts );
+    }
+
+    parts_type real_parts;
+    parts_type imag_parts;
+  }; // end of class Split_complex
+
+  namespace Complexes
+  {
+    /** The interleaved complex vectors of the parts V */
+    template< typename V >
+    struct Interleaved_of : Type<Interleaved_complex<V>>
+    {};
+
+    template< typename T, size_type N, size_type Align, typename Inst >
+    struct Interleaved_of<Short_vector<T,N,Align,Inst>> : Type<Short_vector<std::complex<T>,N/2,Align,Inst>>
+    {};
+
+  } // end of namespace Complexes
+
+  /** The values of lo followed by those of hi, with their parts split */
+  template< typename V, typename Self >
+  Split_complex<V>
+  split( Complexes::Interleaved<V,Self> const& lo, Complexes::Interleaved<V,Self> const& hi ){
+    Complexes::Parts<V> lanes;
+    return Split_complex<V>( Complexes::evens( lo.parts(), hi.parts(), lanes ),
+			     Complexes::odds( lo.parts(), hi.parts(), lanes ));
+  }
+
+  /** The values of xs interleaved, the first half of them followed by
+   *  the second */
+  template< typename V >
+  array<typename Complexes::Interleaved_of<V>::type,2>
+  interleave( Split_complex<V> const& xs ){
+    using C = typename Complexes::Interleaved_of<V>::type;
+    Complexes::Parts<V> lanes;
+    return {{ C( Complexes::low_pairs( xs.real(), xs.imag(), lanes )),
+	      C( Complexes::high_pairs( xs.real(), xs.imag(), lanes )) }};
+  }
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined COMPLEX_HPP_INCLUDED_4417960382215637094
@@ -0,0 +1,437 @@
+#ifndef CONVERT_HPP_INCLUDED_8164402957731186250
+#define CONVERT_HPP_INCLUDED_8164402957731186250 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/half.hpp>
+#include <short_vector/expression.hpp>
+
+/** Conversions between the value types of short vectors
+ *
+ * The explicit vectorizations for AVX and AVX-512 convert a register
+ * at a time, and need the convert.hpp header of their instruction
+ * set; the other instruction sets convert a value at a time.
+ *
+ * Short vectors of halves and bfloat16 values store their values in
+ * half the memory of floats, and compute with floats.
+ */
+namespace ShortVector::Private
+{
+
+  namespace Conversion
+  {
+    /** True where the registers of Inst convert */
+    template< typename Inst >
+    constexpr bool by_register = is_same_v<Inst,avx_tag> || is_same_v<Inst,avx512_tag>;
+
+    /** The instruction tag of a short vector type */
+    template< typename V >
+    struct Instructions;
+
+    template< typename T, size_type N, size_type Align, typename Inst >
+    struct Instructions<Short_vector<T,N,Align,Inst>>
+    {
+      using type = Inst;
+    };
+
+    template< typename H >
+    constexpr bool is_narrow = is_same_v<H,half> || is_same_v<H,bfloat16>;
+
+  } // end of namespace Conversion
+
+  /** The values of xs as values of type U, float and double widening
+   *  and narrowing to one another, rounded to nearest even */
+  template< typename U, typename T, size_type N, size_type Align, typename Inst >
+  Short_vector<U,N,Align,Inst>
+  convert( Short_vector<T,N,Align,Inst> const& xs ){
+    using result_type = Short_vector<U,N,Align,Inst>;
+    using Expressions::Access;
+
+    if constexpr( is_same_v<T,U> ){
+      return xs;
+    } else if constexpr( Conversion::by_register<Inst> && is_same_v<T,float> && is_same_v<U,double> ){
+      auto const& in = Access::storage( xs );
+      typename result_type::storage_type out;
+      for( size_type k = 0; k < size_type( in.size()); ++k ){
+	auto halves = Conversions<Inst>::widen( in[k] );
+	out[ 2*k ] = halves[0];
+	out[ 2*k + 1 ] = halves[1];
+      }
+      return Access::make<result_type>( out );
+    } else if constexpr( Conversion::by_register<Inst> && is_same_v<T,double> && is_same_v<U,float> ){
+      auto const& in = Access::storage( xs );
+      typename result_type::storage_type out;
+      for( size_type k = 0; k < size_type( out.size()); ++k ){
+	out[k] = Conversions<Inst>::narrow( in[ 2*k ], in[ 2*k + 1 ] );
+      }
+      return Access::make<result_type>( out );
+    } else {
+      return result_type( [&xs]( size_type i ){ return U( xs[i] ); }, function_tag{});
+    }
+  }
+
+  /** The N halves or bfloat16 values at ptr, at any alignment, as a
+   *  short vector V of floats */
+  template< typename V, typename H >
+  V
+  widen( H const* ptr ){
+    static_assert( is_same_v<typename V::value_type,float>, "Halves widen to floats" );
+    static_assert( Conversion::is_narrow<H>, "Only halves and bfloat16 values widen" );
+    using Expressions::Access;
+    using Inst = typename Conversion::Instructions<V>::type;
+
+    if constexpr( Conversion::by_register<Inst> ){
+      typename V::storage_type out;
+      constexpr size_type lanes = V::extent/size_type( std::tuple_size_v<typename V::storage_type> );
+      for( size_type k = 0; k < size_type( out.size()); ++k ){
+	out[k] = Conversions<Inst>::widen( ptr + k*lanes );
+      }
+      return Access::make<V>( out );
+    } else {
+      return V( [ptr]( size_type i ){ return float( ptr[i] ); }, function_tag{});
+    }
+  }
+
+  /** Store the floats of xs to ptr, at any alignment, as halves or
+   *  bfloat16 values rounded to nearest even */
+  template< typename H, size_type N, size_type Align, typename Inst >
+  void
+  narrow( Short_vector<float,N,Align,Inst> const& xs, H* ptr ){
+    static_assert( Conversion::is_narrow<H>, "Floats only narrow to halves and bfloat16 values" );
+    using Expressions::Access;
+
+    if constexpr( Conversion::by_register<Inst> ){
+      auto const& in = Access::storage( xs );
+      constexpr size_type lanes = N/size_type( std::tuple_size_v<std::decay_t<decltype(in)>> );
+      for( size_type k = 0; k < size_type( in.size()); ++k ){
+	Conversions<Inst>::narrow( in[k], ptr + k*lanes );
+      }
+    } else {
+      for( size_type i = 0; i < N; ++i ){
+	ptr[i] = H( xs[i] );
+      }
+    }
+  }
+
+  namespace Conversion
+  {
+    /** The short vectors of halves and bfloat16 values
+     *
+     * The values are held as a short vector of floats, the wide type,
+     * and only stored as halves or bfloat16 values: loads widen them
+     * and stores narrow them, rounding to nearest even, so the
+     * arithmetic between a load and a store rounds as for floats.  The
+     * arithmetic returns short vectors of halves again, so that kernels
+     * written for short vectors of floats run unchanged on arrays of
+     * half the size.
+     */
+    template< typename H, size_type N, size_type Align, typename Inst >
+    class Narrow_vector
+    {
+    public:
+
+      using value_type = H;
+      using vector_type = Short_vector<H,N,Align,Inst>;
+      using wide_type = Short_vector<float,N,Align,Inst>;
+      using mask_type = typename wide_type::mask_type;
+
+      static constexpr size_type extent = N;
+      static constexpr size_type alignment = Align;
+
+      static_assert( is_narrow<H>, "Only halves and bfloat16 values are narrow" );
+
+      Narrow_vector( value_type input ) : values( float( input ))
+      {}
+
+      Narrow_vector( float input ) : values( input )
+      {}
+
+      Narrow_vector( wide_type const& input ) : values( input )
+      {}
+
+      template< typename F >
+      Narrow_vector( F&& f, function_tag ) : values( [&f]( size_type i ){ return float( f( i )); }, function_tag{} )
+      {}
+
+      /** Load the values of the mask, as for short vectors of floats */
+      Narrow_vector( value_type const* ptr, mask_type const& m )
+	: values( [ptr,&m]( size_type i ){ return m[i] ? float( ptr[i] ) : 0.0f; }, function_tag{} )
+      {}
+
+      explicit
+      operator wide_type() const { return values; }
+
+      /** The values as floats */
+      wide_type const&
+      wide() const { return values; }
+
+      vector_type&
+      operator +=( vector_type const& input ){
+	values += input.values;
+	return self();
+      }
+
+      vector_type&
+      operator -=( vector_type const& input ){
+	values -= input.values;
+	return self();
+      }
+
+      vector_type&
+      operator *=( vector_type const& input ){
+	values *= input.values;
+	return self();
+      }
+
+      vector_type&
+      operator /=( vector_type const& input ){
+	values /= input.values;
+	return self();
+      }
+
+      /** The value i, widened; the values cannot be written one by one */
+      float
+      operator []( size_type i ) const {
+	return values[i];
+      }
+
+      static constexpr size_type
+      size() { return extent; }
+
+      /** The values at an address aligned to Align */
+      static vector_type
+      load( value_type const* ptr ){
+	assert( std::uintptr_t( ptr ) % std::uintptr_t( Align ) == 0 );
+	return vector_type( widen<wide_type>( ptr ));
+      }
+
+      /** The values at an address of any alignment */
+      static vector_type
+      load( unaligned<value_type> const& u ){
+	return vector_type( widen<wide_type>( u.ptr ));
+      }
+
+      /** Store the values to an address aligned to Align */
+      void
+      store( value_type* ptr ) const {
+	assert( std::uintptr_t( ptr ) % std::uintptr_t( Align ) == 0 );
+	narrow( values, ptr );
+      }
+
+      void
+      store( unaligned<value_type> const& u ) const {
+	narrow( values, u.ptr );
+      }
+
+      /** Store the values to an address aligned to Align
+       *
+       * The narrowed values are stored through the caches, as there is
+       * no streaming store of them.
+       */
+      void
+      store( stream<value_type> const& s ) const {
+	store( s.ptr );
+      }
+
+      /** Store the values of the mask to an address of any alignment */
+      void
+      store( value_type* ptr, mask_type const& m ) const {
+	for( size_type i = 0; i < N; ++i ){
+	  if( m[i] ) ptr[i] = value_type( values[i] );
+	}
+      }
+
+      template< size_type ... I >
+      static vector_type
+      shuffle( vector_type const& xs ){
+	return vector_type( wide_type::template shuffle<I...>( xs.values ));
+      }
+
+      template< size_type ... I >
+      static vector_type
+      shuffle( vector_type const& xs, vector_type const& ys ){
+	return vector_type( wide_type::template shuffle<I...>( xs.values, ys.values ));
+      }
+
+    private:
+
+      vector_type&
+      self(){ return static_cast<vector_type&>( *this ); }
+
+      // The scalars are templates, so that halves and floats match them
+      // exactly rather than converting to short vectors
+
+      friend vector_type
+      operator +( vector_type const& xs, vector_type const& ys ){ return xs.values + ys.values; }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator +( vector_type const& xs, S y ){ return xs.values + float( y ); }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator +( S x, vector_type const& ys ){ return float( x ) + ys.values; }
+
+      friend vector_type
+      operator -( vector_type const& xs, vector_type const& ys ){ return xs.values - ys.values; }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator -( vector_type const& xs, S y ){ return xs.values - float( y ); }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator -( S x, vector_type const& ys ){ return float( x ) - ys.values; }
+
+      friend vector_type
+      operator *( vector_type const& xs, vector_type const& ys ){ return xs.values * ys.values; }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator *( vector_type const& xs, S y ){ return xs.values * float( y ); }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator *( S x, vector_type const& ys ){ return float( x ) * ys.values; }
+
+      friend vector_type
+      operator /( vector_type const& xs, vector_type const& ys ){ return xs.values / ys.values; }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator /( vector_type const& xs, S y ){ return xs.values / float( y ); }
+
+      template< typename S, typename = enable_if_t<is_convertible_v<S,float>>>
+      friend vector_type
+      operator /( S x, vector_type const& ys ){ return float( x ) / ys.values; }
+
+      friend mask_type
+      operator <( vector_type const& xs, vector_type const& ys ){ return xs.values < ys.values; }
+
+      friend mask_type
+      operator <=( vector_type const& xs, vector_type const& ys ){ return xs.values <= ys.values; }
+
+      friend mask_type
+      operator >( vector_type const& xs, vector_type const& ys ){ return xs.values > ys.values; }
+
+      friend mask_type
+      operator >=( vector_type const& xs, vector_type const& ys ){ return xs.values >= ys.values; }
+
+      friend mask_type
+      operator ==( vector_type const& xs, vector_type const& ys ){ return xs.values == ys.values; }
+
+      friend mask_type
+      operator !=( vector_type const& xs, vector_type const& ys ){ return xs.values != ys.values; }
+
+      friend vector_type
+      fma( vector_type const& as, vector_type const& bs, vector_type const& cs ){
+	return fma( as.values, bs.values, cs.values );
+      }
+
+      friend vector_type
+      fms( vector_type const& as, vector_type const& bs, vector_type const& cs ){
+	return fms( as.values, bs.values, cs.values );
+      }
+
+      friend vector_type
+      fnma( vector_type const& as, vector_type const& bs, vector_type const& cs ){
+	return fnma( as.values, bs.values, cs.values );
+      }
+
+      friend vector_type
+      fnms( vector_type const& as, vector_type const& bs, vector_type const& cs ){
+	return fnms( as.values, bs.values, cs.values );
+      }
+
+      friend vector_type
+      cond( mask_type const& test, vector_type const& pass, vector_type const& fail ){
+	return cond( test, pass.values, fail.values );
+      }
+
+      friend float
+      hsum( vector_type const& xs ){ return hsum( xs.values ); }
+
+      friend float
+      hprod( vector_type const& xs ){ return hprod( xs.values ); }
+
+      friend float
+      hmin( vector_type const& xs ){ return hmin( xs.values ); }
+
+      friend float
+      hmax( vector_type const& xs ){ return hmax( xs.values ); }
+
+      friend float
+      dot( vector_type const& xs, vector_type const& ys ){ return dot( xs.values, ys.values ); }
+
+      friend size_type
+      argmin( vector_type const& xs ){ return argmin( xs.values ); }
+
+      friend size_type
+      argmax( vector_type const& xs ){ return argmax( xs.values ); }
+
+      friend vector_type
+      floor( vector_type const& xs ){ return floor( xs.values ); }
+
+      friend vector_type
+      ceil( vector_type const& xs ){ return ceil( xs.values ); }
+
+      friend vector_type
+      round( vector_type const& xs ){ return round( xs.values ); }
+
+      friend vector_type
+      abs( vector_type const& xs ){ return abs( xs.values ); }
+
+      friend vector_type
+      sqrt( vector_type const& xs ){ return sqrt( xs.values ); }
+
+      friend vector_type
+      min( vector_type const& xs, vector_type const& ys ){ return min( xs.values, ys.values ); }
+
+      friend vector_type
+      max( vector_type const& xs, vector_type const& ys ){ return max( xs.values, ys.values ); }
+
+      friend vector_type
+      add( mask_type const& m, vector_type const& xs, vector_type const& ys ){
+	return add( m, xs.values, ys.values );
+      }
+
+      friend vector_type
+      subtract( mask_type const& m, vector_type const& xs, vector_type const& ys ){
+	return subtract( m, xs.values, ys.values );
+      }
+
+      friend vector_type
+      multiply( mask_type const& m, vector_type const& xs, vector_type const& ys ){
+	return multiply( m, xs.values, ys.values );
+      }
+
+      friend vector_type
+      divide( mask_type const& m, vector_type const& xs, vector_type const& ys ){
+	return divide( m, xs.values, ys.values );
+      }
+
+      wide_type values;
+
+    }; // end of class Narrow_vector
+
+  } // end of namespace Conversion
+
+  template< size_type N, size_type Align, typename Inst >
+  class alignas(Align) Short_vector<half,N,Align,Inst> : public Conversion::Narrow_vector<half,N,Align,Inst>
+  {
+  public:
+    using Conversion::Narrow_vector<half,N,Align,Inst>::Narrow_vector;
+  }; // end of class Short_vector
+
+  template< size_type N, size_type Align, typename Inst >
+  class alignas(Align) Short_vector<bfloat16,N,Align,Inst> : public Conversion::Narrow_vector<bfloat16,N,Align,Inst>
+  {
+  public:
+    using Conversion::Narrow_vector<bfloat16,N,Align,Inst>::Narrow_vector;
+  }; // end of class Short_vector
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined CONVERT_HPP_INCLUDED_8164402957731186250
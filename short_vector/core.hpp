@@ -5,6 +5,7 @@
 // ... Short Vector header files
 //
 #include <short_vector/import.hpp>
+#include <short_vector/utility.hpp>
 
 namespace ShortVector::Private
 {
@@ -26,12 +27,424 @@ namespace ShortVector::Private
 
   
   
-  /** A tag indicating automatic vectorization */
-  struct auto_tag{};
-
   /** a tag indicating a function */
   struct function_tag{};
 
+  /** a tag indicating the underlying storage */
+  struct storage_tag{};
+
+  namespace Expressions
+  {
+    struct Access;
+  } // end of namespace Expressions
+
+
+  /** Calls to the friends of the register types
+   *
+   * Within the members of Short_vector the names of these functions
+   * refer to the members themselves, which hides the friends of the
+   * register types from argument dependent lookup.  The friends,
+   * being exact matches and not templates, are always preferred to
+   * the templates here.
+   */
+  namespace Adl
+  {
+    template< typename R >
+    R
+    fma( R const& a, R const& b, R const& c ){
+      return fma( a, b, c );
+    }
+
+    template< typename R >
+    R
+    fms( R const& a, R const& b, R const& c ){
+      return fms( a, b, c );
+    }
+
+    template< typename R >
+    R
+    fnma( R const& a, R const& b, R const& c ){
+      return fnma( a, b, c );
+    }
+
+    template< typename R >
+    R
+    fnms( R const& a, R const& b, R const& c ){
+      return fnms( a, b, c );
+    }
+
+    template< typename R >
+    R
+    fmaddsub( R const& a, R const& b, R const& c ){
+      return fmaddsub( a, b, c );
+    }
+
+    template< typename M, typename R >
+    R
+    cond( M const& test, R const& pass, R const& fail ){
+      return cond( test, pass, fail );
+    }
+
+    template< typename R >
+    R
+    floor( R const& a ){
+      return floor( a );
+    }
+
+    template< typename R >
+    R
+    ceil( R const& a ){
+      return ceil( a );
+    }
+
+    template< typename R >
+    R
+    round( R const& a ){
+      return round( a );
+    }
+
+    template< typename R >
+    R
+    abs( R const& a ){
+      return abs( a );
+    }
+
+    template< typename R >
+    R
+    sqrt( R const& a ){
+      return sqrt( a );
+    }
+
+    template< typename R >
+    R
+    rsqrt( R const& a ){
+      return rsqrt( a );
+    }
+
+    template< typename R >
+    R
+    rcp( R const& a ){
+      return rcp( a );
+    }
+
+    template< typename R >
+    R
+    min( R const& a, R const& b ){
+      return min( a, b );
+    }
+
+    template< typename R >
+    R
+    max( R const& a, R const& b ){
+      return max( a, b );
+    }
+
+    template< typename R >
+    R
+    frexp( R const& a, R& e ){
+      return frexp( a, e );
+    }
+
+    template< typename R >
+    R
+    ldexp( R const& a, R const& e ){
+      return ldexp( a, e );
+    }
+
+    template< typename R >
+    typename R::value_type
+    hsum( R const& a ){
+      return hsum( a );
+    }
+
+    template< typename R >
+    typename R::value_type
+    hprod( R const& a ){
+      return hprod( a );
+    }
+
+    template< typename R >
+    typename R::value_type
+    hmin( R const& a ){
+      return hmin( a );
+    }
+
+    template< typename R >
+    typename R::value_type
+    hmax( R const& a ){
+      return hmax( a );
+    }
+
+  } // end of namespace Adl
+
+
+  /** The bits of the binary floating point type T
+   *
+   * The exponent manipulations of the register types, one value at a
+   * time, for automatic vectorization.
+   */
+  template< typename T >
+  struct Binary
+  {
+    static_assert( std::numeric_limits<T>::is_iec559 && ( sizeof(T) == 4 || sizeof(T) == 8 ),
+		   "a binary32 or binary64 floating point type" );
+
+    using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+    static constexpr int digits = std::numeric_limits<T>::digits - 1;
+    static constexpr int bias = std::numeric_limits<T>::max_exponent - 1;
+    static constexpr bits_type exponent_bits = bits_type( 2*bias + 1 ) << digits;
+
+    /** The significand of x in [0.5,1), storing its exponent in e,
+     *  for normal finite x */
+    static T
+    frexp( T x, T& e ){
+      bits_type bits;
+      std::memcpy( &bits, &x, sizeof(bits) );
+      e = T( int(( bits & exponent_bits ) >> digits ) - ( bias - 1 ));
+      bits = ( bits & ~exponent_bits ) | ( bits_type( bias - 1 ) << digits );
+      std::memcpy( &x, &bits, sizeof(bits) );
+      return x;
+    }
+
+    /** x times 2 to the power e, for integral e, applied in two halves */
+    static T
+    ldexp( T x, T e ){
+      int n = int( e );
+      return x*power( n/2 )*power( n - n/2 );
+    }
+
+  private:
+
+    static T
+    power( int n ){
+      bits_type bits = bits_type( n + bias ) << digits;
+      T result;
+      std::memcpy( &result, &bits, sizeof(bits) );
+      return result;
+    }
+
+  }; // end of struct Binary
+
+
+  /** The storage of N values of type T for the instructions indicated by Inst
+   *
+   * Automatic vectorization stores the values in an array, while
+   * explicit vectorization stores them in an array of the registers
+   * of the instruction set.  The results of comparisons are stored
+   * likewise, as bools or as the masks of the registers.
+   */
+  template< typename T, size_type N, typename Inst >
+  struct Storage
+  {
+    using register_type = typename Register<T,Inst>::type;
+
+    static_assert( N % register_type::extent == 0,
+		   "The extent must be a multiple of the register extent" );
+
+    static constexpr size_type extent = N/register_type::extent;
+
+    using type = array<register_type,extent>;
+
+    using mask_type = array<typename register_type::mask_type,extent>;
+  }; // end of struct Storage
+
+  template< typename T, size_type N >
+  struct Storage<T,N,auto_tag>
+  {
+    static constexpr size_type extent = N;
+
+    using type = array<T,extent>;
+
+    using mask_type = array<bool,extent>;
+  }; // end of struct Storage
+
+
+  /** The result of comparing short vectors of N values of type T
+   *
+   * Each value of the mask tells whether the comparison holds for
+   * the values at the same index.  With explicit vectorization the
+   * mask keeps the native masks of the registers, so that selecting
+   * with cond is a blend rather than arithmetic on 1 and 0.
+   */
+  template< typename T, size_type N, typename Inst = auto_tag >
+  class Short_mask
+  {
+  public:
+
+    using value_type = bool;
+    using storage_type = typename Storage<T,N,Inst>::mask_type;
+
+    static constexpr size_type extent = N;
+
+    explicit constexpr
+    Short_mask( bool input ) : values( broadcast( input ))
+    {}
+
+    constexpr
+    Short_mask( storage_type input, storage_tag ) : values( input )
+    {}
+
+    constexpr bool
+    operator []( size_type i ) const {
+      if constexpr ( is_automatic ){
+	return values[i];
+      }
+      else {
+	return values[ i/lanes ][ i%lanes ];
+      }
+    }
+
+    static constexpr size_type
+    size() { return extent; }
+
+    constexpr storage_type const&
+    storage() const { return values; }
+
+    /** The mask of the first n values */
+    static constexpr Short_mask
+    first( size_type n ){
+      storage_type result{};
+      for( size_type i = 0; i < storage_extent; ++i ){
+	if constexpr ( is_automatic ){
+	  result[i] = i < n;
+	}
+	else {
+	  result[i] = storage_type::value_type::first( n - i*lanes );
+	}
+      }
+      return Short_mask( result, storage_tag{} );
+    }
+
+    friend constexpr Short_mask
+    operator &( Short_mask const& a, Short_mask const& b ){
+      Short_mask result( a );
+      for( size_type i = 0; i < storage_extent; ++i ){
+	result.values[i] = a.values[i] & b.values[i];
+      }
+      return result;
+    }
+
+    friend constexpr Short_mask
+    operator |( Short_mask const& a, Short_mask const& b ){
+      Short_mask result( a );
+      for( size_type i = 0; i < storage_extent; ++i ){
+	result.values[i] = a.values[i] | b.values[i];
+      }
+      return result;
+    }
+
+    friend constexpr Short_mask
+    operator ^( Short_mask const& a, Short_mask const& b ){
+      Short_mask result( a );
+      for( size_type i = 0; i < storage_extent; ++i ){
+	result.values[i] = a.values[i] ^ b.values[i];
+      }
+      return result;
+    }
+
+    friend constexpr Short_mask
+    operator ~( Short_mask const& a ){
+      Short_mask result( a );
+      for( size_type i = 0; i < storage_extent; ++i ){
+	if constexpr ( is_automatic ){
+	  result.values[i] = ! a.values[i];
+	}
+	else {
+	  result.values[i] = ~a.values[i];
+	}
+      }
+      return result;
+    }
+
+    /** True if the comparison holds for any value */
+    friend constexpr bool
+    any( Short_mask const& a ){
+      for( auto const& x : a.values ){
+	if constexpr ( is_automatic ){
+	  if( x ) return true;
+	}
+	else {
+	  if( any( x )) return true;
+	}
+      }
+      return false;
+    }
+
+    /** True if the comparison holds for every value */
+    friend constexpr bool
+    all( Short_mask const& a ){
+      for( auto const& x : a.values ){
+	if constexpr ( is_automatic ){
+	  if( ! x ) return false;
+	}
+	else {
+	  if( ! all( x )) return false;
+	}
+      }
+      return true;
+    }
+
+    /** True if the comparison holds for no value */
+    friend constexpr bool
+    none( Short_mask const& a ){
+      return ! any( a );
+    }
+
+    /** The index of the first value for which the comparison holds, or
+     *  extent if there is none */
+    friend constexpr size_type
+    find_first( Short_mask const& a ){
+      for( size_type i = 0; i < storage_extent; ++i ){
+	if constexpr ( is_automatic ){
+	  if( a.values[i] ) return i;
+	}
+	else {
+	  size_type j = find_first( a.values[i] );
+	  if( j < lanes ) return i*lanes + j;
+	}
+      }
+      return extent;
+    }
+
+    /** The number of values for which the comparison holds */
+    friend constexpr size_type
+    popcount( Short_mask const& a ){
+      size_type result = 0;
+      for( auto const& x : a.values ){
+	if constexpr ( is_automatic ){
+	  result += x;
+	}
+	else {
+	  result += popcount( x );
+	}
+      }
+      return result;
+    }
+
+  private:
+
+    static constexpr bool is_automatic = is_same_v<Inst,auto_tag>;
+
+    static constexpr size_type storage_extent = Storage<T,N,Inst>::extent;
+
+    static constexpr size_type lanes = N/storage_extent;
+
+    static constexpr storage_type
+    broadcast( bool input ){
+      storage_type result{};
+      for( auto& x : result ){
+	x = typename storage_type::value_type( input );
+      }
+      return result;
+    }
+
+    storage_type values;
+
+  }; // end of class Short_mask
+
+
+  
   template< typename T, size_type N, size_type Align, typename Inst = auto_tag >
   class alignas(Align) Short_vector
   {
@@ -40,6 +453,8 @@ namespace ShortVector::Private
     using value_type = T;
     using reference = value_type&;
     using const_reference = value_type const&;
+    using storage_type = typename Storage<T,N,Inst>::type;
+    using mask_type = Short_mask<T,N,Inst>;
     
     static constexpr size_type extent = N;
     static constexpr size_type alignment = Align;
@@ -49,24 +464,29 @@ namespace ShortVector::Private
 
 
     constexpr
-    Short_vector(value_type input) : values{}{
-      for(auto& x : values){
-	x = input;
-      } 
-    }
+    Short_vector(value_type input) : values(core_type::broadcast(input))
+    {}
 
-    template< typename T1, typename T2, typename ... Ts >
+    template< typename T1, typename T2, typename ... Ts,
+	      typename = enable_if_t<is_convertible_v<T1,value_type> && is_convertible_v<T2,value_type>
+				     && ( is_convertible_v<Ts,value_type> && ... )>>
     constexpr
-    Short_vector(T1&& x1, T2&& x2, Ts&& ... xs) : values{{forward<T1>(x1), forward<T2>(x2), forward<Ts>(xs) ... }}
+    Short_vector(T1&& x1, T2&& x2, Ts&& ... xs)
+      : values(core_type::make(forward<T1>(x1), forward<T2>(x2), forward<Ts>(xs) ... ))
     {}
 
     template<typename F>
     constexpr
-      Short_vector(F&& f, function_tag ) : values{} {
-      for(size_t i = 0; i < extent; ++i){
-	values[ i ] = f(i);
-      }	
-    }
+      Short_vector(F&& f, function_tag ) : values(core_type::generate(forward<F>(f)))
+    {}
+
+    /** Load the values of the mask from an address of any alignment
+     *
+     * The other values are zero and their addresses are not read, so
+     * that the mask of the first values loads the tail of an array.
+     */
+    Short_vector(value_type const* ptr, mask_type const& m) : values(core_type::load(ptr, m))
+    {}
 
     Short_vector&
     operator =( value_type input ){
@@ -86,7 +506,7 @@ namespace ShortVector::Private
 
     Short_vector&
     operator +=( Short_vector const&  input ){
-      for(size_type i = 0; i < extent; ++ i){
+      for(size_type i = 0; i < storage_extent; ++ i){
 	values[i] += input.values[i];
       }
       return *this;
@@ -102,7 +522,7 @@ namespace ShortVector::Private
 
     Short_vector&
     operator -=( Short_vector const&  input ){
-      for(size_type i = 0; i < extent; ++ i){
+      for(size_type i = 0; i < storage_extent; ++ i){
 	values[i] -= input.values[i];
       }
       return *this;
@@ -118,7 +538,7 @@ namespace ShortVector::Private
 
     Short_vector&
     operator *=( Short_vector const&  input ){
-      for(size_type i = 0; i < extent; ++ i){
+      for(size_type i = 0; i < storage_extent; ++ i){
 	values[i] *= input.values[i];
       }
       return *this;
@@ -134,7 +554,7 @@ namespace ShortVector::Private
 
     Short_vector&
     operator /=( Short_vector const&  input ){
-      for(size_type i = 0; i < extent; ++ i){
+      for(size_type i = 0; i < storage_extent; ++ i){
 	values[i] /= input.values[i];
       }
       return *this;
@@ -142,220 +562,1082 @@ namespace ShortVector::Private
     
     constexpr const_reference
     operator []( size_type i ) const& {
-      return values[i];
+      return core_type::get(values, i);
     }
 
     reference
     operator []( size_type i ) & {
-      return values[i];
+      return core_type::get(values, i);
     }
     
     static constexpr size_type
     size() { return extent; }
 
-  private:
+    /** The values at an address aligned to Align */
+    static Short_vector
+    load( value_type const* ptr ){
+      return Short_vector( core_type::load(ptr), storage_tag{} );
+    }
+
+    /** The values at an address of any alignment */
+    static Short_vector
+    load( unaligned<value_type> const& u ){
+      return Short_vector( core_type::load(u), storage_tag{} );
+    }
+
+    /** Store the values to an address aligned to Align */
+    void
+    store( value_type* ptr ) const {
+      core_type::store(values, ptr);
+    }
+
+    void
+    store( unaligned<value_type> const& u ) const {
+      core_type::store(values, u);
+    }
+
+    /** Store the values to an address aligned to Align, bypassing the
+     *  caches where the instruction set allows */
+    void
+    store( stream<value_type> const& s ) const {
+      core_type::store(values, s);
+    }
+
+    /** Store the values of the mask to an address of any alignment
+     *
+     * The addresses of the other values are neither read nor written.
+     */
+    void
+    store( value_type* ptr, mask_type const& m ) const {
+      core_type::store(values, ptr, m);
+    }
+
+    /** The values base[indices[k]], for indices in any order
+     *
+     * The explicit vectorizations take the indices as signed integers
+     * of the width of the values, which the gathers of the register
+     * types read directly.
+     */
+    template< typename I >
+    static Short_vector
+    gather( value_type const* base, Short_vector<I,N,Align,Inst> const& indices ){
+      static_assert( is_integral_v<I>, "The indices must be integers" );
+      return Short_vector( core_type::gather(base, indices), storage_tag{} );
+    }
+
+    /** Gather the values of the mask
+     *
+     * The other values are zero and their addresses are not read.
+     */
+    template< typename I >
+    static Short_vector
+    gather( value_type const* base, Short_vector<I,N,Align,Inst> const& indices, mask_type const& m ){
+      static_assert( is_integral_v<I>, "The indices must be integers" );
+      return Short_vector( core_type::gather(base, indices, m), storage_tag{} );
+    }
+
+    /** Store the values to base[indices[k]]
+     *
+     * Where indices repeat, the last of their values is stored.
+     */
+    template< typename I >
+    void
+    scatter( value_type* base, Short_vector<I,N,Align,Inst> const& indices ) const {
+      static_assert( is_integral_v<I>, "The indices must be integers" );
+      core_type::scatter(values, base, indices);
+    }
+
+    /** Scatter the values of the mask
+     *
+     * The addresses of the other values are neither read nor written.
+     */
+    template< typename I >
+    void
+    scatter( value_type* base, Short_vector<I,N,Align,Inst> const& indices, mask_type const& m ) const {
+      static_assert( is_integral_v<I>, "The indices must be integers" );
+      core_type::scatter(values, base, indices, m);
+    }
+
+    /** The vector whose value k is the value I_k of xs */
+    template< size_type ... I >
+    static constexpr Short_vector
+    shuffle( Short_vector const& xs ){
+      static_assert( sizeof...(I) == extent, "one index per value" );
+      static_assert((( I < extent ) && ... ), "index out of range" );
+      return core_type::template shuffle<I...>(xs, xs);
+    }
+
+    /** The vector whose value k is the value I_k of xs followed by ys */
+    template< size_type ... I >
+    static constexpr Short_vector
+    shuffle( Short_vector const& xs, Short_vector const& ys ){
+      static_assert( sizeof...(I) == extent, "one index per value" );
+      static_assert((( I < 2*extent ) && ... ), "index out of range" );
+      return core_type::template shuffle<I...>(xs, ys);
+    }
+
+  private:
+
+    static constexpr size_type storage_extent = Storage<T,N,Inst>::extent;
+
+    constexpr
+    Short_vector(storage_type input, storage_tag) : values(input)
+    {}
+
+    /** The gathers and scatters read the registers of their indices */
+    template< typename T_, size_type N_, size_type Align_, typename Inst_ >
+    friend class Short_vector;
+
+    /** Lazy expressions evaluate one register at a time */
+    friend struct Expressions::Access;
+
+    
+    template< typename Inst_, typename Indices >
+    struct Core;
+
+
+    /** Operations with automatic vectorization */
+    template<size_type ... Indices>
+    struct Core<auto_tag,integer_sequence<size_type,Indices...>>
+    {
+      static constexpr storage_type
+      broadcast( value_type x ){
+	return storage_type{{ ((void)Indices, x) ... }};
+      }
+
+      template< typename ... Ts >
+      static constexpr storage_type
+      make( Ts&& ... xs ){
+	return storage_type{{ forward<Ts>(xs) ... }};
+      }
+
+      template< typename F >
+      static constexpr storage_type
+      generate( F&& f ){
+	storage_type result{};
+	for(size_type i = 0; i < extent; ++i){
+	  result[ i ] = f(i);
+	}
+	return result;
+      }
+
+      static constexpr const_reference
+      get( storage_type const& xs, size_type i ){
+	return xs[i];
+      }
+
+      static constexpr reference
+      get( storage_type& xs, size_type i ){
+	return xs[i];
+      }
+
+      static constexpr mask_type
+      test( typename mask_type::storage_type const& ms ){
+	return mask_type( ms, storage_tag{} );
+      }
+
+      static constexpr storage_type
+      load( value_type const* ptr ){
+	return storage_type{{ ptr[Indices] ... }};
+      }
+
+      static constexpr storage_type
+      load( unaligned<value_type> const& u ){
+	return storage_type{{ u.ptr[Indices] ... }};
+      }
+
+      static constexpr storage_type
+      load( value_type const* ptr, mask_type const& m ){
+	return storage_type{{ ( m[Indices] ? ptr[Indices] : zero ) ... }};
+      }
+
+      static void
+      store( storage_type const& xs, value_type* ptr ){
+	(( void( ptr[Indices] = xs[Indices] )), ... );
+      }
+
+      static void
+      store( storage_type const& xs, unaligned<value_type> const& u ){
+	store( xs, u.ptr );
+      }
+
+      static void
+      store( storage_type const& xs, stream<value_type> const& s ){
+	store( xs, s.ptr );
+      }
+
+      static void
+      store( storage_type const& xs, value_type* ptr, mask_type const& m ){
+	(( m[Indices] ? void( ptr[Indices] = xs[Indices] ) : void()), ... );
+      }
+
+      template< typename I >
+      static constexpr storage_type
+      gather( value_type const* base, Short_vector<I,N,Align,auto_tag> const& indices ){
+	return storage_type{{ base[ indices[Indices] ] ... }};
+      }
+
+      template< typename I >
+      static constexpr storage_type
+      gather( value_type const* base, Short_vector<I,N,Align,auto_tag> const& indices, mask_type const& m ){
+	return storage_type{{ ( m[Indices] ? base[ indices[Indices] ] : zero ) ... }};
+      }
+
+      template< typename I >
+      static void
+      scatter( storage_type const& xs, value_type* base, Short_vector<I,N,Align,auto_tag> const& indices ){
+	(( void( base[ indices[Indices] ] = xs[Indices] )), ... );
+      }
+
+      template< typename I >
+      static void
+      scatter( storage_type const& xs, value_type* base, Short_vector<I,N,Align,auto_tag> const& indices,
+	       mask_type const& m ){
+	(( m[Indices] ? void( base[ indices[Indices] ] = xs[Indices] ) : void()), ... );
+      }
+
+      static constexpr Short_vector
+      add( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{xs[Indices]+ys[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      add( Short_vector const& xs, value_type y ){
+	return Short_vector{xs[Indices]+y ... };
+      }
+
+      static constexpr Short_vector
+      add( value_type x, Short_vector const& ys ){
+	return Short_vector{x+ys[Indices] ... };
+      }
+
+
+      static constexpr Short_vector
+      subtract( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{xs[Indices]-ys[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      subtract( Short_vector const& xs, value_type y ){
+	return Short_vector{xs[Indices]-y ... };
+      }
+
+      static constexpr Short_vector
+      subtract( value_type x, Short_vector const& ys ){
+	return Short_vector{x-ys[Indices] ... };
+      }
+
+
+      static constexpr Short_vector
+      multiply( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{xs[Indices]*ys[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      multiply( Short_vector const& xs, value_type y ){
+	return Short_vector{xs[Indices]*y ... };
+      }
+
+      static constexpr Short_vector
+      multiply( value_type x, Short_vector const& ys ){
+	return Short_vector{x*ys[Indices] ... };
+      }
+
+
+      static constexpr Short_vector
+      divide( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{xs[Indices]/ys[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      divide( Short_vector const& xs, value_type y ){
+	return Short_vector{xs[Indices]/y ... };
+      }
+
+      static constexpr Short_vector
+      divide( value_type x, Short_vector const& ys ){
+	return Short_vector{x/ys[Indices] ... };
+      }
+
+
+      static constexpr mask_type
+      eq( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] == y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      eq( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] == y ...}});
+      }
+
+      static constexpr mask_type
+      eq( value_type x, Short_vector const& y ){
+	return test({{ x == y[Indices] ...}});
+      }
+
+      
+
+      static constexpr mask_type
+      neq( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] != y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      neq( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] != y ...}});
+      }
+
+      static constexpr mask_type
+      neq( value_type x, Short_vector const& y ){
+	return test({{ x != y[Indices] ...}});
+      }
+
+
+      static constexpr mask_type
+      lt( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] < y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      lt( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] < y ...}});
+      }
+
+      static constexpr mask_type
+      lt( value_type x, Short_vector const& y ){
+	return test({{ x < y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      le( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] <= y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      le( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] <= y ...}});
+      }
+
+      static constexpr mask_type
+      le( value_type x, Short_vector const& y ){
+	return test({{ x <= y[Indices] ...}});
+      }
+
+
+      static constexpr mask_type
+      gt( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] > y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      gt( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] > y ...}});
+      }
+
+      static constexpr mask_type
+      gt( value_type x, Short_vector const& y ){
+	return test({{ x > y[Indices] ...}});
+      }
+
+
+      static constexpr mask_type
+      ge( Short_vector const& x, Short_vector const& y ){
+	return test({{ x[Indices] >= y[Indices] ...}});
+      }
+
+      static constexpr mask_type
+      ge( Short_vector const& x, value_type y )
+      {
+	return test({{ x[Indices] >= y ...}});
+      }
+
+      static constexpr mask_type
+      ge( value_type x, Short_vector const& y ){
+	return test({{ x >= y[Indices] ...}});
+      }
+
+
+      static constexpr Short_vector
+      fma( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	using Scalar::fma;
+	return Short_vector{ fma( a[Indices], b[Indices], c[Indices]) ... };
+      }
+
+      static constexpr Short_vector
+      fms( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	using Scalar::fma;
+	return Short_vector{ fma(a[Indices],b[Indices],-c[Indices]) ... };
+      }
+
+      static constexpr Short_vector
+      fnma( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	using Scalar::fma;
+	return Short_vector{ fma(-a[Indices],b[Indices],c[Indices]) ... };
+      }
+
+      static constexpr Short_vector
+      fnms( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	using Scalar::fma;
+	return Short_vector{ fma(-a[Indices],b[Indices],-c[Indices]) ... };
+      }
+
+      static constexpr Short_vector
+      fmaddsub( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	using Scalar::fma;
+	return Short_vector{ fma(a[Indices],b[Indices],Indices % 2 ? c[Indices] : -c[Indices]) ... };
+      }
+
+      static constexpr Short_vector
+      cond( mask_type const& test, Short_vector const& pass, Short_vector const& fail ){
+	return Short_vector{ test[Indices] ? pass[Indices] : fail[Indices] ... };
+      }
+
+      static constexpr value_type
+      hsum( Short_vector const& xs ){
+	return ( xs[Indices] + ... );
+      }
+
+      static constexpr value_type
+      hprod( Short_vector const& xs ){
+	return ( xs[Indices] * ... );
+      }
+
+      static constexpr value_type
+      hmin( Short_vector const& xs ){
+	value_type result = xs[0];
+	for( size_type i = 1; i < extent; ++i ){
+	  result = xs[i] < result ? xs[i] : result;
+	}
+	return result;
+      }
+
+      static constexpr value_type
+      hmax( Short_vector const& xs ){
+	value_type result = xs[0];
+	for( size_type i = 1; i < extent; ++i ){
+	  result = result < xs[i] ? xs[i] : result;
+	}
+	return result;
+      }
+
+      static constexpr Short_vector
+      add( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ m[Indices] ? xs[Indices]+ys[Indices] : xs[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      subtract( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ m[Indices] ? xs[Indices]-ys[Indices] : xs[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      multiply( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ m[Indices] ? xs[Indices]*ys[Indices] : xs[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      divide( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ m[Indices] ? xs[Indices]/ys[Indices] : xs[Indices] ... };
+      }
+
+      template< size_type ... I >
+      static constexpr Short_vector
+      shuffle( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ ( I < extent ? xs[I] : ys[I - extent] ) ... };
+      }
+
+      static Short_vector
+      floor( Short_vector const& xs ){
+	return Short_vector{ Scalar::floor( xs[Indices] ) ... };
+      }
+
+      static Short_vector
+      ceil( Short_vector const& xs ){
+	return Short_vector{ Scalar::ceil( xs[Indices] ) ... };
+      }
+
+      /** Rounded to the nearest integer, ties to even as the registers */
+      static Short_vector
+      round( Short_vector const& xs ){
+	return Short_vector{ Scalar::nearbyint( xs[Indices] ) ... };
+      }
+
+      static Short_vector
+      abs( Short_vector const& xs ){
+	return Short_vector{ Scalar::abs( xs[Indices] ) ... };
+      }
+
+      static Short_vector
+      sqrt( Short_vector const& xs ){
+	return Short_vector{ Scalar::sqrt( xs[Indices] ) ... };
+      }
+
+      static Short_vector
+      rsqrt( Short_vector const& xs ){
+	return Short_vector{ value_type( 1 )/Scalar::sqrt( xs[Indices] ) ... };
+      }
+
+      static Short_vector
+      rcp( Short_vector const& xs ){
+	return Short_vector{ value_type( 1 )/xs[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      min( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ xs[Indices] < ys[Indices] ? xs[Indices] : ys[Indices] ... };
+      }
+
+      static constexpr Short_vector
+      max( Short_vector const& xs, Short_vector const& ys ){
+	return Short_vector{ xs[Indices] > ys[Indices] ? xs[Indices] : ys[Indices] ... };
+      }
+
+      static Short_vector
+      frexp( Short_vector const& xs, Short_vector& es ){
+	return Short_vector{ Binary<value_type>::frexp( xs[Indices], es[Indices] ) ... };
+      }
+
+      static Short_vector
+      ldexp( Short_vector const& xs, Short_vector const& es ){
+	return Short_vector{ Binary<value_type>::ldexp( xs[Indices], es[Indices] ) ... };
+      }
+ 
+    }; // end of class Core
+
+
+    /** Operations with explicit vectorization
+     *
+     * The values are held in the registers of the instruction set
+     * and every operation is forwarded to the register type, one
+     * register at a time.
+     */
+    template< typename Inst_, size_type ... Indices >
+    struct Core<Inst_,integer_sequence<size_type,Indices...>>
+    {
+      using register_type = typename Register<value_type,Inst_>::type;
+
+      static constexpr size_type lanes = register_type::extent;
+
+      static Short_vector
+      apply( storage_type const& xs ){
+	return Short_vector( xs, storage_tag{} );
+      }
+
+      static storage_type
+      broadcast( value_type x ){
+	return storage_type{{ ((void)Indices, register_type(x)) ... }};
+      }
+
+      static storage_type
+      load( value_type const* ptr ){
+	return storage_type{{ register_type(ptr + Indices*lanes) ... }};
+      }
+
+      template< typename ... Ts >
+      static storage_type
+      make( Ts&& ... xs ){
+	alignas(register_type) value_type buffer[ extent ] = { value_type(forward<Ts>(xs)) ... };
+	return load( buffer );
+      }
+
+      template< typename F >
+      static storage_type
+      generate( F&& f ){
+	alignas(register_type) value_type buffer[ extent ];
+	for(size_type i = 0; i < extent; ++i){
+	  buffer[ i ] = f(i);
+	}
+	return load( buffer );
+      }
+
+      static const_reference
+      get( storage_type const& xs, size_type i ){
+	return reinterpret_cast<value_type const*>( xs.data())[ i ];
+      }
+
+      static reference
+      get( storage_type& xs, size_type i ){
+	return reinterpret_cast<value_type*>( xs.data())[ i ];
+      }
+
+      static mask_type
+      test( typename mask_type::storage_type const& ms ){
+	return mask_type( ms, storage_tag{} );
+      }
+
+      static storage_type
+      load( unaligned<value_type> const& u ){
+	return storage_type{{ register_type( unaligned<value_type>{ u.ptr + Indices*lanes } ) ... }};
+      }
+
+      // GCC cannot tell that the registers past the end of an array
+      // have empty masks, and warns of the addresses it then assumes
+#if defined(__GNUC__) && ! defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+      /** Register k of a masked load, zero where its mask is empty
+       *  without forming its address, which may be past the array */
+      static register_type
+      load( value_type const* ptr, mask_type const& m, size_type k ){
+	if( none( m.storage()[k] )) return register_type( value_type( 0 ));
+	return register_type( ptr + k*lanes, m.storage()[k] );
+      }
+
+      static storage_type
+      load( value_type const* ptr, mask_type const& m ){
+	return storage_type{{ load( ptr, m, Indices ) ... }};
+      }
+
+      static void
+      store( storage_type const& xs, value_type* ptr ){
+	( xs[Indices].store( ptr + Indices*lanes ), ... );
+      }
+
+      static void
+      store( storage_type const& xs, unaligned<value_type> const& u ){
+	( xs[Indices].store( unaligned<value_type>{ u.ptr + Indices*lanes } ), ... );
+      }
+
+      static void
+      store( storage_type const& xs, stream<value_type> const& s ){
+	( xs[Indices].store( stream<value_type>{ s.ptr + Indices*lanes } ), ... );
+      }
+
+      /** Store register k of a masked store, unless its mask is empty */
+      static void
+      store( register_type const& x, value_type* ptr, mask_type const& m, size_type k ){
+	if( ! none( m.storage()[k] )) x.store( ptr + k*lanes, m.storage()[k] );
+      }
+
+#if defined(__GNUC__) && ! defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+      static void
+      store( storage_type const& xs, value_type* ptr, mask_type const& m ){
+	( store( xs[Indices], ptr, m, Indices ), ... );
+      }
+
+      /** The indices are held in registers of as many lanes as the
+       *  values, index register k addressing value register k */
+      template< typename I >
+      static storage_type
+      gather( value_type const* base, Short_vector<I,N,Align,Inst_> const& indices ){
+	static_assert( Short_vector<I,N,Align,Inst_>::storage_extent == storage_extent,
+		       "The indices must be as wide as the values" );
+	return storage_type{{ register_type::gather( base, indices.values[Indices] ) ... }};
+      }
 
-    
-    template< typename Indices >
-    struct Core;
+      template< typename I >
+      static storage_type
+      gather( value_type const* base, Short_vector<I,N,Align,Inst_> const& indices, mask_type const& m ){
+	static_assert( Short_vector<I,N,Align,Inst_>::storage_extent == storage_extent,
+		       "The indices must be as wide as the values" );
+	return storage_type{{ register_type::gather( base, indices.values[Indices], m.storage()[Indices] ) ... }};
+      }
 
+      template< typename I >
+      static void
+      scatter( storage_type const& xs, value_type* base, Short_vector<I,N,Align,Inst_> const& indices ){
+	static_assert( Short_vector<I,N,Align,Inst_>::storage_extent == storage_extent,
+		       "The indices must be as wide as the values" );
+	( xs[Indices].scatter( base, indices.values[Indices] ), ... );
+      }
 
-    template<size_type ... Indices>
-    struct Core<integer_sequence<size_type,Indices...>>
-    {
-      static constexpr Short_vector
+      template< typename I >
+      static void
+      scatter( storage_type const& xs, value_type* base, Short_vector<I,N,Align,Inst_> const& indices,
+	       mask_type const& m ){
+	static_assert( Short_vector<I,N,Align,Inst_>::storage_extent == storage_extent,
+		       "The indices must be as wide as the values" );
+	( xs[Indices].scatter( base, indices.values[Indices], m.storage()[Indices] ), ... );
+      }
+
+
+      static Short_vector
       add( Short_vector const& xs, Short_vector const& ys ){
-	return Short_vector{xs[Indices]+ys[Indices] ... };
+	return apply({{ xs.values[Indices]+ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       add( Short_vector const& xs, value_type y ){
-	return Short_vector{xs[Indices]+y ... };
+	return apply({{ xs.values[Indices]+register_type(y) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       add( value_type x, Short_vector const& ys ){
-	return Short_vector{x+ys[Indices] ... };
+	return apply({{ register_type(x)+ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
+      static Short_vector
       subtract( Short_vector const& xs, Short_vector const& ys ){
-	return Short_vector{xs[Indices]-ys[Indices] ... };
+	return apply({{ xs.values[Indices]-ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       subtract( Short_vector const& xs, value_type y ){
-	return Short_vector{xs[Indices]-y ... };
+	return apply({{ xs.values[Indices]-register_type(y) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       subtract( value_type x, Short_vector const& ys ){
-	return Short_vector{x-ys[Indices] ... };
+	return apply({{ register_type(x)-ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
+      static Short_vector
       multiply( Short_vector const& xs, Short_vector const& ys ){
-	return Short_vector{xs[Indices]*ys[Indices] ... };
+	return apply({{ xs.values[Indices]*ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       multiply( Short_vector const& xs, value_type y ){
-	return Short_vector{xs[Indices]*y ... };
+	return apply({{ xs.values[Indices]*register_type(y) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       multiply( value_type x, Short_vector const& ys ){
-	return Short_vector{x*ys[Indices] ... };
+	return apply({{ register_type(x)*ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
+      static Short_vector
       divide( Short_vector const& xs, Short_vector const& ys ){
-	return Short_vector{xs[Indices]/ys[Indices] ... };
+	return apply({{ xs.values[Indices]/ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       divide( Short_vector const& xs, value_type y ){
-	return Short_vector{xs[Indices]/y ... };
+	return apply({{ xs.values[Indices]/register_type(y) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       divide( value_type x, Short_vector const& ys ){
-	return Short_vector{x/ys[Indices] ... };
+	return apply({{ register_type(x)/ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
-      eq( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] == y[Indices] ? one : zero ...};
+      static mask_type
+      eq( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] == ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      eq( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] == y ? one : zero ...};
+      static mask_type
+      eq( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] == register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      eq( value_type x, Short_vector const& y ){
-	return Short_vector{ x == y[Indices] ? one : zero ...};
+      static mask_type
+      eq( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) == ys.values[Indices] ... }});
       }
 
-      
 
-      static constexpr Short_vector
-      neq( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] != y[Indices] ? one : zero ...};
+      static mask_type
+      neq( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] != ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      neq( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] != y ? one : zero ...};
+      static mask_type
+      neq( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] != register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      neq( value_type x, Short_vector const& y ){
-	return Short_vector{ x != y[Indices] ? one : zero ...};
+      static mask_type
+      neq( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) != ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
-      lt( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] < y[Indices] ? one : zero ...};
+      static mask_type
+      lt( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] < ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      lt( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] < y ? one : zero ...};
+      static mask_type
+      lt( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] < register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      lt( value_type x, Short_vector const& y ){
-	return Short_vector{ x < y[Indices] ? one : zero ...};
+      static mask_type
+      lt( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) < ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      le( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] <= y[Indices] ? one : zero ...};
+
+      static mask_type
+      le( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] <= ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      le( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] <= y ? one : zero ...};
+      static mask_type
+      le( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] <= register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      le( value_type x, Short_vector const& y ){
-	return Short_vector{ x <= y[Indices] ? one : zero ...};
+      static mask_type
+      le( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) <= ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
-      gt( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] > y[Indices] ? one : zero ...};
+      static mask_type
+      gt( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] > ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      gt( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] > y ? one : zero ...};
+      static mask_type
+      gt( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] > register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      gt( value_type x, Short_vector const& y ){
-	return Short_vector{ x > y[Indices] ? one : zero ...};
+      static mask_type
+      gt( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) > ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
-      ge( Short_vector const& x, Short_vector const& y ){
-	return Short_vector{ x[Indices] >= y[Indices] ? one : zero ...};
+      static mask_type
+      ge( Short_vector const& xs, Short_vector const& ys ){
+	return test({{ xs.values[Indices] >= ys.values[Indices] ... }});
       }
 
-      static constexpr Short_vector
-      ge( Short_vector const& x, value_type y )
-      {
-	return Short_vector{ x[Indices] >= y ? one : zero ...};
+      static mask_type
+      ge( Short_vector const& xs, value_type y ){
+	return test({{ xs.values[Indices] >= register_type(y) ... }});
       }
 
-      static constexpr Short_vector
-      ge( value_type x, Short_vector const& y ){
-	return Short_vector{ x >= y[Indices] ? one : zero ...};
+      static mask_type
+      ge( value_type x, Short_vector const& ys ){
+	return test({{ register_type(x) >= ys.values[Indices] ... }});
       }
 
 
-      static constexpr Short_vector
+      static Short_vector
       fma( Short_vector const& a, Short_vector const& b, Short_vector const& c){
-	using std::fma;
-	return Short_vector{ fma( a[Indices], b[Indices], c[Indices]) ... };
+	return apply({{ Adl::fma(a.values[Indices], b.values[Indices], c.values[Indices]) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       fms( Short_vector const& a, Short_vector const& b, Short_vector const& c){
-	using std::fma;
-	return Short_vector{ fma(a[Indices],b[Indices],-c[Indices]) ... };
+	return apply({{ Adl::fms(a.values[Indices], b.values[Indices], c.values[Indices]) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       fnma( Short_vector const& a, Short_vector const& b, Short_vector const& c){
-	using std::fma;
-	return Short_vector{ fma(-a[Indices],b[Indices],c[Indices]) ... };
+	return apply({{ Adl::fnma(a.values[Indices], b.values[Indices], c.values[Indices]) ... }});
       }
 
-      static constexpr Short_vector
+      static Short_vector
       fnms( Short_vector const& a, Short_vector const& b, Short_vector const& c){
-	using std::fma;
-	return Short_vector{ fma(-a[Indices],b[Indices],-c[Indices]) ... };
+	return apply({{ Adl::fnms(a.values[Indices], b.values[Indices], c.values[Indices]) ... }});
       }
- 
+
+      static Short_vector
+      fmaddsub( Short_vector const& a, Short_vector const& b, Short_vector const& c){
+	return apply({{ Adl::fmaddsub(a.values[Indices], b.values[Indices], c.values[Indices]) ... }});
+      }
+
+      static Short_vector
+      cond( mask_type const& test, Short_vector const& pass, Short_vector const& fail ){
+	return apply({{ Adl::cond(test.storage()[Indices], pass.values[Indices], fail.values[Indices]) ... }});
+      }
+
+      /** The registers are combined lane by lane before the single
+       *  horizontal reduction of the last register */
+      static value_type
+      hsum( Short_vector const& xs ){
+	return Adl::hsum(( xs.values[Indices] + ... ));
+      }
+
+      static value_type
+      hprod( Short_vector const& xs ){
+	return Adl::hprod(( xs.values[Indices] * ... ));
+      }
+
+      static value_type
+      hmin( Short_vector const& xs ){
+	register_type result = xs.values[0];
+	for( size_type i = 1; i < storage_extent; ++i ){
+	  result = Adl::min( result, xs.values[i] );
+	}
+	return Adl::hmin( result );
+      }
+
+      static value_type
+      hmax( Short_vector const& xs ){
+	register_type result = xs.values[0];
+	for( size_type i = 1; i < storage_extent; ++i ){
+	  result = Adl::max( result, xs.values[i] );
+	}
+	return Adl::hmax( result );
+      }
+
+      static Short_vector
+      add( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::cond(m.storage()[Indices], xs.values[Indices]+ys.values[Indices], xs.values[Indices]) ... }});
+      }
+
+      static Short_vector
+      subtract( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::cond(m.storage()[Indices], xs.values[Indices]-ys.values[Indices], xs.values[Indices]) ... }});
+      }
+
+      static Short_vector
+      multiply( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::cond(m.storage()[Indices], xs.values[Indices]*ys.values[Indices], xs.values[Indices]) ... }});
+      }
+
+      static Short_vector
+      divide( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::cond(m.storage()[Indices], xs.values[Indices]/ys.values[Indices], xs.values[Indices]) ... }});
+      }
+
+      static Short_vector
+      floor( Short_vector const& xs ){
+	return apply({{ Adl::floor( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      ceil( Short_vector const& xs ){
+	return apply({{ Adl::ceil( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      round( Short_vector const& xs ){
+	return apply({{ Adl::round( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      abs( Short_vector const& xs ){
+	return apply({{ Adl::abs( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      sqrt( Short_vector const& xs ){
+	return apply({{ Adl::sqrt( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      rsqrt( Short_vector const& xs ){
+	return apply({{ Adl::rsqrt( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      rcp( Short_vector const& xs ){
+	return apply({{ Adl::rcp( xs.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      min( Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::min( xs.values[Indices], ys.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      max( Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ Adl::max( xs.values[Indices], ys.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      frexp( Short_vector const& xs, Short_vector& es ){
+	return apply({{ Adl::frexp( xs.values[Indices], es.values[Indices] ) ... }});
+      }
+
+      static Short_vector
+      ldexp( Short_vector const& xs, Short_vector const& es ){
+	return apply({{ Adl::ldexp( xs.values[Indices], es.values[Indices] ) ... }});
+      }
+
+      /** Each register of the result is a single shuffle of the one or
+       *  two registers its values come from, and is otherwise gathered
+       *  one value at a time */
+      template< size_type ... I >
+      static Short_vector
+      shuffle( Short_vector const& xs, Short_vector const& ys ){
+	return apply({{ shuffle_register<Indices,I...>( xs, ys, typename Generate_indices<lanes>::type{} ) ... }});
+      }
+
+      /** The registers read by each register of a shuffle, numbering
+       *  the registers of ys after those of xs */
+      template< size_type ... I >
+      struct Plan
+      {
+	static constexpr array<size_type,sizeof...(I)> index{{ I ... }};
+
+	static constexpr size_type
+	first( size_type k ){
+	  size_type result = index[k*lanes]/lanes;
+	  for( size_type l = 1; l < lanes; ++l ){
+	    result = index[k*lanes + l]/lanes < result ? index[k*lanes + l]/lanes : result;
+	  }
+	  return result;
+	}
+
+	static constexpr size_type
+	last( size_type k ){
+	  size_type result = index[k*lanes]/lanes;
+	  for( size_type l = 1; l < lanes; ++l ){
+	    result = index[k*lanes + l]/lanes > result ? index[k*lanes + l]/lanes : result;
+	  }
+	  return result;
+	}
+
+	/** True if register k reads no register but its first and last */
+	static constexpr bool
+	paired( size_type k ){
+	  for( size_type l = 0; l < lanes; ++l ){
+	    size_type j = index[k*lanes + l]/lanes;
+	    if( j != first(k) && j != last(k) ) return false;
+	  }
+	  return true;
+	}
+
+	/** The lane index of value l of register k in the shuffle of its
+	 *  first and last registers */
+	static constexpr size_type
+	lane( size_type k, size_type l ){
+	  size_type i = index[k*lanes + l];
+	  return i/lanes == first(k) ? i%lanes : lanes + i%lanes;
+	}
+      }; // end of struct Plan
+
+      static register_type const&
+      source( Short_vector const& xs, Short_vector const& ys, size_type j ){
+	return j < storage_extent ? xs.values[j] : ys.values[j - storage_extent];
+      }
+
+      template< size_type K, size_type ... I, size_type ... L >
+      static register_type
+      shuffle_register( Short_vector const& xs, Short_vector const& ys, integer_sequence<size_type,L...> ){
+	using plan = Plan<I...>;
+	if constexpr ( plan::first(K) == plan::last(K) ){
+	  return register_type::template shuffle<( plan::index[K*lanes + L]%lanes ) ...>(
+	    source( xs, ys, plan::first(K)));
+	}
+	else if constexpr ( plan::paired(K) ){
+	  return register_type::template shuffle<plan::lane(K,L) ...>(
+	    source( xs, ys, plan::first(K)), source( xs, ys, plan::last(K)));
+	}
+	else {
+	  alignas(register_type) value_type buffer[ lanes ] = {
+	    ( plan::index[K*lanes + L] < extent
+	      ? get( xs.values, plan::index[K*lanes + L] )
+	      : get( ys.values, plan::index[K*lanes + L] - extent )) ... };
+	  return register_type( buffer );
+	}
+      }
+      
     }; // end of class Core
 
-    using core_type = Core<typename Generate_indices<extent>::type>;
+    using core_type = Core<Inst,typename Generate_indices<storage_extent>::type>;
 
 
     friend constexpr Short_vector
@@ -422,93 +1704,93 @@ namespace ShortVector::Private
     }
 
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <( Short_vector const& xs, Short_vector const& ys ){
       return core_type::lt( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <( Short_vector const& xs, value_type y ){
       return core_type::lt( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <( value_type x, Short_vector const& ys ){
       return core_type::lt(x, ys);
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <=( Short_vector const& xs, Short_vector const& ys ){
       return core_type::le( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <=( Short_vector const& xs, value_type y ){
       return core_type::le( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator <=( value_type x, Short_vector const& ys ){
       return core_type::le(x, ys);
     }
 
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >( Short_vector const& xs, Short_vector const& ys ){
       return core_type::gt( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >( Short_vector const& xs, value_type y ){
       return core_type::gt( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >( value_type x, Short_vector const& ys ){
       return core_type::gt(x, ys);
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >=( Short_vector const& xs, Short_vector const& ys ){
       return core_type::ge( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >=( Short_vector const& xs, value_type y ){
       return core_type::ge( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator >=( value_type x, Short_vector const& ys ){
       return core_type::ge(x, ys);
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator ==( Short_vector const& xs, Short_vector const& ys ){
       return core_type::eq( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator ==( Short_vector const& xs, value_type y ){
       return core_type::eq( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator ==( value_type x, Short_vector const& ys ){
       return core_type::eq(x, ys);
     }
     
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator !=( Short_vector const& xs, Short_vector const& ys ){
       return core_type::neq( xs, ys );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator !=( Short_vector const& xs, value_type y ){
       return core_type::neq( xs, y );
     }
 
-    friend constexpr Short_vector
+    friend constexpr mask_type
     operator !=( value_type x, Short_vector const& ys ){
       return core_type::neq(x, ys);
     }
@@ -533,14 +1815,313 @@ namespace ShortVector::Private
     fnms( Short_vector const& as, Short_vector const& bs, Short_vector const& cs){
       return core_type::fnms(as, bs, cs);
     }
+
+    /** as*bs - cs at the even indices and as*bs + cs at the odd ones */
+    friend constexpr Short_vector
+    fmaddsub( Short_vector const& as, Short_vector const& bs, Short_vector const& cs){
+      return core_type::fmaddsub(as, bs, cs);
+    }
+
+    /** The values of pass where the test holds and of fail elsewhere */
+    friend constexpr Short_vector
+    cond( mask_type const& test, Short_vector const& pass, Short_vector const& fail ){
+      return core_type::cond(test, pass, fail);
+    }
+
+    friend constexpr value_type
+    hsum( Short_vector const& xs ){
+      return core_type::hsum(xs);
+    }
+
+    friend constexpr value_type
+    hprod( Short_vector const& xs ){
+      return core_type::hprod(xs);
+    }
+
+    friend constexpr value_type
+    hmin( Short_vector const& xs ){
+      return core_type::hmin(xs);
+    }
+
+    friend constexpr value_type
+    hmax( Short_vector const& xs ){
+      return core_type::hmax(xs);
+    }
+
+    friend constexpr value_type
+    dot( Short_vector const& xs, Short_vector const& ys ){
+      return core_type::hsum(xs*ys);
+    }
+
+    /** The index of the first smallest value */
+    friend constexpr size_type
+    argmin( Short_vector const& xs ){
+      return find_first(xs == core_type::hmin(xs));
+    }
+
+    /** The index of the first largest value */
+    friend constexpr size_type
+    argmax( Short_vector const& xs ){
+      return find_first(xs == core_type::hmax(xs));
+    }
+
+    friend Short_vector
+    floor( Short_vector const& xs ){
+      return core_type::floor(xs);
+    }
+
+    friend Short_vector
+    ceil( Short_vector const& xs ){
+      return core_type::ceil(xs);
+    }
+
+    /** The values rounded to the nearest integer, ties to even */
+    friend Short_vector
+    round( Short_vector const& xs ){
+      return core_type::round(xs);
+    }
+
+    friend Short_vector
+    abs( Short_vector const& xs ){
+      return core_type::abs(xs);
+    }
+
+    friend Short_vector
+    sqrt( Short_vector const& xs ){
+      return core_type::sqrt(xs);
+    }
+
+    /** Estimates of 1/sqrt( xs ), to the estimate precision of the
+     *  registers, and exact with automatic vectorization */
+    friend Short_vector
+    rsqrt( Short_vector const& xs ){
+      return core_type::rsqrt(xs);
+    }
+
+    /** Estimates of 1/xs, as rsqrt */
+    friend Short_vector
+    rcp( Short_vector const& xs ){
+      return core_type::rcp(xs);
+    }
+
+    friend constexpr Short_vector
+    min( Short_vector const& xs, Short_vector const& ys ){
+      return core_type::min(xs, ys);
+    }
+
+    friend constexpr Short_vector
+    max( Short_vector const& xs, Short_vector const& ys ){
+      return core_type::max(xs, ys);
+    }
+
+    /** The significands of xs in [0.5,1), storing their exponents in es
+     *
+     * As std::frexp for normal finite values; see the register types
+     * for the others.
+     */
+    friend Short_vector
+    frexp( Short_vector const& xs, Short_vector& es ){
+      return core_type::frexp(xs, es);
+    }
+
+    /** The values of xs times 2 to the power of the integral es */
+    friend Short_vector
+    ldexp( Short_vector const& xs, Short_vector const& es ){
+      return core_type::ldexp(xs, es);
+    }
+
+    /** The arithmetic on the values of the mask, keeping xs elsewhere */
+    friend constexpr Short_vector
+    add( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+      return core_type::add(m, xs, ys);
+    }
+
+    friend constexpr Short_vector
+    subtract( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+      return core_type::subtract(m, xs, ys);
+    }
+
+    friend constexpr Short_vector
+    multiply( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+      return core_type::multiply(m, xs, ys);
+    }
+
+    friend constexpr Short_vector
+    divide( mask_type const& m, Short_vector const& xs, Short_vector const& ys ){
+      return core_type::divide(m, xs, ys);
+    }
     
   private:
 
-    array<value_type,extent> values;
+    storage_type values;
 
   }; // end of class Short_vector
 
 
+  /** The values base[indices[k]] of a short vector like the indices */
+  template< typename T, typename I, size_type N, size_type Align, typename Inst >
+  Short_vector<T,N,Align,Inst>
+  gather( T const* base, Short_vector<I,N,Align,Inst> const& indices ){
+    return Short_vector<T,N,Align,Inst>::gather( base, indices );
+  }
+
+  /** The values base[indices[k]] of the mask, and zero elsewhere */
+  template< typename T, typename I, size_type N, size_type Align, typename Inst >
+  Short_vector<T,N,Align,Inst>
+  gather( T const* base, Short_vector<I,N,Align,Inst> const& indices,
+	  typename Short_vector<T,N,Align,Inst>::mask_type const& m ){
+    return Short_vector<T,N,Align,Inst>::gather( base, indices, m );
+  }
+
+  /** Store xs[k] to base[indices[k]], the last value winning where
+   *  indices repeat */
+  template< typename T, typename I, size_type N, size_type Align, typename Inst >
+  void
+  scatter( T* base, Short_vector<I,N,Align,Inst> const& indices, Short_vector<T,N,Align,Inst> const& xs ){
+    xs.scatter( base, indices );
+  }
+
+  /** Store the values of the mask only */
+  template< typename T, typename I, size_type N, size_type Align, typename Inst >
+  void
+  scatter( T* base, Short_vector<I,N,Align,Inst> const& indices, Short_vector<T,N,Align,Inst> const& xs,
+	   typename Short_vector<T,N,Align,Inst>::mask_type const& m ){
+    xs.scatter( base, indices, m );
+  }
+
+
+  /** Rearrange the lanes of a register or the values of a short vector
+   *
+   * Lane k of shuffle<I...>( a ) is lane I_k of a, and lane k of
+   * shuffle<I...>( a, b ) is lane I_k of a followed by b.  The indices
+   * are known at compile time, and each register type lowers them to
+   * the cheapest of its shuffle instructions.
+   */
+  template< size_type ... I, typename V >
+  constexpr V
+  shuffle( V const& a ){
+    return V::template shuffle<I...>( a );
+  }
+
+  template< size_type ... I, typename V >
+  constexpr V
+  shuffle( V const& a, V const& b ){
+    return V::template shuffle<I...>( a, b );
+  }
+
+  namespace Shuffles
+  {
+    template< size_type K, typename V, size_type ... I >
+    constexpr V
+    rotate( V const& a, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I + K )%V::extent ...>( a );
+    }
+
+    template< typename V, size_type ... I >
+    constexpr V
+    reverse( V const& a, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( V::extent - 1 - I ) ...>( a );
+    }
+
+    template< size_type L, typename V, size_type ... I >
+    constexpr V
+    broadcast( V const& a, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( 0*I + L ) ...>( a );
+    }
+
+    template< size_type Offset, typename V, size_type ... I >
+    constexpr V
+    interleave( V const& a, V const& b, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I%2*V::extent + Offset + I/2 ) ...>( a, b );
+    }
+
+    template< size_type K, typename V, size_type ... I >
+    constexpr V
+    shift_up( V const& a, V const& fill, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I < K ? V::extent + I : I - K ) ...>( a, fill );
+    }
+
+    /** Add to each lane the sums of the K lanes below it, then of the
+     *  2*K lanes below those, and so on */
+    template< size_type K, typename V >
+    constexpr V
+    inclusive_scan( V const& a ){
+      if constexpr ( K >= V::extent ){
+	return a;
+      } else {
+	V zero( typename V::value_type( 0 ));
+	return inclusive_scan<2*K>( a + shift_up<K>( a, zero, typename Generate_indices<V::extent>::type{} ));
+      }
+    }
+
+  } // end of namespace Shuffles
+
+  /** The lanes of a moved K lanes down, lane k of the result being
+   *  lane k + K of a, wrapping around */
+  template< size_type K, typename V >
+  constexpr V
+  rotate( V const& a ){
+    return Shuffles::rotate<K>( a, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** The lanes of a in reverse order */
+  template< typename V >
+  constexpr V
+  reverse( V const& a ){
+    return Shuffles::reverse( a, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** Every lane holding lane L of a */
+  template< size_type L, typename V >
+  constexpr V
+  broadcast( V const& a ){
+    static_assert( L < V::extent, "lane index out of range" );
+    return Shuffles::broadcast<L>( a, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** The first halves of a and b, alternating lane by lane */
+  template< typename V >
+  constexpr V
+  interleave_low( V const& a, V const& b ){
+    return Shuffles::interleave<0>( a, b, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** The second halves of a and b, alternating lane by lane */
+  template< typename V >
+  constexpr V
+  interleave_high( V const& a, V const& b ){
+    return Shuffles::interleave<V::extent/2>( a, b, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** The lanes of a moved K lanes up, lane k of the result being lane
+   *  k - K of a, and lane k of fill for k < K */
+  template< size_type K, typename V >
+  constexpr V
+  shift_up( V const& a, V const& fill ){
+    static_assert( K <= V::extent, "shift out of range" );
+    return Shuffles::shift_up<K>( a, fill, typename Generate_indices<V::extent>::type{} );
+  }
+
+  /** The sums of the lanes of a up to each lane, by log2 of the extent
+   *  shifts and additions
+   *
+   * Floating point sums are thus added in a tree, rather than from
+   * the first lane to the last.
+   */
+  template< typename V >
+  constexpr V
+  inclusive_scan( V const& a ){
+    return Shuffles::inclusive_scan<1>( a );
+  }
+
+  /** The sums of the lanes of a below each lane, the first lane zero */
+  template< typename V >
+  constexpr V
+  exclusive_scan( V const& a ){
+    return shift_up<1>( inclusive_scan( a ), V( typename V::value_type( 0 )));
+  }
+
+
   
   
  
@@ -548,9 +2129,14 @@ namespace ShortVector::Private
   /** A short vector as a view 
    *
    * This class describes an object that can refer to a contiguous
-   * sequence of values and allow their treatment as a short vector
+   * sequence of values and allow their treatment as a short vector.
+   * The policy tells how the values are loaded and stored: aligned
+   * views refer to values aligned to Align, unaligned views to values
+   * of any alignment, and stream views to aligned values that are
+   * stored bypassing the caches.
    */
-  template< typename T, size_type N, size_type Align, typename Inst = auto_tag >
+  template< typename T, size_type N, size_type Align, typename Inst = auto_tag,
+	    template< typename > class Policy = aligned >
   class Short_view
   {
   public:
@@ -562,6 +2148,10 @@ namespace ShortVector::Private
     static constexpr size_type extent = N;
     static constexpr size_type alignment = Align;
 
+    static_assert( is_same_v<Policy<T>,aligned<T>> || is_same_v<Policy<T>,unaligned<T>> ||
+		   is_same_v<Policy<T>,stream<T>>,
+		   "The policy must be aligned, unaligned or stream" );
+
     Short_view() = delete;
 
     Short_view( Short_view const& input )
@@ -570,70 +2160,59 @@ namespace ShortVector::Private
 
     Short_view( pointer input ) : ptr(input){
       assert(input);
+      assert(( is_same_v<Policy<T>,unaligned<T>> || std::uintptr_t( input ) % std::uintptr_t( Align ) == 0 ));
     }
 
 
 
     Short_view&
     operator =( Short_view const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] = input.ptr[i];	    
-      }
+      store( input.load());
       return *this;
     }
 
     Short_view&
     operator =( short_vector const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] = input[i];
-      }
+      store( input );
+      return *this;
     }
 
 
     Short_view&
     operator =( value_type input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] = input;
-      }
+      store( short_vector( input ));
+      return *this;
     }
 
     Short_view&
     operator +=( short_vector const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] += input[i];
-      }
+      store( load() + input );
+      return *this;
     }
 
 
     Short_view&
     operator -=( short_vector const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] -= input[i];
-      }
+      store( load() - input );
+      return *this;
     }
 
 
     Short_view&
     operator *=( short_vector const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] *= input[i];
-      }
+      store( load() * input );
+      return *this;
     }
 
     Short_view&
     operator /=( short_vector const& input ){
-      for( size_type i = 0; i < extent; ++i ){
-	ptr[i] /= input[i];
-      }
+      store( load() / input );
+      return *this;
     }
 
 
     operator short_vector() const& {
-      short_vector result;
-      for(size_type i = 0; i < extent; ++i){
-	result[i] = ptr[i];
-      }
-      return result;
+      return load();
     }
 
     friend short_vector
@@ -647,7 +2226,7 @@ namespace ShortVector::Private
     }
 
     friend short_vector
-    operator +( short_vector const& a, short_vector const& b ){
+    operator +( short_vector const& a, Short_view const& b ){
       return a+short_vector(b);
     }
 
@@ -675,7 +2254,7 @@ namespace ShortVector::Private
     }
 
     friend short_vector
-    operator -( short_vector const& a, short_vector const& b ){
+    operator -( short_vector const& a, Short_view const& b ){
       return a-short_vector(b);
     }
 
@@ -702,7 +2281,7 @@ namespace ShortVector::Private
     }
 
     friend short_vector
-    operator *( short_vector const& a, short_vector const& b ){
+    operator *( short_vector const& a, Short_view const& b ){
       return a*short_vector(b);
     }
 
@@ -730,7 +2309,7 @@ namespace ShortVector::Private
     }
 
     friend short_vector
-    operator /( short_vector const& a, short_vector const& b ){
+    operator /( short_vector const& a, Short_view const& b ){
       return a/short_vector(b);
     }
 
@@ -745,6 +2324,24 @@ namespace ShortVector::Private
     }
 
   private:
+    short_vector
+    load() const {
+      if constexpr( is_same_v<Policy<T>,unaligned<T>> ){
+	return short_vector::load( unaligned<value_type>{ ptr });
+      } else {
+	return short_vector::load( ptr );
+      }
+    }
+
+    void
+    store( short_vector const& xs ) const {
+      if constexpr( is_same_v<Policy<T>,aligned<T>> ){
+	xs.store( ptr );
+      } else {
+	xs.store( Policy<value_type>{ ptr });
+      }
+    }
+
     pointer ptr;
   };
 
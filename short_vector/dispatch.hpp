@@ -0,0 +1,257 @@
+#ifndef DISPATCH_HPP_INCLUDED_1906148526743119867
+#define DISPATCH_HPP_INCLUDED_1906148526743119867 1
+
+//
+// ... Standard header files
+//
+#include <cstdlib>
+#include <cstring>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Mark a kernel entry point
+ *
+ * Flattening the entry point inlines the calls it makes where the
+ * optimizer does.  It is not what keeps the variants apart: the
+ * library of each variant has names of its own, as SHORT_VECTOR_ISA
+ * declares it in an inline namespace (see import.hpp), so that its
+ * out-of-line functions are never those of another instruction set.
+ * Functions of the standard library that a kernel calls itself are
+ * still shared by the variants.
+ */
+#if defined(__GNUC__)
+#define SHORT_VECTOR_KERNEL __attribute__((flatten))
+#else
+#define SHORT_VECTOR_KERNEL
+#endif
+
+/** Declare the variants of a kernel
+ *
+ * Declares the function `name`, of the function type given by the
+ * remaining arguments, in the namespaces `ns::scalar`, `ns::sse`,
+ * `ns::avx2` and `ns::avx512`, where the kernel source compiled for
+ * each instruction set defines it.
+ */
+#define SHORT_VECTOR_DECLARE_KERNEL(ns, name, ...)				\
+  namespace ns::scalar { ShortVector::Private::Type<__VA_ARGS__>::type name; } \
+  namespace ns::sse { ShortVector::Private::Type<__VA_ARGS__>::type name; }	\
+  namespace ns::avx2 { ShortVector::Private::Type<__VA_ARGS__>::type name; }	\
+  namespace ns::avx512 { ShortVector::Private::Type<__VA_ARGS__>::type name; }
+
+#if defined(SHORT_VECTOR_DISPATCH_SSE)
+#define SHORT_VECTOR_KERNEL_SSE(ns, name) &ns::sse::name
+#else
+#define SHORT_VECTOR_KERNEL_SSE(ns, name) nullptr
+#endif
+
+#if defined(SHORT_VECTOR_DISPATCH_AVX2)
+#define SHORT_VECTOR_KERNEL_AVX2(ns, name) &ns::avx2::name
+#else
+#define SHORT_VECTOR_KERNEL_AVX2(ns, name) nullptr
+#endif
+
+#if defined(SHORT_VECTOR_DISPATCH_AVX512)
+#define SHORT_VECTOR_KERNEL_AVX512(ns, name) &ns::avx512::name
+#else
+#define SHORT_VECTOR_KERNEL_AVX512(ns, name) nullptr
+#endif
+
+/** The variants of a kernel that were built, narrowest first */
+#define SHORT_VECTOR_KERNELS(ns, name)		\
+  {{ &ns::scalar::name,				\
+     SHORT_VECTOR_KERNEL_SSE(ns, name),		\
+     SHORT_VECTOR_KERNEL_AVX2(ns, name),		\
+     SHORT_VECTOR_KERNEL_AVX512(ns, name) }}
+
+namespace ShortVector::Private
+{
+
+  /** The instruction sets among which kernels are dispatched, narrowest first */
+  enum class Isa : int
+  {
+    scalar = 0,
+    sse = 1,
+    avx2 = 2,
+    avx512 = 3
+  };
+
+  constexpr size_type isa_count = 4;
+
+
+  template< Isa I >
+  struct Isa_traits;
+
+  template<>
+  struct Isa_traits<Isa::scalar>
+  {
+    using inst_type = auto_tag;
+    static constexpr size_type register_size = 16;
+  };
+
+  template<>
+  struct Isa_traits<Isa::sse>
+  {
+    using inst_type = sse_tag;
+    static constexpr size_type register_size = 16;
+  };
+
+  template<>
+  struct Isa_traits<Isa::avx2>
+  {
+    using inst_type = avx_tag;
+    static constexpr size_type register_size = 32;
+  };
+
+  template<>
+  struct Isa_traits<Isa::avx512>
+  {
+    using inst_type = avx512_tag;
+    static constexpr size_type register_size = 64;
+  };
+
+
+  constexpr char const*
+  name( Isa isa ){
+    switch( isa ){
+    case Isa::scalar: return "scalar";
+    case Isa::sse: return "sse";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    }
+    return "unknown";
+  }
+
+  /** Return true if the host supports the instruction set */
+  inline bool
+  supported( Isa isa ){
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    switch( isa ){
+    case Isa::scalar:
+      return true;
+    case Isa::sse:
+      return __builtin_cpu_supports("sse4.1");
+    case Isa::avx2:
+      return __builtin_cpu_supports("avx2")
+	&& __builtin_cpu_supports("fma")
+	&& __builtin_cpu_supports("f16c");
+    case Isa::avx512:
+      return __builtin_cpu_supports("avx512f")
+	&& __builtin_cpu_supports("f16c")
+	&& __builtin_cpu_supports("avx512dq")
+	&& __builtin_cpu_supports("avx512bw")
+	&& __builtin_cpu_supports("avx512vl");
+    }
+    return false;
+#else
+    return isa == Isa::scalar;
+#endif
+  }
+
+  /** The widest instruction set supported by the host, probed once */
+  inline Isa
+  host_isa(){
+    static Isa const result = []{
+      Isa widest = Isa::scalar;
+      for( int i = 1; i < isa_count; ++i ){
+	if( supported( Isa(i))){
+	  widest = Isa(i);
+	}
+      }
+      return widest;
+    }();
+    return result;
+  }
+
+  /** The widest instruction set that may be dispatched to, read once
+   *
+   * This is the instruction set of the host, unless the environment
+   * variable SHORT_VECTOR_MAX_ISA names a narrower one.
+   */
+  inline Isa
+  max_isa(){
+    static Isa const result = []{
+      Isa limit = host_isa();
+      if( char const* requested = std::getenv( "SHORT_VECTOR_MAX_ISA" )){
+	for( int i = 0; i < isa_count; ++i ){
+	  if( std::strcmp( requested, name( Isa(i))) == 0 && Isa(i) < limit ){
+	    limit = Isa(i);
+	  }
+	}
+      }
+      return limit;
+    }();
+    return result;
+  }
+
+
+  /** A kernel compiled for several instruction sets
+   *
+   * The variant for the widest instruction set that was built and
+   * that may be dispatched to on the host is selected on construction,
+   * and every call is forwarded to it.
+   */
+  template< typename F >
+  class Dispatch
+  {
+  public:
+    using pointer = F*;
+    using table_type = array<pointer,isa_count>;
+
+    Dispatch( table_type const& input )
+      : kernels( input )
+      , chosen( select( input ))
+    {}
+
+    /** The instruction set of the selected variant */
+    Isa
+    isa() const { return chosen; }
+
+    /** The variant for an instruction set, or null if it was not built */
+    pointer
+    kernel( Isa i ) const { return kernels[ size_type(i) ]; }
+
+    template< typename ... Ts >
+    decltype(auto)
+    operator ()( Ts&& ... xs ) const {
+      return kernels[ size_type(chosen) ]( forward<Ts>(xs) ... );
+    }
+
+  private:
+
+    static Isa
+    select( table_type const& input ){
+      Isa result = Isa::scalar;
+      for( int i = 0; i <= int(max_isa()); ++i ){
+	if( input[ i ] ){
+	  result = Isa(i);
+	}
+      }
+      return result;
+    }
+
+    table_type kernels;
+    Isa chosen;
+
+  }; // end of class Dispatch
+
+
+#if defined(SHORT_VECTOR_ISA)
+
+  /** The instruction set of the kernel being compiled */
+  constexpr Isa kernel_isa = Isa::SHORT_VECTOR_ISA;
+
+  /** The instruction tag of the kernel being compiled */
+  using kernel_inst = typename Isa_traits<kernel_isa>::inst_type;
+
+  /** The register size in bytes of the kernel being compiled */
+  constexpr size_type kernel_register_size = Isa_traits<kernel_isa>::register_size;
+
+#endif // defined(SHORT_VECTOR_ISA)
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined DISPATCH_HPP_INCLUDED_1906148526743119867
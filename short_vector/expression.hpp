@@ -0,0 +1,338 @@
+#ifndef EXPRESSION_HPP_INCLUDED_5517962084431290367
+#define EXPRESSION_HPP_INCLUDED_5517962084431290367 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Lazy arithmetic on short vectors
+ *
+ * The arithmetic of Short_vector returns a new short vector from
+ * every operator, so that a*b + c*d - e builds its intermediate
+ * results in full, which for vectors of many registers means on the
+ * stack, and only forms fused multiply adds when the optimizer finds
+ * them.  Wrapping an operand in lazy() makes the operators on it build
+ * an expression instead, which is evaluated one register at a time, in
+ * a single pass, where it is converted to a short vector:
+ *
+ *   Short_vector<float,64,32,avx_tag> r = lazy( a )*b + lazy( c )*d - e;
+ *
+ * The operators apply from left to right as usual, so that a product
+ * of two short vectors is only lazy if one of them is.
+ *
+ * A product added to or subtracted from another operand becomes an
+ * fma, fms or fnma where the instruction set has them, as indicated by
+ * FP_FAST_FMA and FP_FAST_FMAF, with the rounding of fused multiply
+ * adds rather than that of the operators.  The operations are not
+ * reordered: r above is fma( a, b, c*d ) - e.
+ *
+ * Expressions refer to the short vectors they were built from, and
+ * hold copies of temporaries.
+ */
+namespace ShortVector::Private
+{
+
+  namespace Expressions
+  {
+    /** True where the products of values of type T are fused */
+    template< typename T >
+    constexpr bool fuses = false;
+
+#if defined(FP_FAST_FMAF)
+    template<>
+    constexpr bool fuses<float> = true;
+#endif
+
+#if defined(FP_FAST_FMA)
+    template<>
+    constexpr bool fuses<double> = true;
+#endif
+
+    /** The values or registers held by short vectors of type V */
+    template< typename V >
+    using Element = typename V::storage_type::value_type;
+
+    struct Access
+    {
+      template< typename V >
+      static constexpr typename V::storage_type const&
+      storage( V const& v ){
+	return v.values;
+      }
+
+      template< typename V >
+      static constexpr V
+      make( typename V::storage_type const& s ){
+	return V( s, storage_tag{} );
+      }
+    }; // end of struct Access
+
+
+    struct Add
+    {
+      template< typename E >
+      static constexpr E
+      apply( E const& a, E const& b ){ return a + b; }
+    }; // end of struct Add
+
+    struct Subtract
+    {
+      template< typename E >
+      static constexpr E
+      apply( E const& a, E const& b ){ return a - b; }
+    }; // end of struct Subtract
+
+    struct Multiply
+    {
+      template< typename E >
+      static constexpr E
+      apply( E const& a, E const& b ){ return a * b; }
+    }; // end of struct Multiply
+
+    struct Divide
+    {
+      template< typename E >
+      static constexpr E
+      apply( E const& a, E const& b ){ return a / b; }
+    }; // end of struct Divide
+
+    /** a*b + c */
+    struct Fma
+    {
+      template< typename E >
+      static E
+      apply( E const& a, E const& b, E const& c ){
+	if constexpr( std::is_arithmetic_v<E> ){
+	  return Scalar::fma( a, b, c );
+	} else {
+	  return Adl::fma( a, b, c );
+	}
+      }
+    }; // end of struct Fma
+
+    /** a*b - c */
+    struct Fms
+    {
+      template< typename E >
+      static E
+      apply( E const& a, E const& b, E const& c ){
+	if constexpr( std::is_arithmetic_v<E> ){
+	  return Scalar::fma( a, b, -c );
+	} else {
+	  return Adl::fms( a, b, c );
+	}
+      }
+    }; // end of struct Fms
+
+    /** c - a*b */
+    struct Fnma
+    {
+      template< typename E >
+      static E
+      apply( E const& a, E const& b, E const& c ){
+	if constexpr( std::is_arithmetic_v<E> ){
+	  return Scalar::fma( -a, b, c );
+	} else {
+	  return Adl::fnma( a, b, c );
+	}
+      }
+    }; // end of struct Fnma
+
+
+    template< typename E, size_type ... K >
+    constexpr typename E::vector_type
+    compute( E const& e, integer_sequence<size_type,K...> ){
+      using vector_type = typename E::vector_type;
+      return Access::make<vector_type>( typename vector_type::storage_type{{ e.element( K ) ... }} );
+    }
+
+    /** The short vector of an expression, one register at a time */
+    template< typename E >
+    constexpr typename E::vector_type
+    compute( E const& e ){
+      using storage_type = typename E::vector_type::storage_type;
+      return compute( e, typename Generate_indices<size_type( std::tuple_size_v<storage_type> )>::type{} );
+    }
+
+    /** The base of the expressions yielding short vectors of type V */
+    template< typename D, typename V >
+    struct Expression
+    {
+      using vector_type = V;
+      using expression_tag = void;
+
+      constexpr
+      operator vector_type() const {
+	return compute( static_cast<D const&>( *this ));
+      }
+    }; // end of struct Expression
+
+    /** A short vector, held by reference or, for temporaries, by value */
+    template< typename V, typename H = V const& >
+    struct Leaf : Expression<Leaf<V,H>,V>
+    {
+      constexpr explicit
+      Leaf( V const& input ) : v( input )
+      {}
+
+      constexpr Element<V>
+      element( size_type k ) const { return Access::storage( v )[k]; }
+
+      H v;
+    }; // end of struct Leaf
+
+    template< typename V >
+    struct Constant : Expression<Constant<V>,V>
+    {
+      constexpr explicit
+      Constant( typename V::value_type input ) : x( input )
+      {}
+
+      constexpr Element<V>
+      element( size_type ) const { return Element<V>( x ); }
+
+      typename V::value_type x;
+    }; // end of struct Constant
+
+    template< typename Op, typename L, typename R >
+    struct Binary : Expression<Binary<Op,L,R>,typename L::vector_type>
+    {
+      constexpr
+      Binary( L const& a, R const& b ) : l( a ), r( b )
+      {}
+
+      constexpr auto
+      element( size_type k ) const { return Op::apply( l.element( k ), r.element( k )); }
+
+      L l;
+      R r;
+    }; // end of struct Binary
+
+    template< typename Op, typename A, typename B, typename C >
+    struct Fused : Expression<Fused<Op,A,B,C>,typename A::vector_type>
+    {
+      constexpr
+      Fused( A const& x, B const& y, C const& z ) : a( x ), b( y ), c( z )
+      {}
+
+      auto
+      element( size_type k ) const { return Op::apply( a.element( k ), b.element( k ), c.element( k )); }
+
+      A a;
+      B b;
+      C c;
+    }; // end of struct Fused
+
+
+    template< typename X, typename = void >
+    constexpr bool is_expression = false;
+
+    template< typename X >
+    constexpr bool is_expression<X,typename X::expression_tag> = true;
+
+    template< typename X >
+    constexpr bool is_product = false;
+
+    template< typename L, typename R >
+    constexpr bool is_product<Binary<Multiply,L,R>> = true;
+
+    template< typename X >
+    using Bare = std::remove_cv_t<std::remove_reference_t<X>>;
+
+    /** The short vector type of an operation on L and R */
+    template< typename L, typename R >
+    using Vector = typename std::conditional_t<is_expression<Bare<L>>,Bare<L>,Bare<R>>::vector_type;
+
+    /** An operand as an expression yielding short vectors of type V */
+    template< typename V, typename X >
+    constexpr auto
+    operand( X&& x ){
+      if constexpr( is_expression<Bare<X>> ){
+	return Bare<X>( x );
+      } else if constexpr( is_same_v<Bare<X>,V> && std::is_lvalue_reference_v<X> ){
+	return Leaf<V>( x );
+      } else if constexpr( is_same_v<Bare<X>,V> ){
+	return Leaf<V,V>( x );
+      } else {
+	return Constant<V>( typename V::value_type( x ));
+      }
+    }
+
+    template< typename L, typename R >
+    using Enable = enable_if_t<( is_expression<Bare<L>> || is_expression<Bare<R>> )>;
+
+    /** A sum of a product and another operand is fused */
+    template< typename L, typename R, typename = Enable<L,R> >
+    constexpr auto
+    operator +( L&& l, R&& r ){
+      using V = Vector<L,R>;
+      auto a = operand<V>( forward<L>( l ));
+      auto b = operand<V>( forward<R>( r ));
+      if constexpr( fuses<typename V::value_type> && is_product<decltype(a)> ){
+	return Fused<Fma,decltype(a.l),decltype(a.r),decltype(b)>( a.l, a.r, b );
+      } else if constexpr( fuses<typename V::value_type> && is_product<decltype(b)> ){
+	return Fused<Fma,decltype(b.l),decltype(b.r),decltype(a)>( b.l, b.r, a );
+      } else {
+	return Binary<Add,decltype(a),decltype(b)>( a, b );
+      }
+    }
+
+    template< typename L, typename R, typename = Enable<L,R> >
+    constexpr auto
+    operator -( L&& l, R&& r ){
+      using V = Vector<L,R>;
+      auto a = operand<V>( forward<L>( l ));
+      auto b = operand<V>( forward<R>( r ));
+      if constexpr( fuses<typename V::value_type> && is_product<decltype(a)> ){
+	return Fused<Fms,decltype(a.l),decltype(a.r),decltype(b)>( a.l, a.r, b );
+      } else if constexpr( fuses<typename V::value_type> && is_product<decltype(b)> ){
+	return Fused<Fnma,decltype(b.l),decltype(b.r),decltype(a)>( b.l, b.r, a );
+      } else {
+	return Binary<Subtract,decltype(a),decltype(b)>( a, b );
+      }
+    }
+
+    template< typename L, typename R, typename = Enable<L,R> >
+    constexpr auto
+    operator *( L&& l, R&& r ){
+      using V = Vector<L,R>;
+      auto a = operand<V>( forward<L>( l ));
+      auto b = operand<V>( forward<R>( r ));
+      return Binary<Multiply,decltype(a),decltype(b)>( a, b );
+    }
+
+    template< typename L, typename R, typename = Enable<L,R> >
+    constexpr auto
+    operator /( L&& l, R&& r ){
+      using V = Vector<L,R>;
+      auto a = operand<V>( forward<L>( l ));
+      auto b = operand<V>( forward<R>( r ));
+      return Binary<Divide,decltype(a),decltype(b)>( a, b );
+    }
+
+  } // end of namespace Expressions
+
+  /** The short vector xs as an expression, making the operators on it lazy */
+  template< typename T, size_type N, size_type Align, typename Inst >
+  constexpr Expressions::Leaf<Short_vector<T,N,Align,Inst>>
+  lazy( Short_vector<T,N,Align,Inst> const& xs ){
+    return Expressions::Leaf<Short_vector<T,N,Align,Inst>>( xs );
+  }
+
+  template< typename T, size_type N, size_type Align, typename Inst >
+  constexpr Expressions::Leaf<Short_vector<T,N,Align,Inst>,Short_vector<T,N,Align,Inst>>
+  lazy( Short_vector<T,N,Align,Inst>&& xs ){
+    return Expressions::Leaf<Short_vector<T,N,Align,Inst>,Short_vector<T,N,Align,Inst>>( xs );
+  }
+
+  /** The short vector of an expression */
+  template< typename E, typename = enable_if_t<Expressions::is_expression<E>> >
+  constexpr typename E::vector_type
+  evaluate( E const& e ){
+    return Expressions::compute( e );
+  }
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined EXPRESSION_HPP_INCLUDED_5517962084431290367
@@ -0,0 +1,124 @@
+#ifndef HALF_HPP_INCLUDED_3380725591146020871
+#define HALF_HPP_INCLUDED_3380725591146020871 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/import.hpp>
+
+namespace ShortVector::Private
+{
+
+  namespace Halves
+  {
+    inline std::uint32_t
+    bits( float x ){
+      std::uint32_t result;
+      std::memcpy( &result, &x, sizeof(x) );
+      return result;
+    }
+
+    inline float
+    value( std::uint32_t x ){
+      float result;
+      std::memcpy( &result, &x, sizeof(x) );
+      return result;
+    }
+
+    /** The half nearest x, ties to even, as the F16C instructions round */
+    inline std::uint16_t
+    to_half( float x ){
+      constexpr std::uint32_t infinity = 255u << 23;
+      constexpr std::uint32_t overflow = ( 127u + 16u ) << 23;
+      constexpr std::uint32_t subnormal = 113u << 23;
+      constexpr std::uint32_t magic = (( 127u - 15u ) + ( 23u - 10u ) + 1u ) << 23;
+
+      std::uint32_t f = bits( x );
+      std::uint32_t sign = f & 0x80000000u;
+      f ^= sign;
+
+      std::uint32_t result;
+      if( f >= overflow ){
+	result = f > infinity ? 0x7e00u : 0x7c00u;
+      } else if( f < subnormal ){
+	// The addition rounds the subnormal into the low bits
+	result = bits( value( f ) + value( magic )) - magic;
+      } else {
+	std::uint32_t odd = ( f >> 13 ) & 1u;
+	f += (( 15u - 127u ) << 23 ) + 0xfffu + odd;
+	result = f >> 13;
+      }
+      return std::uint16_t( result | sign >> 16 );
+    }
+
+    inline float
+    from_half( std::uint16_t h ){
+      constexpr std::uint32_t magic = 113u << 23;
+      constexpr std::uint32_t exponent = 0x7c00u << 13;
+
+      std::uint32_t result = ( std::uint32_t( h ) & 0x7fffu ) << 13;
+      std::uint32_t e = result & exponent;
+      result += ( 127u - 15u ) << 23;
+      if( e == exponent ){
+	result += ( 128u - 16u ) << 23;
+      } else if( e == 0 ){
+	result = bits( value( result + ( 1u << 23 )) - value( magic ));
+      }
+      return value( result | ( std::uint32_t( h ) & 0x8000u ) << 16 );
+    }
+
+    /** The upper half of the bits of x, rounded to nearest even, with
+     *  NaNs kept quiet */
+    inline std::uint16_t
+    to_bfloat16( float x ){
+      std::uint32_t f = bits( x );
+      if( x != x ){
+	return std::uint16_t(( f >> 16 ) | 0x40u );
+      }
+      return std::uint16_t(( f + 0x7fffu + (( f >> 16 ) & 1u )) >> 16 );
+    }
+
+    inline float
+    from_bfloat16( std::uint16_t h ){
+      return value( std::uint32_t( h ) << 16 );
+    }
+
+  } // end of namespace Halves
+
+
+  /** A half precision value, IEEE binary16
+   *
+   * Halves only store values: they convert to and from float, which
+   * the arithmetic is done in.  Widening to float is exact and
+   * implicit, narrowing rounds and is explicit.
+   */
+  struct half
+  {
+    half() = default;
+
+    explicit
+    half( float x ) : bits( Halves::to_half( x ))
+    {}
+
+    operator float() const { return Halves::from_half( bits ); }
+
+    std::uint16_t bits;
+  }; // end of struct half
+
+  /** A brain floating point value: the upper half of a float */
+  struct bfloat16
+  {
+    bfloat16() = default;
+
+    explicit
+    bfloat16( float x ) : bits( Halves::to_bfloat16( x ))
+    {}
+
+    operator float() const { return Halves::from_bfloat16( bits ); }
+
+    std::uint16_t bits;
+  }; // end of struct bfloat16
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined HALF_HPP_INCLUDED_3380725591146020871
@@ -4,11 +4,38 @@
 //
 // ... Standard header files
 //
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <cmath>
+#include <limits>
 #include <utility>
 #include <array>
 #include <algorithm>
+#include <type_traits>
+
+/** Give the library of each kernel variant names of its own
+ *
+ * The sources compiled once per instruction set by
+ * short_vector_dispatch define SHORT_VECTOR_ISA, and every namespace of
+ * the library is then declared in an inline namespace named after it.
+ * The inline functions of the variants are thus distinct functions,
+ * whatever the optimization level, and the linker cannot take the copy
+ * of one instruction set for another.
+ */
+#if defined(SHORT_VECTOR_ISA)
+#define SHORT_VECTOR_PASTE_(a, b) a ## b
+#define SHORT_VECTOR_PASTE(a, b) SHORT_VECTOR_PASTE_(a, b)
+
+inline namespace SHORT_VECTOR_PASTE(short_vector_, SHORT_VECTOR_ISA)
+{
+  namespace ShortVector { namespace Private {} }
+  namespace SSE {}
+  namespace AVX {}
+  namespace AVX512 {}
+}
+#endif
 
 namespace ShortVector
 {
@@ -23,7 +50,78 @@ namespace ShortVector
 
   using std::fill;
 
-  using std::fma;
+  using std::is_same_v;
+  using std::is_convertible_v;
+  using std::is_integral_v;
+  using std::enable_if_t;
+
+  /** The functions of <cmath> that the library applies to values
+   *
+   * Where the inline overloads of <cmath> are not inlined, as at -O0,
+   * they are emitted as weak functions shared by every kernel variant,
+   * with the instructions of whichever variant the linker keeps.  These
+   * call the same builtins, but belong to the library, and so to the
+   * namespace of each variant.
+   */
+  namespace Scalar
+  {
+#if defined(__GNUC__)
+    constexpr float
+    fma( float a, float b, float c ){ return __builtin_fmaf( a, b, c ); }
+
+    constexpr double
+    fma( double a, double b, double c ){ return __builtin_fma( a, b, c ); }
+
+    constexpr long double
+    fma( long double a, long double b, long double c ){ return __builtin_fmal( a, b, c ); }
+
+    /** As std::fma of integers, in double */
+    template< typename T, typename = enable_if_t<is_integral_v<T>> >
+    constexpr double
+    fma( T a, T b, T c ){ return fma( double( a ), double( b ), double( c )); }
+
+    inline float
+    floor( float x ){ return __builtin_floorf( x ); }
+
+    inline double
+    floor( double x ){ return __builtin_floor( x ); }
+
+    inline float
+    ceil( float x ){ return __builtin_ceilf( x ); }
+
+    inline double
+    ceil( double x ){ return __builtin_ceil( x ); }
+
+    inline float
+    nearbyint( float x ){ return __builtin_nearbyintf( x ); }
+
+    inline double
+    nearbyint( double x ){ return __builtin_nearbyint( x ); }
+
+    inline float
+    sqrt( float x ){ return __builtin_sqrtf( x ); }
+
+    inline double
+    sqrt( double x ){ return __builtin_sqrt( x ); }
+
+    inline float
+    abs( float x ){ return __builtin_fabsf( x ); }
+
+    inline double
+    abs( double x ){ return __builtin_fabs( x ); }
+
+    template< typename T, typename = enable_if_t<is_integral_v<T>> >
+    constexpr T
+    abs( T x ){ return x < T( 0 ) ? T( -x ) : x; }
+#else
+    using std::fma;
+    using std::floor;
+    using std::ceil;
+    using std::nearbyint;
+    using std::sqrt;
+    using std::abs;
+#endif
+  } // end of namespace Scalar
   
 } // end of namespace ShortVector
 
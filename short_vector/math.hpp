@@ -0,0 +1,643 @@
+#ifndef MATH_HPP_INCLUDED_3342598177460135207
+#define MATH_HPP_INCLUDED_3342598177460135207 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Elementary functions of vectors of floating point values
+ *
+ * The functions take any vector type V of float or double values
+ * that provides the arithmetic, the comparisons, cond, fma, fnma,
+ * round, floor, abs, min, max, frexp and ldexp: the register types
+ * and Short_vector alike.  They are found by argument dependent
+ * lookup for Short_vector, and are called qualified for the
+ * registers, as in ShortVector::Private::exp( a ).
+ *
+ * Each function reduces its argument to a short interval, evaluates
+ * a polynomial or rational approximation there by fused multiply
+ * adds, and reconstructs the result, so that every lane executes the
+ * same instructions and the special cases are blended in at the end.
+ * The approximations are those of Cephes and fdlibm.
+ *
+ * Maximum errors in units of the last place, measured against a
+ * wider reference with fused multiply adds:
+ *
+ *   function     float    double   domain
+ *   exp          1        1
+ *   exp2         1        1.5
+ *   log          1        1.5
+ *   log2         2        2
+ *   log1p        1.5      2
+ *   sin, cos     2        2        |x| < 1e6
+ *   tan          4        4        |x| < 1e6
+ *   atan2        3        3
+ *   tanh         1.5      1.5
+ *   erf          1        1
+ *   pow          see pow
+ *
+ * inverse_sqrt and reciprocal trade accuracy for speed, as chosen by
+ * the tags fast_tag, balanced_tag and ieee_tag: balanced results are
+ * within 4 units in the last place for doubles, and for floats where
+ * the estimate is.  The float estimates of SSE and AVX take subnormal
+ * values as zero, so that there x and results below the normal range
+ * give infinities and zeros.
+ *
+ * Results that are subnormal are as accurate in absolute terms.
+ * Infinities and NaN give the results of the standard library,
+ * except that signed zeros are not distinguished.
+ */
+namespace ShortVector::Private
+{
+
+  namespace Math
+  {
+
+    /** The type R where V holds floating point values */
+    template< typename V, typename R = V >
+    using Floating = enable_if_t<std::is_floating_point_v<typename V::value_type>,R>;
+
+    template< typename V >
+    V
+    polynomial( V const& , double c0 ){
+      return V( typename V::value_type( c0 ));
+    }
+
+    /** c0 + c1*x + c2*x*x + ..., by Horner's rule */
+    template< typename V, typename ... Cs >
+    V
+    polynomial( V const& x, double c0, double c1, Cs ... cs ){
+      return fma( polynomial( x, c1, cs ... ), x, V( typename V::value_type( c0 )));
+    }
+
+    /** The exponential of r, for |r| <= log(2)/2 */
+    template< typename V >
+    V
+    exp_reduced( V const& r ){
+      using T = typename V::value_type;
+      if constexpr( is_same_v<T,float> ){
+	return fma( r*r,
+		    polynomial( r,
+				5.0000001201e-1, 1.6666665459e-1, 4.1665795894e-2,
+				8.3334519073e-3, 1.3981999507e-3, 1.9875691500e-4 ),
+		    r ) + T(1);
+      } else {
+	return fma( r*r,
+		    polynomial( r,
+				1.0/2, 1.0/6, 1.0/24, 1.0/120, 1.0/720, 1.0/5040,
+				1.0/40320, 1.0/362880, 1.0/3628800, 1.0/39916800,
+				1.0/479001600, 1.0/6227020800 ),
+		    r ) + T(1);
+      }
+    }
+
+    /** P in log(1+f) = 2*s + 2*s*z/3 + s*z*z*P(z), with s = f/(2+f)
+     *  and z = s*s, as of fdlibm */
+    template< typename V >
+    V
+    log_polynomial( V const& z ){
+      if constexpr( is_same_v<typename V::value_type,float> ){
+	return polynomial( z, 0xaaaaaa.0p-24, 0xccce13.0p-25, 0x91e9ee.0p-25, 0xf89e26.0p-26 );
+      } else {
+	return polynomial( z,
+			   6.666666666666735130e-01, 3.999999999940941908e-01,
+			   2.857142874366239149e-01, 2.222219843214978396e-01,
+			   1.818357216161805012e-01, 1.531383769920937332e-01,
+			   1.479819860511658591e-01 );
+      }
+    }
+
+    /** The natural logarithm of the significand of x, for positive
+     *  finite x, storing its exponent in k
+     *
+     * The significand is taken in [sqrt(1/2),sqrt(2)), and subnormal
+     * values are scaled to normal ones first.
+     */
+    template< typename V >
+    V
+    log_reduced( V const& x, V& k ){
+      using T = typename V::value_type;
+      constexpr bool single = is_same_v<T,float>;
+      constexpr T shift = single ? 24 : 54;
+      constexpr T scale = single ? 0x1p24 : 0x1p54;
+
+      auto subnormal = x < V( std::numeric_limits<T>::min() );
+      V m = frexp( cond( subnormal, x*scale, x ), k );
+      k = cond( subnormal, k - shift, k );
+
+      auto low = m < V( T( 0.70710678118654752440 ));
+      m = cond( low, m + m, m );
+      k = cond( low, k - T(1), k );
+
+      V f = m - T(1);
+      V s = f/( f + T(2) );
+      V z = s*s;
+      V R = z*log_polynomial( z );
+      V hfsq = T(0.5)*f*f;
+      return f - ( hfsq - s*( hfsq + R ));
+    }
+
+    /** The natural logarithm of x from its reduction, with the special
+     *  values of the standard library */
+    template< typename V >
+    V
+    log_result( V const& x, V const& result ){
+      using T = typename V::value_type;
+      constexpr T infinity = std::numeric_limits<T>::infinity();
+      V r = cond( x == V( infinity ), x, result );
+      r = cond( x == V( T(0) ), V( -infinity ), r );
+      r = cond( x < V( T(0) ), V( std::numeric_limits<T>::quiet_NaN() ), r );
+      return cond( x == x, r, x );
+    }
+
+    /** The multiple n of pi/2 nearest to x */
+    template< typename V >
+    V
+    half_pi_multiple( V const& x ){
+      using T = typename V::value_type;
+      return round( x*T( 0.63661977236758134308 ));
+    }
+
+    /** x less n times pi/2
+     *
+     * pi/2 is split in three parts of the precision of T, the first of
+     * which is subtracted exactly by the fused multiply add.
+     */
+    template< typename V >
+    V
+    reduce_half_pi( V const& x, V const& n ){
+      using T = typename V::value_type;
+      constexpr bool single = is_same_v<T,float>;
+      constexpr T p1 = single ? T( 1.57079637050628662109e+00 ) : T( 1.57079632679489655800e+00 );
+      constexpr T p2 = single ? T( -4.37113882867379288655e-08 ) : T( 6.12323399573676603587e-17 );
+      constexpr T p3 = single ? T( -1.71512451000588187280e-15 ) : T( -1.49738490485916983294e-33 );
+      return fnma( n, V( p3 ), fnma( n, V( p2 ), fnma( n, V( p1 ), x )));
+    }
+
+    /** The sine of r with z = r*r, for |r| <= pi/4 */
+    template< typename V >
+    V
+    sin_reduced( V const& r, V const& z ){
+      if constexpr( is_same_v<typename V::value_type,float> ){
+	return fma( r*z, polynomial( z, -1.6666654611e-1, 8.3321608736e-3, -1.9515295891e-4 ), r );
+      } else {
+	return fma( r*z,
+		    polynomial( z,
+				-1.66666666666666307295e-1, 8.33333333332211858878e-3,
+				-1.98412698295895385996e-4, 2.75573136213857245213e-6,
+				-2.50507477628578072866e-8, 1.58962301576546568060e-10 ),
+		    r );
+      }
+    }
+
+    /** The cosine of r with z = r*r, for |r| <= pi/4 */
+    template< typename V >
+    V
+    cos_reduced( V const& z ){
+      using T = typename V::value_type;
+      V c = fnma( z, V( T(0.5) ), V( T(1) ));
+      if constexpr( is_same_v<T,float> ){
+	return fma( z*z, polynomial( z, 4.166664568298827e-2, -1.388731625493765e-3, 2.443315711809948e-5 ), c );
+      } else {
+	return fma( z*z,
+		    polynomial( z,
+				4.16666666666665929218e-2, -1.38888888888730564116e-3,
+				2.48015872888517045348e-5, -2.75573141792967388112e-7,
+				2.08757008419747316778e-9, -1.13585365213876817300e-11 ),
+		    c );
+      }
+    }
+
+    /** The arc tangent of u, for |u| <= tan(pi/8) */
+    template< typename V >
+    V
+    atan_reduced( V const& u ){
+      V z = u*u;
+      if constexpr( is_same_v<typename V::value_type,float> ){
+	return fma( u*z, polynomial( z, -3.33329491539e-1, 1.99777106478e-1, -1.38776856032e-1, 8.05374449538e-2 ), u );
+      } else {
+	return fma( u*z,
+		    polynomial( z,
+				-6.485021904942025371773e1, -1.228866684490136173410e2,
+				-7.500855792314704667340e1, -1.615753718733365076637e1,
+				-8.750608600031904122785e-1 )
+		    /polynomial( z,
+				 1.945506571482613964425e2, 4.853903996359136964868e2,
+				 4.328810604912902668951e2, 1.650270098316988542046e2,
+				 2.485846490142306297962e1, 1.0 ),
+		    u );
+      }
+    }
+
+    /** The hyperbolic tangent of x with z = x*x, for |x| < 0.625 */
+    template< typename V >
+    V
+    tanh_reduced( V const& x, V const& z ){
+      if constexpr( is_same_v<typename V::value_type,float> ){
+	return fma( x*z,
+		    polynomial( z,
+				-3.33332819422e-1, 1.33314422036e-1, -5.37397155531e-2,
+				2.06390887954e-2, -5.70498872745e-3 ),
+		    x );
+      } else {
+	return fma( x*z,
+		    polynomial( z,
+				-1.61468768441708447952e3, -9.92877231001918586564e1,
+				-9.64399179425052238628e-1 )
+		    /polynomial( z,
+				 4.84406305325125486048e3, 2.23548839060100448583e3,
+				 1.12811678491632931402e2, 1.0 ),
+		    x );
+      }
+    }
+
+    /** log(2)*k + l, with log(2) in two parts */
+    template< typename V >
+    V
+    log_combine( V const& k, V const& l ){
+      using T = typename V::value_type;
+      constexpr bool single = is_same_v<T,float>;
+      constexpr T hi = single ? T( 6.9313812256e-01 ) : T( 6.93147180369123816490e-01 );
+      constexpr T lo = single ? T( 9.0580006145e-06 ) : T( 1.90821492927058770002e-10 );
+      return fma( k, V( hi ), fma( k, V( lo ), l ));
+    }
+
+    /** The accuracy of the approximate functions of V, ieee_tag for
+     *  the registers and the accuracy of the instructions for short
+     *  vectors */
+    template< typename V >
+    struct Accuracy_of : Type<ieee_tag>
+    {};
+
+    template< typename T, size_type N, size_type Align, typename Inst >
+    struct Accuracy_of<Short_vector<T,N,Align,Inst>> : Accuracy<Inst>
+    {};
+
+    /** The accuracy A, or that of V where A is void */
+    template< typename A, typename V >
+    using Chosen_accuracy = typename std::conditional_t<is_same_v<A,void>,Accuracy_of<V>,Type<A>>::type;
+
+    /** The bits of precision of rsqrt and rcp of V */
+    template< typename V >
+    struct Estimate_precision
+    {
+      static constexpr size_type value = V::estimate_precision;
+    };
+
+    template< typename T, size_type N, size_type Align, typename Inst >
+    struct Estimate_precision<Short_vector<T,N,Align,Inst>> : Estimate_precision<typename Register<T,Inst>::type>
+    {};
+
+    template< typename T, size_type N, size_type Align >
+    struct Estimate_precision<Short_vector<T,N,Align,auto_tag>>
+    {
+      static constexpr size_type value = std::numeric_limits<T>::digits;
+    };
+
+    /** The Newton-Raphson steps taking p bits of precision to all but
+     *  the last three bits of T, each step doubling the bits less one */
+    template< typename T >
+    constexpr int
+    refinements( size_type p ){
+      int n = 0;
+      for( ; p < std::numeric_limits<T>::digits - 3; p = 2*p - 1 ){
+	++n;
+      }
+      return n;
+    }
+
+    /** Keep the estimate y where refining it gave NaN, as it does for
+     *  zero and infinite x */
+    template< typename V >
+    V
+    refined( V const& y, V const& estimate ){
+      return cond( y == y, y, estimate );
+    }
+
+  } // end of namespace Math
+
+
+  /** e to the power x */
+  template< typename V >
+  Math::Floating<V>
+  exp( V const& x ){
+    using T = typename V::value_type;
+    constexpr bool single = is_same_v<T,float>;
+    V lower( T( single ? -104 : -746 ));
+    V upper( T( single ? 89 : 710 ));
+    V xc = min( max( x, lower ), upper );
+    V n = round( xc*T( 1.44269504088896340736 ));
+    constexpr T hi = single ? T( 0.693359375 ) : T( 6.93145751953125e-1 );
+    constexpr T lo = single ? T( -2.12194440e-4 ) : T( 1.42860682030941723212e-6 );
+    V r = fnma( n, V( lo ), fnma( n, V( hi ), xc ));
+    V result = ldexp( Math::exp_reduced( r ), n );
+    return cond( x == x, result, x );
+  }
+
+  /** 2 to the power x */
+  template< typename V >
+  Math::Floating<V>
+  exp2( V const& x ){
+    using T = typename V::value_type;
+    constexpr bool single = is_same_v<T,float>;
+    V lower( T( single ? -151 : -1076 ));
+    V upper( T( single ? 129 : 1025 ));
+    V xc = min( max( x, lower ), upper );
+    V n = round( xc );
+    V r = ( xc - n )*T( 0.69314718055994530942 );
+    V result = ldexp( Math::exp_reduced( r ), n );
+    return cond( x == x, result, x );
+  }
+
+  /** The natural logarithm of x */
+  template< typename V >
+  Math::Floating<V>
+  log( V const& x ){
+    using T = typename V::value_type;
+    V k( T(0) );
+    V l = Math::log_reduced( x, k );
+    return Math::log_result( x, Math::log_combine( k, l ));
+  }
+
+  /** The base 2 logarithm of x */
+  template< typename V >
+  Math::Floating<V>
+  log2( V const& x ){
+    using T = typename V::value_type;
+    V k( T(0) );
+    V l = Math::log_reduced( x, k );
+    return Math::log_result( x, fma( l, V( T( 1.44269504088896340736 )), k ));
+  }
+
+  /** The natural logarithm of 1 + x, accurate for small x */
+  template< typename V >
+  Math::Floating<V>
+  log1p( V const& x ){
+    using T = typename V::value_type;
+    V u = x + T(1);
+    V k( T(0) );
+    V l = Math::log_reduced( u, k );
+    // ... the rounding error of 1 + x, to first order
+    l = l + ( x - ( u - T(1) ))/u;
+    V result = cond( u == T(1), x, Math::log_combine( k, l ));
+    return Math::log_result( u, result );
+  }
+
+  /** The sine and cosine of x, stored in s and c */
+  template< typename V >
+  Math::Floating<V,void>
+  sincos( V const& x, V& s, V& c ){
+    using T = typename V::value_type;
+    V n = Math::half_pi_multiple( x );
+    V r = Math::reduce_half_pi( x, n );
+    V z = r*r;
+    V sr = Math::sin_reduced( r, z );
+    V cr = Math::cos_reduced( z );
+    V q = n - T(4)*floor( n*T(0.25) );
+    auto odd = ( q == T(1) ) | ( q == T(3) );
+    s = cond( odd, cr, sr );
+    c = cond( odd, sr, cr );
+    s = cond( q >= T(2), T(-1)*s, s );
+    c = cond(( q == T(1) ) | ( q == T(2) ), T(-1)*c, c );
+  }
+
+  /** The sine of x */
+  template< typename V >
+  Math::Floating<V>
+  sin( V const& x ){
+    V s = x;
+    V c = x;
+    sincos( x, s, c );
+    return s;
+  }
+
+  /** The cosine of x */
+  template< typename V >
+  Math::Floating<V>
+  cos( V const& x ){
+    V s = x;
+    V c = x;
+    sincos( x, s, c );
+    return c;
+  }
+
+  /** The tangent of x */
+  template< typename V >
+  Math::Floating<V>
+  tan( V const& x ){
+    using T = typename V::value_type;
+    V n = Math::half_pi_multiple( x );
+    V r = Math::reduce_half_pi( x, n );
+    V z = r*r;
+    V sr = Math::sin_reduced( r, z );
+    V cr = Math::cos_reduced( z );
+    V q = n - T(2)*floor( n*T(0.5) );
+    return cond( q == T(1), T(-1)*cr/sr, sr/cr );
+  }
+
+  /** The angle of the point (x,y) from the positive x axis, in [-pi,pi] */
+  template< typename V >
+  Math::Floating<V>
+  atan2( V const& y, V const& x ){
+    using T = typename V::value_type;
+    constexpr bool single = is_same_v<T,float>;
+    V ax = abs( x );
+    V ay = abs( y );
+    V hi = max( ax, ay );
+    V lo = min( ax, ay );
+    V t = lo/hi;
+    t = cond( lo == hi, V( T(1) ), t );
+    t = cond( hi == T(0), V( T(0) ), t );
+
+    auto big = t > T( 0.41421356237309504880 );
+    V a = Math::atan_reduced( cond( big, ( t - T(1) )/( t + T(1) ), t ));
+
+    // ... pi/4, pi/2 and pi in two parts each
+    constexpr T quarter_hi = single ? T( 7.85398185253143310547e-01 ) : T( 7.85398163397448278999e-01 );
+    constexpr T quarter_lo = single ? T( -2.18556950315473840e-08 ) : T( 3.06161699786838301793e-17 );
+    constexpr T half_hi = single ? T( 1.57079637050628662109e+00 ) : T( 1.57079632679489655800e+00 );
+    constexpr T half_lo = single ? T( -4.37113900631047680e-08 ) : T( 6.12323399573676603587e-17 );
+    constexpr T pi_hi = single ? T( 3.14159274101257324219e+00 ) : T( 3.14159265358979311600e+00 );
+    constexpr T pi_lo = single ? T( -8.74227801261895370e-08 ) : T( 1.22464679914735317720e-16 );
+    a = cond( big, ( a + quarter_lo ) + quarter_hi, a );
+    a = cond( ay > ax, ( half_hi - a ) + half_lo, a );
+    a = cond( x < T(0), ( pi_hi - a ) + pi_lo, a );
+    a = cond( y < T(0), T(-1)*a, a );
+    return cond(( x == x ) & ( y == y ), a, x + y );
+  }
+
+  /** The hyperbolic tangent of x */
+  template< typename V >
+  Math::Floating<V>
+  tanh( V const& x ){
+    using T = typename V::value_type;
+    V ax = abs( x );
+    V small = Math::tanh_reduced( x, x*x );
+    V large = T(1) - T(2)/( exp( ax + ax ) + T(1) );
+    large = cond( x < T(0), T(-1)*large, large );
+    return cond( ax < T( 0.625 ), small, large );
+  }
+
+  /** The error function of x */
+  template< typename V >
+  Math::Floating<V>
+  erf( V const& x ){
+    using T = typename V::value_type;
+    V ax = abs( x );
+
+    // ... |x| < 0.84375
+    V z = x*x;
+    V tiny = fma( x,
+		  Math::polynomial( z,
+				    1.28379167095512558561e-01, -3.25042107247001499370e-01,
+				    -2.84817495755985104766e-02, -5.77027029648944159157e-03,
+				    -2.37630166566501626084e-05 )
+		  /Math::polynomial( z,
+				     1.0, 3.97917223959155352819e-01,
+				     6.50222499887672944485e-02, 5.08130628187576562776e-03,
+				     1.32494738004321644526e-04, -3.96022827877536812320e-06 ),
+		  x );
+
+    // ... |x| < 1.25
+    V s = ax - T(1);
+    V near = T( 8.45062911510467529297e-01 )
+      + Math::polynomial( s,
+			  -2.36211856075265944077e-03, 4.14856118683748331666e-01,
+			  -3.72207876035701323847e-01, 3.18346619901161753674e-01,
+			  -1.10894694282396677476e-01, 3.54783043256182359371e-02,
+			  -2.16637559486879084300e-03 )
+      /Math::polynomial( s,
+			 1.0, 1.06420880400844228286e-01,
+			 5.40397917702171048937e-01, 7.18286544141962662868e-02,
+			 1.26171219808761642112e-01, 1.36370839120290507362e-02,
+			 1.19844998467991074170e-02 );
+
+    // ... |x| < 6, where erf rounds to 1 beyond
+    V w = T(1)/z;
+    auto inner = ax < T( 1/0.35 );
+    V R = cond( inner,
+		Math::polynomial( w,
+				  -9.86494403484714822705e-03, -6.93858572707181764372e-01,
+				  -1.05586262253232909814e+01, -6.23753324503260060396e+01,
+				  -1.62396669462573470355e+02, -1.84605092906711035994e+02,
+				  -8.12874355063065934246e+01, -9.81432934416914548592e+00 ),
+		Math::polynomial( w,
+				  -9.86494292470009928597e-03, -7.99283237680523006574e-01,
+				  -1.77579549177547519889e+01, -1.60636384855821916062e+02,
+				  -6.37566443368389627722e+02, -1.02509513161107724954e+03,
+				  -4.83519191608651397019e+02 ));
+    V S = cond( inner,
+		Math::polynomial( w,
+				  1.0, 1.96512716674392571292e+01,
+				  1.37657754143519042600e+02, 4.34565877475229228821e+02,
+				  6.45387271733267880336e+02, 4.29008140027567833386e+02,
+				  1.08635005541779435134e+02, 6.57024977031928170135e+00,
+				  -6.04244152148580987438e-02 ),
+		Math::polynomial( w,
+				  1.0, 3.03380607434824582924e+01,
+				  3.25792512996573918826e+02, 1.53672958608443695994e+03,
+				  3.19985821950859553908e+03, 2.55305040643316442583e+03,
+				  4.74528541206955367215e+02, -2.24409524465858183362e+01 ));
+    V far = T(1) - exp( fnma( ax, ax, V( T( -0.5625 ))) + R/S )/ax;
+
+    V result = cond( ax < T( 1.25 ), near, cond( ax < T(6), far, V( T(1) )));
+    result = cond( x < T(0), T(-1)*result, result );
+    result = cond( ax < T( 0.84375 ), tiny, result );
+    return cond( x == x, result, x );
+  }
+
+  /** x to the power y
+   *
+   * Computed as 2 to the power y*log2(x), so that the relative error
+   * of log2(x) is magnified by |y*log2(x)|: the error is within 2
+   * units in the last place where |y*log2(x)| < 1, and grows to about
+   * 1.3*|y*log2(x)| units beyond.  Negative x give the signed result
+   * for integral y, and NaN otherwise.
+   */
+  template< typename V >
+  Math::Floating<V>
+  pow( V const& x, V const& y ){
+    using T = typename V::value_type;
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+    V ax = abs( x );
+    V k( T(0) );
+    V l = Math::log_reduced( ax, k );
+    // ... y*log2(x) as the sum of t and a small correction c
+    V a = y*k;
+    V b = fma( y, l*T( 1.44269504088896340736 ), fms( y, k, a ));
+    V t = a + b;
+    V c = ( a - t ) + b;
+    c = cond( c == c, c, V( T(0) ));
+    V result = exp2( t );
+    result = cond( result < V( infinity ), fma( result, c*T( 0.69314718055994530942 ), result ), result );
+
+    auto integral = floor( y ) == y;
+    auto odd = integral & ( floor( y*T(0.5) ) != y*T(0.5) );
+    result = cond( ax == V( infinity ), cond( y < T(0), V( T(0) ), V( infinity )), result );
+    result = cond( ax == T(0), cond( y < T(0), V( infinity ), V( T(0) )), result );
+    result = cond(( x < T(0) ) & odd, T(-1)*result, result );
+    result = cond(( x < T(0) ) & ( x > V( -infinity )) & ~integral, V( std::numeric_limits<T>::quiet_NaN() ), result );
+    V grows = cond( ax > T(1), V( infinity ), V( T(0) ));
+    V shrinks = cond( ax > T(1), V( T(0) ), V( infinity ));
+    result = cond( abs( y ) == V( infinity ), cond( ax == T(1), V( T(1) ), cond( y > T(0), grows, shrinks )), result );
+    result = cond(( x == x ) & ( y == y ), result, x + y );
+    return cond(( y == T(0) ) | ( x == T(1) ), V( T(1) ), result );
+  }
+
+  /** 1/sqrt( x ), to the accuracy A, or by default to that of V
+   *
+   * With fast_tag this is the estimate rsqrt( x ), with ieee_tag the
+   * quotient 1/sqrt( x ), and with balanced_tag the estimate refined
+   * by the Newton-Raphson steps its precision needs, one for floats
+   * and two for doubles.  The doubles of SSE and AVX have an estimate
+   * only with AVX512VL, and otherwise divide at every accuracy.
+   */
+  template< typename A = void, typename V >
+  Math::Floating<V>
+  inverse_sqrt( V const& x ){
+    using T = typename V::value_type;
+    using Accuracy = Math::Chosen_accuracy<A,V>;
+    if constexpr( is_same_v<Accuracy,ieee_tag> ){
+      return V( T(1) )/sqrt( x );
+    } else {
+      V estimate = rsqrt( x );
+      if constexpr( is_same_v<Accuracy,fast_tag> ){
+	return estimate;
+      } else {
+	static_assert( is_same_v<Accuracy,balanced_tag>, "Unknown accuracy" );
+	V y = estimate;
+	for( int i = 0; i < Math::refinements<T>( Math::Estimate_precision<V>::value ); ++i ){
+	  y = fma( y*T(0.5), fnma( x*y, y, V( T(1) )), y );
+	}
+	return Math::refined( y, estimate );
+      }
+    }
+  }
+
+  /** 1/x, to the accuracy A, or by default to that of V, as inverse_sqrt */
+  template< typename A = void, typename V >
+  Math::Floating<V>
+  reciprocal( V const& x ){
+    using T = typename V::value_type;
+    using Accuracy = Math::Chosen_accuracy<A,V>;
+    if constexpr( is_same_v<Accuracy,ieee_tag> ){
+      return V( T(1) )/x;
+    } else {
+      V estimate = rcp( x );
+      if constexpr( is_same_v<Accuracy,fast_tag> ){
+	return estimate;
+      } else {
+	static_assert( is_same_v<Accuracy,balanced_tag>, "Unknown accuracy" );
+	V y = estimate;
+	for( int i = 0; i < Math::refinements<T>( Math::Estimate_precision<V>::value ); ++i ){
+	  y = fma( y, fnma( x, y, V( T(1) )), y );
+	}
+	return Math::refined( y, estimate );
+      }
+    }
+  }
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined MATH_HPP_INCLUDED_3342598177460135207
@@ -0,0 +1,340 @@
+#ifndef MATRIX_HPP_INCLUDED_4471902385517340116
+#define MATRIX_HPP_INCLUDED_4471902385517340116 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+namespace ShortVector::Private
+{
+
+  namespace Matrices
+  {
+    /** Every lane holding value L of a, as a short vector of type W
+     *
+     * Within a row type this is a shuffle of the register; otherwise
+     * the value is read and broadcast.
+     */
+    template< size_type L, typename W, typename V >
+    constexpr W
+    splat( V const& a ){
+      if constexpr( is_same_v<V,W> ){
+	return broadcast<L>( a );
+      } else {
+	return W( a[L] );
+      }
+    }
+
+    /** The matrix M whose row i is f( i ) */
+    template< typename M, typename F, size_type ... I >
+    constexpr M
+    make( F&& f, integer_sequence<size_type,I...> ){
+      return M( f( I ) ... );
+    }
+
+    /** The sum over k of value k of a times row k of b, by broadcasts
+     *  and fused multiply-adds */
+    template< typename W, typename V, typename Rows, size_type K, size_type ... Ks >
+    constexpr W
+    combine( V const& a, Rows const& b, integer_sequence<size_type,K,Ks...> ){
+      W result = splat<K,W>( a )*b[K];
+      (( result = fma( splat<Ks,W>( a ), b[Ks], result )), ... );
+      return result;
+    }
+
+    /** Lanes 0 and 1, or 2 and 3, of each block of four lanes of a and
+     *  b alternating, as the unpack instructions */
+    template< bool High, typename V, size_type ... I >
+    constexpr V
+    unpack( V const& a, V const& b, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I - I%4 + ( High ? 2 : 0 ) + I%4/2 + I%2*V::extent ) ...>( a, b );
+    }
+
+    /** Lanes 0 and 1, or 2 and 3, of each block of four lanes of a
+     *  followed by the same of b, as the moves of pairs of lanes */
+    template< bool High, typename V, size_type ... I >
+    constexpr V
+    pairs( V const& a, V const& b, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I - I%4 + ( High ? 2 : 0 ) + I%2 + I%4/2*V::extent ) ...>( a, b );
+    }
+
+    /** The first, or second, four lanes of a followed by those of b */
+    template< bool High, typename V, size_type ... I >
+    constexpr V
+    blocks( V const& a, V const& b, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I%4 + ( High ? 4 : 0 ) + I/4*V::extent ) ...>( a, b );
+    }
+
+    /** The cross product of the first three values, the fourth being
+     *  zero where there is one */
+    template< typename V, size_type ... I >
+    constexpr V
+    cross( V const& a, V const& b, integer_sequence<size_type,I...> ){
+      return V::template shuffle<( I < 3 ? ( I + 1 )%3 : I ) ...>( a )*V::template shuffle<( I < 3 ? ( I + 2 )%3 : I ) ...>( b )
+	- V::template shuffle<( I < 3 ? ( I + 2 )%3 : I ) ...>( a )*V::template shuffle<( I < 3 ? ( I + 1 )%3 : I ) ...>( b );
+    }
+
+    /** The cross products and determinant of a 4x4 matrix M
+     *
+     * With the columns of the matrix split into their first three
+     * values a, b, c, d and their last values x, y, z, w, s = a × b,
+     * t = c × d, u = a y - b x and v = c w - d z, and the determinant
+     * is s·v + t·u.  The fourth values of s, t, u and v are zero.
+     */
+    template< typename M >
+    struct Fourth
+    {
+      using row_type = typename M::row_type;
+
+      constexpr explicit
+      Fourth( M const& m )
+	: columns( transpose( m )),
+	  s( cross( columns[0], columns[1], M::lanes )),
+	  t( cross( columns[2], columns[3], M::lanes )),
+	  u( columns[0]*broadcast<3>( columns[1] ) - columns[1]*broadcast<3>( columns[0] )),
+	  v( columns[2]*broadcast<3>( columns[3] ) - columns[3]*broadcast<3>( columns[2] )),
+	  det( dot( s, v ) + dot( t, u ))
+      {}
+
+      M columns;
+      row_type s, t, u, v;
+      typename M::value_type det;
+    }; // end of struct Fourth
+
+  } // end of namespace Matrices
+
+
+  /** A matrix of R rows and C columns of values of type T
+   *
+   * The rows are short vectors, so that products are broadcasts and
+   * fused multiply-adds of whole rows, and transposes of 4x4 and 8x8
+   * matrices are the shuffle networks of the registers.  With
+   * automatic vectorization everything is constexpr.  The explicit
+   * vectorizations need rows of whole registers, such as 4x4 matrices
+   * of floats with SSE or of doubles with AVX, and 8x8 matrices of
+   * floats with AVX.
+   */
+  template< typename T, size_type R, size_type C, size_type Align, typename Inst = auto_tag >
+  class Short_matrix
+  {
+  public:
+
+    using value_type = T;
+    using row_type = Short_vector<T,C,Align,Inst>;
+    using column_type = Short_vector<T,R,Align,Inst>;
+    using storage_type = array<row_type,R>;
+
+    static constexpr size_type rows = R;
+    static constexpr size_type columns = C;
+
+    /** The indices of the values of a row */
+    static constexpr auto lanes = typename Generate_indices<C>::type{};
+
+    template< typename ... Rs,
+	      typename = enable_if_t<sizeof...(Rs) == R && ( is_convertible_v<Rs,row_type> && ... )>>
+    constexpr
+    Short_matrix( Rs const& ... input ) : values{{ row_type( input ) ... }}
+    {}
+
+    /** The matrix whose value in row i and column j is f( i, j ) */
+    template< typename F >
+    constexpr
+    Short_matrix( F&& f, function_tag ) : values( generate( f, typename Generate_indices<R>::type{} ))
+    {}
+
+    static constexpr Short_matrix
+    identity(){
+      return Short_matrix( []( size_type i, size_type j ){ return T( i == j ? 1 : 0 ); }, function_tag{} );
+    }
+
+    constexpr row_type const&
+    operator []( size_type i ) const { return values[i]; }
+
+    constexpr row_type&
+    operator []( size_type i ){ return values[i]; }
+
+    /** The value in row i and column j */
+    constexpr T
+    operator ()( size_type i, size_type j ) const { return values[i][j]; }
+
+    /** The rows at ptr, one after another, the first aligned to Align */
+    static Short_matrix
+    load( T const* ptr ){
+      return Matrices::make<Short_matrix>( [ptr]( size_type i ){ return load_row( ptr + i*C ); },
+					   typename Generate_indices<R>::type{} );
+    }
+
+    void
+    store( T* ptr ) const {
+      for( size_type i = 0; i < R; ++i ){
+	if constexpr( whole_rows ){
+	  values[i].store( ptr + i*C );
+	} else {
+	  values[i].store( unaligned<T>{ ptr + i*C });
+	}
+      }
+    }
+
+    friend constexpr Short_matrix
+    operator +( Short_matrix const& a, Short_matrix const& b ){
+      return Matrices::make<Short_matrix>( [&]( size_type i ){ return a[i] + b[i]; }, typename Generate_indices<R>::type{} );
+    }
+
+    friend constexpr Short_matrix
+    operator -( Short_matrix const& a, Short_matrix const& b ){
+      return Matrices::make<Short_matrix>( [&]( size_type i ){ return a[i] - b[i]; }, typename Generate_indices<R>::type{} );
+    }
+
+    friend constexpr Short_matrix
+    operator *( Short_matrix const& a, T x ){
+      return Matrices::make<Short_matrix>( [&]( size_type i ){ return a[i]*x; }, typename Generate_indices<R>::type{} );
+    }
+
+    friend constexpr Short_matrix
+    operator *( T x, Short_matrix const& a ){
+      return a*x;
+    }
+
+    /** The product of the row vector x and a */
+    friend constexpr row_type
+    operator *( column_type const& x, Short_matrix const& a ){
+      return Matrices::combine<row_type>( x, a.values, typename Generate_indices<R>::type{} );
+    }
+
+    /** The product of a and the column vector x
+     *
+     * The columns of a are the rows of its transpose; to transform
+     * many vectors by one matrix, transpose it once and multiply the
+     * vectors from the left.
+     */
+    friend constexpr column_type
+    operator *( Short_matrix const& a, row_type const& x ){
+      return x*transpose( a );
+    }
+
+    template< size_type K >
+    friend constexpr Short_matrix<T,R,K,Align,Inst>
+    operator *( Short_matrix const& a, Short_matrix<T,C,K,Align,Inst> const& b ){
+      using result_type = Short_matrix<T,R,K,Align,Inst>;
+      return Matrices::make<result_type>( [&]( size_type i ){ return a[i]*b; }, typename Generate_indices<R>::type{} );
+    }
+
+    friend constexpr Short_matrix<T,C,R,Align,Inst>
+    transpose( Short_matrix const& a ){
+      using result_type = Short_matrix<T,C,R,Align,Inst>;
+      if constexpr( R == C && R == 2 ){
+	return result_type( row_type::template shuffle<0,2>( a[0], a[1] ),
+			    row_type::template shuffle<1,3>( a[0], a[1] ));
+      } else if constexpr( R == C && R == 4 ){
+	// _MM_TRANSPOSE4_PS
+	row_type t0 = Matrices::unpack<false>( a[0], a[1], lanes );
+	row_type t1 = Matrices::unpack<true>( a[0], a[1], lanes );
+	row_type t2 = Matrices::unpack<false>( a[2], a[3], lanes );
+	row_type t3 = Matrices::unpack<true>( a[2], a[3], lanes );
+	return result_type( Matrices::pairs<false>( t0, t2, lanes ), Matrices::pairs<true>( t0, t2, lanes ),
+			    Matrices::pairs<false>( t1, t3, lanes ), Matrices::pairs<true>( t1, t3, lanes ));
+      } else if constexpr( R == C && R == 8 ){
+	// The unpacks and pair moves within the halves of the registers,
+	// then the moves of the halves
+	row_type t0 = Matrices::unpack<false>( a[0], a[1], lanes );
+	row_type t1 = Matrices::unpack<true>( a[0], a[1], lanes );
+	row_type t2 = Matrices::unpack<false>( a[2], a[3], lanes );
+	row_type t3 = Matrices::unpack<true>( a[2], a[3], lanes );
+	row_type t4 = Matrices::unpack<false>( a[4], a[5], lanes );
+	row_type t5 = Matrices::unpack<true>( a[4], a[5], lanes );
+	row_type t6 = Matrices::unpack<false>( a[6], a[7], lanes );
+	row_type t7 = Matrices::unpack<true>( a[6], a[7], lanes );
+	row_type u0 = Matrices::pairs<false>( t0, t2, lanes );
+	row_type u1 = Matrices::pairs<true>( t0, t2, lanes );
+	row_type u2 = Matrices::pairs<false>( t1, t3, lanes );
+	row_type u3 = Matrices::pairs<true>( t1, t3, lanes );
+	row_type u4 = Matrices::pairs<false>( t4, t6, lanes );
+	row_type u5 = Matrices::pairs<true>( t4, t6, lanes );
+	row_type u6 = Matrices::pairs<false>( t5, t7, lanes );
+	row_type u7 = Matrices::pairs<true>( t5, t7, lanes );
+	return result_type( Matrices::blocks<false>( u0, u4, lanes ), Matrices::blocks<false>( u1, u5, lanes ),
+			    Matrices::blocks<false>( u2, u6, lanes ), Matrices::blocks<false>( u3, u7, lanes ),
+			    Matrices::blocks<true>( u0, u4, lanes ), Matrices::blocks<true>( u1, u5, lanes ),
+			    Matrices::blocks<true>( u2, u6, lanes ), Matrices::blocks<true>( u3, u7, lanes ));
+      } else {
+	return result_type( [&a]( size_type i, size_type j ){ return a( j, i ); }, function_tag{} );
+      }
+    }
+
+    /** The determinant of a 2x2, 3x3 or 4x4 matrix */
+    friend constexpr T
+    determinant( Short_matrix const& a ){
+      static_assert( R == C && R >= 2 && R <= 4, "Determinants are of 2x2, 3x3 and 4x4 matrices" );
+      if constexpr( R == 2 ){
+	row_type const p = a[0]*row_type::template shuffle<1,0>( a[1] );
+	return p[0] - p[1];
+      } else if constexpr( R == 3 ){
+	return dot( a[0], Matrices::cross( a[1], a[2], lanes ));
+      } else {
+	return Matrices::Fourth<Short_matrix>( a ).det;
+      }
+    }
+
+    /** The inverse of a 2x2, 3x3 or 4x4 matrix, by Cramer's rule
+     *
+     * The matrix must not be singular.
+     */
+    friend constexpr Short_matrix
+    inverse( Short_matrix const& a ){
+      static_assert( R == C && R >= 2 && R <= 4, "Inverses are of 2x2, 3x3 and 4x4 matrices" );
+      if constexpr( R == 2 ){
+	// ( d -b ; -c a )/( ad - bc )
+	row_type const p = a[0]*row_type::template shuffle<1,0>( a[1] );
+	T scale = T( 1 )/( p[0] - p[1] );
+	return Short_matrix( row_type::template shuffle<3,1>( a[0], a[1] )*row_type( scale, -scale ),
+			     row_type::template shuffle<2,0>( a[0], a[1] )*row_type( -scale, scale ));
+      } else if constexpr( R == 3 ){
+	// The cross products of the rows are the columns of the inverse
+	row_type c0 = Matrices::cross( a[1], a[2], lanes );
+	row_type c1 = Matrices::cross( a[2], a[0], lanes );
+	row_type c2 = Matrices::cross( a[0], a[1], lanes );
+	T scale = T( 1 )/dot( a[0], c0 );
+	return transpose( Short_matrix( c0*scale, c1*scale, c2*scale ));
+      } else {
+	Matrices::Fourth<Short_matrix> f( a );
+	T scale = T( 1 )/f.det;
+	row_type s = f.s*scale, t = f.t*scale, u = f.u*scale, v = f.v*scale;
+	row_type const& x = f.columns[0];
+	row_type const& y = f.columns[1];
+	row_type const& z = f.columns[2];
+	row_type const& w = f.columns[3];
+	row_type last = row_type::template shuffle<4,4,4,0>( row_type( T( 1 )), row_type( T( 0 )));
+	return Short_matrix( Matrices::cross( y, v, lanes ) + t*broadcast<3>( y ) - last*dot( y, t ),
+			     Matrices::cross( v, x, lanes ) - t*broadcast<3>( x ) + last*dot( x, t ),
+			     Matrices::cross( w, u, lanes ) + s*broadcast<3>( w ) - last*dot( w, s ),
+			     Matrices::cross( u, z, lanes ) - s*broadcast<3>( z ) + last*dot( z, s ));
+      }
+    }
+
+  private:
+
+    static constexpr bool whole_rows = C*size_type( sizeof(T)) % Align == 0;
+
+    template< typename F, size_type ... I >
+    static constexpr storage_type
+    generate( F& f, integer_sequence<size_type,I...> ){
+      return storage_type{{ row_type( [&f]( size_type j ){ return f( I, j ); }, function_tag{} ) ... }};
+    }
+
+    static row_type
+    load_row( T const* ptr ){
+      if constexpr( whole_rows ){
+	return row_type::load( ptr );
+      } else {
+	return row_type::load( unaligned<T>{ const_cast<T*>( ptr ) });
+      }
+    }
+
+    storage_type values;
+
+  }; // end of class Short_matrix
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined MATRIX_HPP_INCLUDED_4471902385517340116
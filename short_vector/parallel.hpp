@@ -0,0 +1,466 @@
+#ifndef PARALLEL_HPP_INCLUDED_4098127735561820493
+#define PARALLEL_HPP_INCLUDED_4098127735561820493 1
+
+//
+// ... Standard header files
+//
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// ... System header files
+//
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/algorithm.hpp>
+
+/** The algorithms on arrays, on several threads
+ *
+ * The arrays are split into chunks of whole short vectors that begin
+ * on cache lines of the output, so that no two threads write to the
+ * same cache line, and the chunks are run on a pool of threads that
+ * steal from each other's queues once their own is empty.
+ */
+namespace ShortVector::Private
+{
+
+  /** Threads running the calls of parallel loops
+   *
+   * Each thread has a queue of calls, to which a loop deals its calls
+   * in turn.  A thread takes calls from the back of its own queue and,
+   * once that is empty, from the front of the others', and the thread
+   * that started the loop does likewise until the loop is done.
+   */
+  class Thread_pool
+  {
+  public:
+
+    /** A pool of threads that, if pinned, run each on processor i
+     *  modulo the number of processors */
+    explicit
+    Thread_pool( size_type threads = default_size(), bool pinned = false )
+      : queues( threads > 0 ? threads : 1 )
+    {
+      workers.reserve( queues.size());
+      for( size_type i = 0; i < size_type( queues.size()); ++i ){
+	workers.emplace_back( [this, i]{ work( i ); });
+	if( pinned ) pin( workers.back(), i );
+      }
+    }
+
+    Thread_pool( Thread_pool const& ) = delete;
+
+    Thread_pool&
+    operator =( Thread_pool const& ) = delete;
+
+    ~Thread_pool(){
+      {
+	std::lock_guard<std::mutex> lock( sleep );
+	stopping = true;
+      }
+      wake.notify_all();
+      for( auto& worker : workers ){
+	worker.join();
+      }
+    }
+
+    size_type
+    size() const { return size_type( queues.size()); }
+
+    /** Call body( k ) for k from 0 to count, returning once every call
+     *  has, and rethrowing the first exception thrown by any */
+    template< typename F >
+    void
+    parallel_for( size_type count, F&& body ){
+      if( count <= 0 ) return;
+
+      Job job;
+      job.context = &body;
+      job.call = []( void* context, size_type k ){
+	( *static_cast<std::remove_reference_t<F>*>( context ))( k );
+      };
+      job.remaining = count;
+
+      size_type n = size();
+      size_type first = next.fetch_add( 1 );
+      for( size_type k = 0; k < count; ++k ){
+	Queue& queue = queues[ ( first + k )%n ];
+	std::lock_guard<std::mutex> lock( queue.lock );
+	queue.tasks.push_back( Task{ &job, k });
+      }
+      {
+	std::lock_guard<std::mutex> lock( sleep );
+	pending += count;
+      }
+      wake.notify_all();
+
+      while( job.remaining.load( std::memory_order_acquire ) > 0 ){
+	Task task;
+	if( take( first%n, task )){
+	  run( task );
+	} else {
+	  std::this_thread::yield();
+	}
+      }
+
+      if( job.error ) std::rethrow_exception( job.error );
+    }
+
+    /** The number of threads of a default pool: the value of the
+     *  environment variable SHORT_VECTOR_THREADS, or the number of
+     *  processors */
+    static size_type
+    default_size(){
+      if( char const* requested = std::getenv( "SHORT_VECTOR_THREADS" )){
+	size_type result = size_type( std::strtoll( requested, nullptr, 10 ));
+	if( result > 0 ) return result;
+      }
+      size_type processors = size_type( std::thread::hardware_concurrency());
+      return processors > 0 ? processors : 1;
+    }
+
+  private:
+
+    struct Job
+    {
+      void* context;
+      void (*call)( void*, size_type );
+      std::atomic<size_type> remaining;
+      std::mutex lock;
+      std::exception_ptr error;
+    }; // end of struct Job
+
+    struct Task
+    {
+      Job* job;
+      size_type index;
+    }; // end of struct Task
+
+    struct alignas(64) Queue
+    {
+      std::mutex lock;
+      std::deque<Task> tasks;
+    }; // end of struct Queue
+
+    static void
+    pin( std::thread& thread, size_type i ){
+#if defined(__linux__)
+      size_type processors = size_type( std::thread::hardware_concurrency());
+      if( processors <= 0 ) return;
+      cpu_set_t set;
+      CPU_ZERO( &set );
+      CPU_SET( int( i%processors ), &set );
+      pthread_setaffinity_np( thread.native_handle(), sizeof(set), &set );
+#else
+      (void) thread;
+      (void) i;
+#endif
+    }
+
+    /** Take a task from the back of queue i, or else steal one from
+     *  the front of another queue */
+    bool
+    take( size_type i, Task& task ){
+      size_type n = size();
+      for( size_type k = 0; k < n; ++k ){
+	Queue& queue = queues[ ( i + k )%n ];
+	std::lock_guard<std::mutex> lock( queue.lock );
+	if( ! queue.tasks.empty()){
+	  if( k == 0 ){
+	    task = queue.tasks.back();
+	    queue.tasks.pop_back();
+	  } else {
+	    task = queue.tasks.front();
+	    queue.tasks.pop_front();
+	  }
+	  pending.fetch_sub( 1, std::memory_order_relaxed );
+	  return true;
+	}
+      }
+      return false;
+    }
+
+    static void
+    run( Task const& task ){
+      Job& job = *task.job;
+      try {
+	job.call( job.context, task.index );
+      } catch( ... ){
+	std::lock_guard<std::mutex> lock( job.lock );
+	if( ! job.error ) job.error = std::current_exception();
+      }
+      job.remaining.fetch_sub( 1, std::memory_order_acq_rel );
+    }
+
+    void
+    work( size_type i ){
+      for(;;){
+	Task task;
+	if( take( i, task )){
+	  run( task );
+	  continue;
+	}
+	std::unique_lock<std::mutex> lock( sleep );
+	wake.wait( lock, [this]{ return stopping || pending.load( std::memory_order_relaxed ) > 0; });
+	if( stopping ) return;
+      }
+    }
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_type> pending{ 0 };
+    std::atomic<size_type> next{ 0 };
+    std::mutex sleep;
+    std::condition_variable wake;
+    bool stopping = false;
+
+  }; // end of class Thread_pool
+
+
+  /** The pool used by the parallel algorithms unless they are given one */
+  inline Thread_pool&
+  default_pool(){
+    static Thread_pool result;
+    return result;
+  }
+
+
+  namespace Parallel
+  {
+    /** The number of bytes of output of a chunk, chosen to keep the
+     *  working set of a thread within its share of the caches */
+    constexpr size_type chunk_bytes = size_type( 64 ) << 10;
+
+    /** The chunks of n values written to out
+     *
+     * Every chunk but the first begins on a cache line of the output
+     * and holds whole short vectors of type V, and there are several
+     * chunks per thread of the pool unless that would make them smaller
+     * than a cache line.
+     */
+    template< typename V >
+    struct Chunks
+    {
+      using value_type = typename V::value_type;
+
+      static constexpr size_type cache_line = 64;
+
+      Chunks( value_type const* out, size_type n, size_type threads ) : count( n )
+      {
+	constexpr size_type alignment = V::alignment > cache_line ? V::alignment : cache_line;
+	constexpr size_type values = alignment/size_type( sizeof(value_type));
+	constexpr size_type unit = values % V::extent == 0 ? values
+	  : V::extent % values == 0 ? V::extent : values*V::extent;
+
+	head = Algorithms::misalignment( out, alignment );
+	head = head < n ? head : n;
+
+	size_type target = chunk_bytes/size_type( sizeof(value_type));
+	size_type balanced = ( n + 4*threads - 1 )/( 4*threads );
+	size = ( balanced < target ? balanced : target );
+	size = ( size + unit - 1 )/unit*unit;
+      }
+
+      size_type
+      chunks() const {
+	return count == head ? ( head > 0 ) : 1 + ( count - head - 1 )/size;
+      }
+
+      size_type
+      begin( size_type k ) const { return k == 0 ? 0 : head + k*size; }
+
+      size_type
+      end( size_type k ) const {
+	size_type result = head + ( k + 1 )*size;
+	return result < count ? result : count;
+      }
+
+      size_type count;
+      size_type head;
+      size_type size;
+    }; // end of struct Chunks
+
+    /** The reduction of a chunk, on a cache line of its own */
+    template< typename V >
+    struct alignas(64) Partial
+    {
+      explicit
+      Partial( typename V::value_type init ) : accumulator( init )
+      {}
+
+      Algorithms::Accumulator<V> accumulator;
+    }; // end of struct Partial
+
+    /** The reduction of init and the partial reductions, in order */
+    template< typename V, typename R >
+    typename V::value_type
+    fold( std::vector<Partial<V>> const& partials, typename V::value_type init, R& reduce ){
+      for( auto const& partial : partials ){
+	init = partial.accumulator.fold( init, reduce );
+      }
+      return init;
+    }
+
+
+    /** out[i] = f( in[i] ) */
+    template< typename V, typename F >
+    void
+    transform( typename V::value_type const* in, size_type n, typename V::value_type* out, F&& f,
+	       Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( out, n, pool.size());
+      bool streaming = Algorithms::streams<typename V::value_type>( n );
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::transform<V>( in + i, chunks.end( k ) - i, out + i, f, streaming );
+      });
+    }
+
+    /** out[i] = f( in1[i], in2[i] ) */
+    template< typename V, typename F >
+    void
+    transform( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+	       typename V::value_type* out, F&& f, Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( out, n, pool.size());
+      bool streaming = Algorithms::streams<typename V::value_type>( n );
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::transform<V>( in1 + i, in2 + i, chunks.end( k ) - i, out + i, f, streaming );
+      });
+    }
+
+    template< typename V, typename F >
+    void
+    for_each( typename V::value_type* data, size_type n, F&& f, Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( data, n, pool.size());
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::for_each<V>( data + i, chunks.end( k ) - i, f );
+      });
+    }
+
+    template< typename V >
+    void
+    fill( typename V::value_type* data, size_type n, typename V::value_type x,
+	  Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( data, n, pool.size());
+      bool streaming = Algorithms::streams<typename V::value_type>( n );
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::fill<V>( data + i, chunks.end( k ) - i, x, streaming );
+      });
+    }
+
+    /** The reduction of init and f( in[i] ) for every i
+     *
+     * Each chunk is reduced on its own, and the chunks are then
+     * reduced in order, so that the result does not depend on which
+     * thread ran which chunk.
+     */
+    template< typename V, typename R, typename F >
+    typename V::value_type
+    transform_reduce( typename V::value_type const* in, size_type n, typename V::value_type init,
+		      R&& reduce, F&& f, Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( in, n, pool.size());
+      std::vector<Partial<V>> partials( chunks.chunks(), Partial<V>( init ));
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::transform_reduce<V>( in + i, chunks.end( k ) - i, partials[k].accumulator, reduce, f );
+      });
+      return fold( partials, init, reduce );
+    }
+
+    template< typename V, typename R, typename F >
+    typename V::value_type
+    transform_reduce( typename V::value_type const* in1, typename V::value_type const* in2, size_type n,
+		      typename V::value_type init, R&& reduce, F&& f, Thread_pool& pool = default_pool()){
+      Chunks<V> chunks( in1, n, pool.size());
+      std::vector<Partial<V>> partials( chunks.chunks(), Partial<V>( init ));
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::transform_reduce<V>( in1 + i, in2 + i, chunks.end( k ) - i, partials[k].accumulator,
+					 reduce, f );
+      });
+      return fold( partials, init, reduce );
+    }
+
+    template< typename V, typename R >
+    typename V::value_type
+    reduce( typename V::value_type const* in, size_type n, typename V::value_type init, R&& reduce,
+	    Thread_pool& pool = default_pool()){
+      return transform_reduce<V>( in, n, init, reduce, Algorithms::Identity{}, pool );
+    }
+
+    /** The scan of the chunks, by summing each chunk, adding the sums
+     *  in order for the offset of each chunk, and then scanning each
+     *  chunk from its offset */
+    template< bool Exclusive, typename V >
+    typename V::value_type
+    scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+	  typename V::value_type init, Thread_pool& pool ){
+      using value_type = typename V::value_type;
+      auto plus = []( auto const& x, auto const& y ){ return x + y; };
+      Algorithms::Identity identity;
+
+      Chunks<V> chunks( out, n, pool.size());
+      std::vector<Partial<V>> partials( chunks.chunks(), Partial<V>( value_type( 0 )));
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::transform_reduce<V>( in + i, chunks.end( k ) - i, partials[k].accumulator, plus, identity );
+      });
+
+      std::vector<value_type> offsets( partials.size());
+      for( size_type k = 0; k < size_type( partials.size()); ++k ){
+	offsets[k] = init;
+	init = partials[k].accumulator.fold( init, plus );
+      }
+
+      bool streaming = Algorithms::streams<value_type>( n );
+      pool.parallel_for( chunks.chunks(), [&]( size_type k ){
+	size_type i = chunks.begin( k );
+	Algorithms::scan<Exclusive,V>( in + i, chunks.end( k ) - i, out + i, offsets[k], streaming );
+      });
+      return init;
+    }
+
+    /** out[i] = init + in[0] + ... + in[i], returning the sum of init
+     *  and all the values
+     *
+     * The input is read twice, once for the sum of each chunk and once
+     * for its scan; as with the reductions, the result does not depend
+     * on which thread ran which chunk.
+     */
+    template< typename V >
+    typename V::value_type
+    inclusive_scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+		    typename V::value_type init = typename V::value_type( 0 ),
+		    Thread_pool& pool = default_pool()){
+      return scan<false,V>( in, n, out, init, pool );
+    }
+
+    /** out[i] = init + in[0] + ... + in[i-1], returning the sum of init
+     *  and all the values */
+    template< typename V >
+    typename V::value_type
+    exclusive_scan( typename V::value_type const* in, size_type n, typename V::value_type* out,
+		    typename V::value_type init = typename V::value_type( 0 ),
+		    Thread_pool& pool = default_pool()){
+      return scan<true,V>( in, n, out, init, pool );
+    }
+
+  } // end of namespace Parallel
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined PARALLEL_HPP_INCLUDED_4098127735561820493
@@ -1,6 +1,11 @@
 #ifndef SHORT_VECTOR_HPP_INCLUDED_1587481230445715340
 #define SHORT_VECTOR_HPP_INCLUDED_1587481230445715340 1
 
+//
+// ... Short Vector header files
+//
+#include <short_vector/import.hpp>
+
 namespace ShortVector
 {
 
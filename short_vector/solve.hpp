@@ -0,0 +1,180 @@
+#ifndef SOLVE_HPP_INCLUDED_7730519946207813452
+#define SOLVE_HPP_INCLUDED_7730519946207813452 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Batched solves of small linear systems, one system per lane
+ *
+ * A batch of square matrices of order N is held value by value: the
+ * short vector or register at [i][j] holds value (i,j) of every matrix,
+ * lane k belonging to the matrix of lane k, so that each step of a
+ * factorization or substitution is one instruction for all of them.
+ * The lanes follow the same instruction stream, and where they differ,
+ * as in the choice of pivots, they differ through masks.
+ */
+namespace ShortVector::Private
+{
+
+  /** The square matrices of order N of the lanes of V */
+  template< typename V, size_type N >
+  using Batched_matrix = array<array<V,std::size_t( N )>,std::size_t( N )>;
+
+  /** The vectors of order N of the lanes of V */
+  template< typename V, size_type N >
+  using Batched_vector = array<V,std::size_t( N )>;
+
+  //
+  // The order cannot be deduced as a size_type from the std::size_t
+  // extent of array, so the solvers below take the extent M of their
+  // arguments and count in size_type N = M.
+  //
+
+  namespace Solves
+  {
+    /** Exchange x and y in the lanes of the mask */
+    template< typename V >
+    void
+    exchange( V& x, V& y, typename V::mask_type const& m ){
+      V t = x;
+      x = cond( m, y, x );
+      y = cond( m, t, y );
+    }
+
+  } // end of namespace Solves
+
+
+  /** Factor the matrices in place as P A = L U, by Gaussian elimination
+   *  with partial pivoting
+   *
+   * On return the strict lower triangle of a holds L, whose diagonal is
+   * ones, and the upper triangle holds U.  In each lane, pivots[k] is
+   * the row exchanged with row k at step k.  The result masks the
+   * lanes whose pivots are all nonzero and not NaN; the others are
+   * left with infinities and NaNs, which do not reach the other lanes.
+   */
+  template< typename V, std::size_t M >
+  typename V::mask_type
+  lu_factor( array<array<V,M>,M>& a, array<V,M>& pivots ){
+    using T = typename V::value_type;
+    constexpr size_type N = M;
+    typename V::mask_type nonsingular( true );
+
+    for( size_type k = 0; k < N; ++k ){
+      V largest = abs( a[k][k] );
+      V pivot = V( T( k ));
+      for( size_type i = k + 1; i < N; ++i ){
+	V x = abs( a[i][k] );
+	auto larger = x > largest;
+	largest = cond( larger, x, largest );
+	pivot = cond( larger, V( T( i )), pivot );
+      }
+      pivots[k] = pivot;
+
+      for( size_type i = k + 1; i < N; ++i ){
+	auto m = pivot == V( T( i ));
+	if( any( m )){
+	  for( size_type j = 0; j < N; ++j ){
+	    Solves::exchange( a[k][j], a[i][j], m );
+	  }
+	}
+      }
+
+      nonsingular = nonsingular & ( abs( a[k][k] ) > V( T( 0 )));
+      V scale = V( T( 1 ))/a[k][k];
+      for( size_type i = k + 1; i < N; ++i ){
+	a[i][k] = a[i][k]*scale;
+	for( size_type j = k + 1; j < N; ++j ){
+	  a[i][j] = fnma( a[i][k], a[k][j], a[i][j] );
+	}
+      }
+    }
+    return nonsingular;
+  }
+
+  /** Solve A x = b in place, with the factors of lu_factor */
+  template< typename V, std::size_t M >
+  void
+  lu_solve( array<array<V,M>,M> const& lu, array<V,M> const& pivots, array<V,M>& b ){
+    using T = typename V::value_type;
+    constexpr size_type N = M;
+
+    for( size_type k = 0; k < N; ++k ){
+      for( size_type i = k + 1; i < N; ++i ){
+	Solves::exchange( b[k], b[i], pivots[k] == V( T( i )));
+      }
+    }
+
+    for( size_type i = 1; i < N; ++i ){
+      for( size_type j = 0; j < i; ++j ){
+	b[i] = fnma( lu[i][j], b[j], b[i] );
+      }
+    }
+
+    for( size_type i = N; i-- > 0; ){
+      for( size_type j = i + 1; j < N; ++j ){
+	b[i] = fnma( lu[i][j], b[j], b[i] );
+      }
+      b[i] = b[i]/lu[i][i];
+    }
+  }
+
+  /** Factor the symmetric matrices in place as A = L Lᵀ
+   *
+   * Only the lower triangle of a is read, and it is overwritten by L;
+   * the strict upper triangle is left as it was.  The result masks
+   * the lanes whose matrices are positive definite.
+   */
+  template< typename V, std::size_t M >
+  typename V::mask_type
+  cholesky_factor( array<array<V,M>,M>& a ){
+    using T = typename V::value_type;
+    constexpr size_type N = M;
+    typename V::mask_type definite( true );
+
+    for( size_type j = 0; j < N; ++j ){
+      V d = a[j][j];
+      for( size_type k = 0; k < j; ++k ){
+	d = fnma( a[j][k], a[j][k], d );
+      }
+      definite = definite & ( d > V( T( 0 )));
+      a[j][j] = sqrt( d );
+
+      V scale = V( T( 1 ))/a[j][j];
+      for( size_type i = j + 1; i < N; ++i ){
+	V x = a[i][j];
+	for( size_type k = 0; k < j; ++k ){
+	  x = fnma( a[i][k], a[j][k], x );
+	}
+	a[i][j] = x*scale;
+      }
+    }
+    return definite;
+  }
+
+  /** Solve A x = b in place, with the factor of cholesky_factor */
+  template< typename V, std::size_t M >
+  void
+  cholesky_solve( array<array<V,M>,M> const& l, array<V,M>& b ){
+    constexpr size_type N = M;
+
+    for( size_type i = 0; i < N; ++i ){
+      for( size_type j = 0; j < i; ++j ){
+	b[i] = fnma( l[i][j], b[j], b[i] );
+      }
+      b[i] = b[i]/l[i][i];
+    }
+
+    for( size_type i = N; i-- > 0; ){
+      for( size_type j = i + 1; j < N; ++j ){
+	b[i] = fnma( l[j][i], b[j], b[i] );
+      }
+      b[i] = b[i]/l[i][i];
+    }
+  }
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined SOLVE_HPP_INCLUDED_7730519946207813452
@@ -0,0 +1,656 @@
+#ifndef M128_HPP_INCLUDED_1240584093714852019
+#define M128_HPP_INCLUDED_1240584093714852019 1
+
+//
+// ... Intrinsics
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/sse/utility.hpp>
+
+namespace SSE
+{
+  
+  /** The result of comparing two m128 registers
+   *
+   * Each lane holds the raw bits of the comparison, all set where it
+   * holds and all clear elsewhere, as used by the blend instructions.
+   */
+  class m128_mask
+  {
+  public:
+
+    static constexpr size_type extent = 4;
+
+    m128_mask(){}
+
+    m128_mask( m128_mask const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m128_mask( __m128 input ){
+      data = input;
+    }
+
+    explicit
+    m128_mask( bool input ){
+      data = input ? all_set() : _mm_setzero_ps();
+    }
+
+    m128_mask&
+    operator =( m128_mask const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    /** The raw bits of the comparison */
+    __m128
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static m128_mask
+    first( size_type n ){
+      return m128_mask( _mm_castsi128_ps( leading_bytes( n*size_type( sizeof(float) ))));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( _mm_movemask_ps( data ) >> i ) & 1;
+    }
+
+    friend m128_mask
+    operator &( m128_mask const& a, m128_mask const& b ){
+      return m128_mask( _mm_and_ps( a.data, b.data ));
+    }
+
+    friend m128_mask
+    operator |( m128_mask const& a, m128_mask const& b ){
+      return m128_mask( _mm_or_ps( a.data, b.data ));
+    }
+
+    friend m128_mask
+    operator ^( m128_mask const& a, m128_mask const& b ){
+      return m128_mask( _mm_xor_ps( a.data, b.data ));
+    }
+
+    friend m128_mask
+    operator ~( m128_mask const& a ){
+      return m128_mask( _mm_xor_ps( a.data, all_set()));
+    }
+
+    friend bool
+    any( m128_mask const& a ){
+      return _mm_movemask_ps( a.data ) != 0;
+    }
+
+    friend bool
+    all( m128_mask const& a ){
+      return _mm_movemask_ps( a.data ) == 0xF;
+    }
+
+    friend bool
+    none( m128_mask const& a ){
+      return _mm_movemask_ps( a.data ) == 0;
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( m128_mask const& a ){
+      int lanes = _mm_movemask_ps( a.data );
+      return lanes ? __builtin_ctz( lanes ) : extent;
+    }
+
+    friend size_type
+    popcount( m128_mask const& a ){
+      return __builtin_popcount( _mm_movemask_ps( a.data ));
+    }
+
+  private:
+
+    static __m128
+    all_set(){
+      return _mm_castsi128_ps( _mm_set1_epi32( -1 ));
+    }
+
+    __m128 data;
+  }; // end of class m128_mask
+
+  class m128
+  {
+  public:
+
+    using value_type = float;
+
+    static constexpr size_type extent = 4;
+
+    /** The bits of precision of the estimates rsqrt and rcp */
+    static constexpr size_type estimate_precision = 12;
+
+    using mask_type = m128_mask;
+
+    //
+    // constructors
+    // 
+    m128(){}
+
+    m128( m128 const& input ){
+      data = input.data;
+    }
+
+    m128( float input ){
+      data = _mm_set1_ps(input);
+    }
+   
+    m128( float const* ptr ){
+      data = _mm_load_ps(ptr);
+    }
+
+    m128( unaligned<float> const& u){
+      data = _mm_loadu_ps( u.ptr );
+    }
+
+    m128( stream<float> const& s ){      
+      data =_mm_castsi128_ps(_mm_stream_load_si128((__m128i*)s.ptr));
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m128( float const* ptr, m128_mask const& m ){
+#if defined(__AVX__)
+      data = _mm_maskload_ps( ptr, _mm_castps_si128( m.bits()));
+#else
+      alignas(16) float buffer[ extent ] = {};
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) buffer[i] = ptr[i];
+      }
+      data = _mm_load_ps( buffer );
+#endif
+    }
+
+    
+    //
+    // store
+    //
+    void
+    store( float* ptr ) const {
+      _mm_store_ps( ptr, data );
+    }
+
+    void
+    store( float* ptr, stream_tag) const {
+      _mm_stream_ps( ptr, data );
+    }
+
+    void
+    store( unaligned<float> const& u ) const {
+      _mm_storeu_ps( u.ptr, data );
+    }
+
+    void
+    store( stream<float> const& s ) const {
+      _mm_stream_ps( s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( float* ptr, m128_mask const& m ) const {
+#if defined(__AVX__)
+      _mm_maskstore_ps( ptr, _mm_castps_si128( m.bits()), data );
+#else
+      alignas(16) float buffer[ extent ];
+      _mm_store_ps( buffer, data );
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) ptr[i] = buffer[i];
+      }
+#endif
+    }
+
+    //
+    // assignment
+    //
+
+    m128&
+    operator =(float const* ptr){
+      data = _mm_load_ps(ptr);
+      return *this;
+    }
+
+    m128&
+    operator =(unaligned<float> const& u){
+      data = _mm_loadu_ps(u.ptr);
+      return *this;
+    }
+
+    m128&
+    operator =(stream<float> const& s){
+      data =_mm_castsi128_ps(_mm_stream_load_si128((__m128i*)s.ptr));
+      return *this;
+    }
+
+    m128&
+    operator =( m128 const& input ){      
+      data = input.data;
+      return *this;
+    }
+
+    //
+    // compound assignment
+    //
+    m128&
+    operator +=(m128 const& b){
+      data = _mm_add_ps( data, b.data );
+      return *this;
+    }
+
+    m128&
+    operator -=(m128 const& b){
+      data = _mm_sub_ps( data, b.data );
+      return *this;
+    }
+
+    m128&
+    operator *=(m128 const& b ){
+      data = _mm_mul_ps( data, b.data );
+      return *this;
+    }
+
+    m128&
+    operator /=(m128 const& b ){
+      data = _mm_div_ps( data, b.data );
+      return *this;
+    }
+
+    //
+    // unary operators
+    //
+    friend m128
+    neg(m128 const& a){
+      return -1.0f*a;
+    }
+    
+    friend m128
+    abs(m128 const& a){
+      return cond( a < 0.0f, -1.0f*a, a);
+    }
+
+    friend m128
+    ceil(m128 const& a){
+      m128 result;
+      result.data = _mm_ceil_ps(a.data);
+      return result;
+    }
+
+    friend m128
+    floor(m128 const& a){
+      m128 result;
+      result.data = _mm_floor_ps(a.data);
+      return result;
+    }
+
+    friend m128
+    round(m128 const& a){
+      m128 result;
+      result.data = _mm_round_ps(a.data, _MM_FROUND_TO_NEAREST_INT);
+      return result;
+    }
+
+    friend m128
+    sqrt(m128 const& a){
+      m128 result;
+      result.data = _mm_sqrt_ps(a.data);
+      return result;
+    }
+
+    friend m128
+    rsqrt(m128 const& a){
+      m128 result;
+      result.data = _mm_rsqrt_ps(a.data);
+      return result;
+    }
+
+    friend m128
+    rcp(m128 const& a){
+      m128 result;
+      result.data = _mm_rcp_ps(a.data);
+      return result;
+    }
+
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for normal finite a.  Zero, subnormal and
+     * non-finite values are left to the caller.
+     */
+    friend m128
+    frexp( m128 const& a, m128& e ){
+      __m128i bits = _mm_castps_si128( a.data );
+      __m128i biased = _mm_srli_epi32( _mm_slli_epi32( bits, 1 ), 24 );
+      e.data = _mm_cvtepi32_ps( _mm_sub_epi32( biased, _mm_set1_epi32( 126 )));
+      m128 result;
+      result.data = _mm_castsi128_ps( _mm_or_si128( _mm_and_si128( bits, _mm_set1_epi32( int( 0x807FFFFF ))),
+						    _mm_set1_epi32( 0x3F000000 )));
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e in [-252, 254]
+     *
+     * The power is applied in two halves, so that the result
+     * overflows to infinity and underflows gradually as std::ldexp.
+     */
+    friend m128
+    ldexp( m128 const& a, m128 const& e ){
+      __m128i n = _mm_cvtps_epi32( e.data );
+      __m128i half = _mm_srai_epi32( n, 1 );
+      m128 result;
+      result.data = _mm_mul_ps( _mm_mul_ps( a.data, power( half )), power( _mm_sub_epi32( n, half )));
+      return result;
+    }
+
+    //
+    // binary operators
+    //
+    friend m128
+    operator +( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_add_ps(a.data, b.data);
+      return result;
+    }
+    
+    friend m128
+    operator -( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_sub_ps(a.data, b.data);
+      return result;
+    }
+
+    friend m128
+    operator *( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_mul_ps(a.data, b.data);
+      return result;
+    }
+
+    friend m128
+    operator /( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_div_ps(a.data, b.data);
+      return result;
+    }
+
+    friend m128
+    min( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_min_ps( a.data, b.data );
+      return result;
+    }
+
+    friend m128
+    max( m128 const& a, m128 const& b ){
+      m128 result;
+      result.data = _mm_max_ps( a.data, b.data );
+      return result;
+    }
+
+    //
+    // trinary arithmetic
+    //
+    // Without FMA the product is rounded before the addition
+    //
+
+    friend m128
+    fma( m128 const& a, m128 const& b, m128 const& c ){
+      m128 result;
+#if defined(__FMA__)
+      result.data = _mm_fmadd_ps(a.data, b.data, c.data);
+#else
+      result.data = _mm_add_ps(_mm_mul_ps(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    friend m128
+    fms( m128 const& a, m128 const& b, m128 const& c ){
+      m128 result;
+#if defined(__FMA__)
+      result.data = _mm_fmsub_ps(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_ps(_mm_mul_ps(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    friend m128
+    fnma( m128 const& a, m128 const& b, m128 const& c ){
+      m128 result;
+#if defined(__FMA__)
+      result.data = _mm_fnmadd_ps(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_ps(c.data, _mm_mul_ps(a.data, b.data));
+#endif
+      return result;
+    }
+
+    friend m128
+    fnms( m128 const& a, m128 const& b, m128 const& c ){
+      m128 result;
+#if defined(__FMA__)
+      result.data = _mm_fnmsub_ps(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_mul_ps(a.data, b.data), c.data));
+#endif
+      return result;
+    }
+
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
+    friend m128
+    fmaddsub( m128 const& a, m128 const& b, m128 const& c ){
+      m128 result;
+#if defined(__FMA__)
+      result.data = _mm_fmaddsub_ps(a.data, b.data, c.data);
+#else
+      result.data = _mm_addsub_ps(_mm_mul_ps(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m128
+    add( m128_mask const& m, m128 const& a, m128 const& b ){
+      return cond( m, a + b, a );
+    }
+
+    friend m128
+    subtract( m128_mask const& m, m128 const& a, m128 const& b ){
+      return cond( m, a - b, a );
+    }
+
+    friend m128
+    multiply( m128_mask const& m, m128 const& a, m128 const& b ){
+      return cond( m, a*b, a );
+    }
+
+    friend m128
+    divide( m128_mask const& m, m128 const& a, m128 const& b ){
+      return cond( m, a/b, a );
+    }
+
+    //
+    // binary comparison
+    //
+    friend m128_mask
+    operator ==( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmpeq_ps( a.data, b.data ) );
+    }
+
+    friend m128_mask
+    operator !=( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmpneq_ps( a.data, b.data ) );
+    }
+
+    friend m128_mask
+    operator <( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmplt_ps( a.data, b.data ) );
+    }
+
+    friend m128_mask
+    operator <=( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmple_ps( a.data, b.data ) );
+    }
+
+    
+    friend m128_mask
+    operator >( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmpgt_ps( a.data, b.data ) );
+    }
+
+    
+    friend m128_mask
+    operator >=( m128 const& a, m128 const& b ){
+      return m128_mask( _mm_cmpge_ps( a.data, b.data ) );
+    }
+
+    //
+    // conditional
+    //
+    friend m128
+    cond( m128_mask const& test, m128 const& pass, m128 const& fail ){
+      m128 result;
+      result.data = _mm_blendv_ps( fail.data, pass.data, test.bits() );
+      return result;
+    }
+    
+    //
+    // horizontal reductions
+    //
+    friend float
+    hsum( m128 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_add_ps( x, y ); });
+    }
+
+    friend float
+    hprod( m128 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_mul_ps( x, y ); });
+    }
+
+    friend float
+    hmin( m128 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_min_ps( x, y ); });
+    }
+
+    friend float
+    hmax( m128 const& a ){
+      return reduce( a.data, []( __m128 x, __m128 y ){ return _mm_max_ps( x, y ); });
+    }
+
+    friend float
+    dot( m128 const& a, m128 const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m128 const& a ){
+      return find_first( a == m128( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m128 const& a ){
+      return find_first( a == m128( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type I0, size_type I1, size_type I2, size_type I3 >
+    static m128
+    shuffle( m128 const& a ){
+      static_assert( I0 < 4 && I1 < 4 && I2 < 4 && I3 < 4, "lane index out of range" );
+      m128 result;
+      result.data = _mm_shuffle_ps( a.data, a.data, _MM_SHUFFLE( I3, I2, I1, I0 ));
+      return result;
+    }
+
+    template< size_type I0, size_type I1, size_type I2, size_type I3 >
+    static m128
+    shuffle( m128 const& a, m128 const& b ){
+      static_assert( I0 < 8 && I1 < 8 && I2 < 8 && I3 < 8, "lane index out of range" );
+      constexpr array<size_type,4> index{{ I0, I1, I2, I3 }};
+      m128 result;
+      if constexpr ( Lanes::all_below( index, 4 )){
+	result = shuffle<I0,I1,I2,I3>( a );
+      }
+      else if constexpr ( Lanes::none_below( index, 4 )){
+	result = shuffle<I0-4,I1-4,I2-4,I3-4>( b );
+      }
+      else if constexpr ( Lanes::pairs_in_blocks( index, 4, 4 )){
+	constexpr int immediate = Lanes::immediate4( index );
+	result.data = _mm_shuffle_ps( a.data, b.data, immediate );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, 4, false )){
+	result.data = _mm_unpacklo_ps( a.data, b.data );
+      }
+      else if constexpr ( Lanes::unpacks_in_blocks( index, 4, 4, true )){
+	result.data = _mm_unpackhi_ps( a.data, b.data );
+      }
+      else {
+	m128 from_a = shuffle<I0%4,I1%4,I2%4,I3%4>( a );
+	m128 from_b = shuffle<I0%4,I1%4,I2%4,I3%4>( b );
+	constexpr int immediate = int( Lanes::beyond( index, 4 ));
+	result.data = _mm_blend_ps( from_a.data, from_b.data, immediate );
+      }
+      return result;
+    }
+
+  private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines the upper half of the remaining lanes with
+     * the lower half, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static float
+    reduce( __m128 x, Op op ){
+      x = op( x, _mm_movehl_ps( x, x ));
+      x = op( x, _mm_shuffle_ps( x, x, _MM_SHUFFLE( 1, 1, 1, 1 )));
+      return _mm_cvtss_f32( x );
+    }
+
+    /** 2 to the power n, for n in [-126, 127] */
+    static __m128
+    power( __m128i n ){
+      return _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32( n, _mm_set1_epi32( 127 )), 23 ));
+    }
+
+    __m128 data;
+  }; // end of class m128
+  
+} // end of namespace SSE
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<float,sse_tag>
+  {
+    using type = SSE::m128;
+  };
+  
+} // end of namespace ShortVector::Private
+
+#endif // ! defined M128_HPP_INCLUDED_1240584093714852019
@@ -0,0 +1,655 @@
+#ifndef M128D_HPP_INCLUDED_3345207721548136587
+#define M128D_HPP_INCLUDED_3345207721548136587 1
+
+//
+// ... Intrinsics
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/sse/utility.hpp>
+
+namespace SSE
+{
+
+  /** The result of comparing two m128d registers
+   *
+   * Each lane holds the raw bits of the comparison, all set where it
+   * holds and all clear elsewhere, as used by the blend instructions.
+   */
+  class m128d_mask
+  {
+  public:
+
+    static constexpr size_type extent = 2;
+
+    m128d_mask(){}
+
+    m128d_mask( m128d_mask const& input ){
+      data = input.data;
+    }
+
+    explicit
+    m128d_mask( __m128d input ){
+      data = input;
+    }
+
+    explicit
+    m128d_mask( bool input ){
+      data = input ? all_set() : _mm_setzero_pd();
+    }
+
+    m128d_mask&
+    operator =( m128d_mask const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    /** The raw bits of the comparison */
+    __m128d
+    bits() const { return data; }
+
+    /** The mask of the first n lanes */
+    static m128d_mask
+    first( size_type n ){
+      return m128d_mask( _mm_castsi128_pd( leading_bytes( n*size_type( sizeof(double) ))));
+    }
+
+    bool
+    operator []( size_type i ) const {
+      return ( _mm_movemask_pd( data ) >> i ) & 1;
+    }
+
+    friend m128d_mask
+    operator &( m128d_mask const& a, m128d_mask const& b ){
+      return m128d_mask( _mm_and_pd( a.data, b.data ));
+    }
+
+    friend m128d_mask
+    operator |( m128d_mask const& a, m128d_mask const& b ){
+      return m128d_mask( _mm_or_pd( a.data, b.data ));
+    }
+
+    friend m128d_mask
+    operator ^( m128d_mask const& a, m128d_mask const& b ){
+      return m128d_mask( _mm_xor_pd( a.data, b.data ));
+    }
+
+    friend m128d_mask
+    operator ~( m128d_mask const& a ){
+      return m128d_mask( _mm_xor_pd( a.data, all_set()));
+    }
+
+    friend bool
+    any( m128d_mask const& a ){
+      return _mm_movemask_pd( a.data ) != 0;
+    }
+
+    friend bool
+    all( m128d_mask const& a ){
+      return _mm_movemask_pd( a.data ) == 0x3;
+    }
+
+    friend bool
+    none( m128d_mask const& a ){
+      return _mm_movemask_pd( a.data ) == 0;
+    }
+
+    /** The index of the first lane of the mask, or extent if there is none */
+    friend size_type
+    find_first( m128d_mask const& a ){
+      int lanes = _mm_movemask_pd( a.data );
+      return lanes ? __builtin_ctz( lanes ) : extent;
+    }
+
+    friend size_type
+    popcount( m128d_mask const& a ){
+      return __builtin_popcount( _mm_movemask_pd( a.data ));
+    }
+
+  private:
+
+    static __m128d
+    all_set(){
+      return _mm_castsi128_pd( _mm_set1_epi32( -1 ));
+    }
+
+    __m128d data;
+  }; // end of class m128d_mask
+
+  class m128d
+  {
+  public:
+
+    using value_type = double;
+
+    static constexpr size_type extent = 2;
+
+    /** The bits of precision of the estimates rsqrt and rcp, which
+     *  divide exactly without AVX512VL */
+#if defined(__AVX512VL__)
+    static constexpr size_type estimate_precision = 14;
+#else
+    static constexpr size_type estimate_precision = 53;
+#endif
+
+    using mask_type = m128d_mask;
+
+    //
+    // construction
+    //
+    m128d()
+    {}
+
+    m128d(m128d const& input ){
+      data = input.data;
+    }
+    
+    m128d(double input){
+      data = _mm_set1_pd(input);
+    }
+    
+    m128d(double const* ptr ){
+      data = _mm_load_pd(ptr);
+    }
+
+    m128d(unaligned<double> const& u ){
+      data = _mm_loadu_pd(u.ptr);
+    }
+
+    m128d(stream<double> const& s){
+      data =_mm_castsi128_pd(_mm_stream_load_si128((__m128i*)s.ptr));
+    }
+
+    /** Load the lanes of the mask from an address of any alignment
+     *
+     * The other lanes are zero and their addresses are not read.
+     */
+    m128d( double const* ptr, m128d_mask const& m ){
+#if defined(__AVX__)
+      data = _mm_maskload_pd( ptr, _mm_castpd_si128( m.bits()));
+#else
+      alignas(16) double buffer[ extent ] = {};
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) buffer[i] = ptr[i];
+      }
+      data = _mm_load_pd( buffer );
+#endif
+    }
+
+    //
+    // store
+    //
+
+    void
+    store( double* ptr ) const {
+      _mm_store_pd( ptr, data );
+    }
+
+    void
+    store( unaligned<double> const& u ) const {
+      _mm_storeu_pd( u.ptr, data );
+    }
+
+    void
+    store( stream<double> const& s ) const {
+      _mm_stream_pd( s.ptr, data );
+    }
+
+    /** Store the lanes of the mask to an address of any alignment
+     *
+     * The addresses of the other lanes are neither read nor written.
+     */
+    void
+    store( double* ptr, m128d_mask const& m ) const {
+#if defined(__AVX__)
+      _mm_maskstore_pd( ptr, _mm_castpd_si128( m.bits()), data );
+#else
+      alignas(16) double buffer[ extent ];
+      _mm_store_pd( buffer, data );
+      for( size_type i = 0; i < extent; ++i ){
+	if( m[i] ) ptr[i] = buffer[i];
+      }
+#endif
+    }
+
+    //
+    // assignment
+    //
+
+    m128d&
+    operator =( m128d const& input ){
+      data = input.data;
+      return *this;
+    }
+
+    m128d&
+    operator =( double const* ptr ){
+      data = _mm_load_pd( ptr );
+      return *this;
+    }
+
+    m128d&
+    operator =(unaligned<double> const& u){
+      data = _mm_loadu_pd( u.ptr );
+      return *this;
+    }
+
+    m128d&
+    operator =(stream<double> const& s){
+      data = _mm_castsi128_pd(_mm_stream_load_si128((__m128i*)s.ptr));
+      return *this;
+    }
+
+    //
+    // compound assignment
+    // 
+    m128d&
+    operator +=( m128d const& b ){
+      data = _mm_add_pd(data, b.data);
+      return *this;
+    }
+
+    m128d&
+    operator -=( m128d const& b ){
+      data = _mm_sub_pd(data, b.data);
+      return *this;
+    }
+
+    m128d&
+    operator *=( m128d const& b ){
+      data = _mm_mul_pd(data, b.data);
+      return *this;
+    }
+
+    m128d&
+    operator /=( m128d const& b ){
+      data = _mm_div_pd(data, b.data);
+      return *this;
+    }
+
+    //
+    // unary operators
+    //
+    friend m128d
+    neg(m128d const& a){
+      return -1.0*a;
+    }
+    
+    friend m128d
+    abs(m128d const& a){
+      return cond(a < 0.0, neg(a), a);
+    }
+
+    friend m128d
+    ceil(m128d const& a){
+      m128d result;
+      result.data = _mm_ceil_pd(a.data);
+      return result;
+    }
+
+    friend m128d
+    floor(m128d const& a){
+      m128d result;
+      result.data = _mm_floor_pd(a.data);
+      return result;
+    }
+
+    friend m128d
+    round(m128d const& a){
+      m128d result;
+      result.data = _mm_round_pd(a.data, _MM_FROUND_TO_NEAREST_INT);
+      return result;
+    }
+
+    friend m128d
+    sqrt(m128d const& a){
+      m128d result;
+      result.data = _mm_sqrt_pd(a.data);
+      return result;
+    }
+
+    friend m128d
+    rsqrt(m128d const& a){
+#if defined(__AVX512VL__)
+      m128d result;
+      result.data = _mm_rsqrt14_pd(a.data);
+      return result;
+#else
+      return 1.0/sqrt(a);
+#endif
+    }
+
+    friend m128d
+    rcp(m128d const& a){
+#if defined(__AVX512VL__)
+      m128d result;
+      result.data = _mm_rcp14_pd(a.data);
+      return result;
+#else
+      return 1.0/a;
+#endif
+    }
+
+    //
+    // exponent manipulation
+    //
+
+    /** The significand of a in [0.5,1), storing its exponent in e
+     *
+     * As std::frexp for normal finite a.  Zero, subnormal and
+     * non-finite values are left to the caller.  The exponent is
+     * converted by placing it in the significand of 2^52.
+     */
+    friend m128d
+    frexp( m128d const& a, m128d& e ){
+      __m128i bits = _mm_castpd_si128( a.data );
+      __m128i biased = _mm_srli_epi64( _mm_slli_epi64( bits, 1 ), 53 );
+      e.data = _mm_sub_pd( _mm_castsi128_pd( _mm_or_si128( biased, _mm_set1_epi64x( 0x4330000000000000ll ))),
+			   _mm_set1_pd( 4503599627370496.0 + 1022.0 ));
+      m128d result;
+      result.data = _mm_castsi128_pd( _mm_or_si128( _mm_and_si128( bits, _mm_set1_epi64x( 0x800FFFFFFFFFFFFFll )),
+						     _mm_set1_epi64x( 0x3FE0000000000000ll )));
+      return result;
+    }
+
+    /** a times 2 to the power e, for integral e in [-2044, 2046]
+     *
+     * The power is applied in two halves, so that the result
+     * overflows to infinity and underflows gradually as std::ldexp.
+     */
+    friend m128d
+    ldexp( m128d const& a, m128d const& e ){
+      __m128i n = _mm_cvtpd_epi32( e.data );
+      __m128i half = _mm_srai_epi32( n, 1 );
+      m128d result;
+      result.data = _mm_mul_pd( _mm_mul_pd( a.data, power( half )), power( _mm_sub_epi32( n, half )));
+      return result;
+    }
+    
+    //
+    // binary arithmetic operators
+    // 
+    friend m128d
+    operator +(m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_add_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m128d
+    operator -(m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_sub_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m128d
+    operator *(m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_mul_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m128d
+    operator /(m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_div_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m128d
+    min( m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_min_pd( a.data, b.data );
+      return result;
+    }
+
+    friend m128d
+    max( m128d const& a, m128d const& b ){
+      m128d result;
+      result.data = _mm_max_pd( a.data, b.data );
+      return result;
+    }
+    
+    //
+    // trinary arithmetic
+    //
+    // Without FMA the product is rounded before the addition
+    //
+    
+    friend m128d
+    fma(m128d const& a, m128d const& b, m128d const& c){
+      m128d result;
+#if defined(__FMA__)
+      result.data = _mm_fmadd_pd(a.data, b.data, c.data);
+#else
+      result.data = _mm_add_pd(_mm_mul_pd(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    friend m128d
+    fms(m128d const& a, m128d const& b, m128d const& c){
+      m128d result;
+#if defined(__FMA__)
+      result.data = _mm_fmsub_pd(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_pd(_mm_mul_pd(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    friend m128d
+    fnma(m128d const& a, m128d const& b, m128d const& c){
+      m128d result;
+#if defined(__FMA__)
+      result.data = _mm_fnmadd_pd(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_pd(c.data, _mm_mul_pd(a.data, b.data));
+#endif
+      return result;
+    }
+
+    friend m128d
+    fnms(m128d const& a, m128d const& b, m128d const& c){
+      m128d result;
+#if defined(__FMA__)
+      result.data = _mm_fnmsub_pd(a.data, b.data, c.data);
+#else
+      result.data = _mm_sub_pd(_mm_setzero_pd(), _mm_add_pd(_mm_mul_pd(a.data, b.data), c.data));
+#endif
+      return result;
+    }
+
+    /** a*b - c in the even lanes and a*b + c in the odd ones */
+    friend m128d
+    fmaddsub(m128d const& a, m128d const& b, m128d const& c){
+      m128d result;
+#if defined(__FMA__)
+      result.data = _mm_fmaddsub_pd(a.data, b.data, c.data);
+#else
+      result.data = _mm_addsub_pd(_mm_mul_pd(a.data, b.data), c.data);
+#endif
+      return result;
+    }
+
+    //
+    // masked arithmetic, on the lanes of the mask, keeping a elsewhere
+    //
+    friend m128d
+    add( m128d_mask const& m, m128d const& a, m128d const& b ){
+      return cond( m, a + b, a );
+    }
+
+    friend m128d
+    subtract( m128d_mask const& m, m128d const& a, m128d const& b ){
+      return cond( m, a - b, a );
+    }
+
+    friend m128d
+    multiply( m128d_mask const& m, m128d const& a, m128d const& b ){
+      return cond( m, a*b, a );
+    }
+
+    friend m128d
+    divide( m128d_mask const& m, m128d const& a, m128d const& b ){
+      return cond( m, a/b, a );
+    }
+
+    //
+    // binary comparison
+    //
+    friend m128d_mask
+    operator ==( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmpeq_pd( a.data, b.data ) );
+    }
+
+    friend m128d_mask
+    operator !=( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmpneq_pd( a.data, b.data ) );
+    }
+    
+    friend m128d_mask
+    operator <( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmplt_pd( a.data, b.data ) );
+    }
+
+    friend m128d_mask
+    operator <=( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmple_pd( a.data, b.data ) );
+    }
+
+    friend m128d_mask
+    operator >( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmpgt_pd( a.data, b.data ) );
+    }
+    
+    friend m128d_mask
+    operator >=( m128d const& a, m128d const& b ){
+      return m128d_mask( _mm_cmpge_pd( a.data, b.data ) );
+    }
+
+    //
+    // conditional
+    //
+    friend m128d
+    cond( m128d_mask const& test, m128d const& pass, m128d const& fail ){
+      m128d result;
+      result.data = _mm_blendv_pd( fail.data, pass.data, test.bits() );
+      return result;
+    }
+    
+    //
+    // horizontal reductions
+    //
+    friend double
+    hsum( m128d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_add_pd( x, y ); });
+    }
+
+    friend double
+    hprod( m128d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_mul_pd( x, y ); });
+    }
+
+    friend double
+    hmin( m128d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_min_pd( x, y ); });
+    }
+
+    friend double
+    hmax( m128d const& a ){
+      return reduce( a.data, []( __m128d x, __m128d y ){ return _mm_max_pd( x, y ); });
+    }
+
+    friend double
+    dot( m128d const& a, m128d const& b ){
+      return hsum( a*b );
+    }
+
+    /** The index of the first lane holding the smallest value */
+    friend size_type
+    argmin( m128d const& a ){
+      return find_first( a == m128d( hmin( a )));
+    }
+
+    /** The index of the first lane holding the largest value */
+    friend size_type
+    argmax( m128d const& a ){
+      return find_first( a == m128d( hmax( a )));
+    }
+
+    //
+    // rearrangement, lane k of the result is lane I_k of the
+    // source, or of the concatenation of the two sources
+    //
+    template< size_type I0, size_type I1 >
+    static m128d
+    shuffle( m128d const& a ){
+      static_assert( I0 < 2 && I1 < 2, "lane index out of range" );
+      m128d result;
+      result.data = _mm_shuffle_pd( a.data, a.data, int( I0 | I1 << 1 ));
+      return result;
+    }
+
+    template< size_type I0, size_type I1 >
+    static m128d
+    shuffle( m128d const& a, m128d const& b ){
+      static_assert( I0 < 4 && I1 < 4, "lane index out of range" );
+      m128d result;
+      if constexpr ( I0 < 2 && I1 < 2 ){
+	result = shuffle<I0,I1>( a );
+      }
+      else if constexpr ( I0 >= 2 && I1 >= 2 ){
+	result = shuffle<I0-2,I1-2>( b );
+      }
+      else if constexpr ( I0 < 2 ){
+	result.data = _mm_shuffle_pd( a.data, b.data, int( I0 | ( I1-2 ) << 1 ));
+      }
+      else {
+	result.data = _mm_shuffle_pd( b.data, a.data, int(( I0-2 ) | I1 << 1 ));
+      }
+      return result;
+    }
+
+  private:
+
+    /** Combine the lanes with op by a tree of shuffles
+     *
+     * Each step combines the upper half of the remaining lanes with
+     * the lower half, so that the first lane ends with the result.
+     */
+    template< typename Op >
+    static double
+    reduce( __m128d x, Op op ){
+      x = op( x, _mm_unpackhi_pd( x, x ));
+      return _mm_cvtsd_f64( x );
+    }
+
+    /** 2 to the power of the 32 bit n, for n in [-1022, 1023] */
+    static __m128d
+    power( __m128i n ){
+      __m128i biased = _mm_add_epi64( _mm_cvtepi32_epi64( n ), _mm_set1_epi64x( 1023 ));
+      return _mm_castsi128_pd( _mm_slli_epi64( biased, 52 ));
+    }
+
+    __m128d data;
+  }; // end of class m128d
+  
+  
+} // end of namespace SSE
+
+namespace ShortVector::Private
+{
+  template<>
+  struct Register<double,sse_tag>
+  {
+    using type = SSE::m128d;
+  };
+  
+} // end of namespace ShortVector::Private
+
+#endif // ! defined M128D_HPP_INCLUDED_3345207721548136587
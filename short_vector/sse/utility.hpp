@@ -0,0 +1,42 @@
+#ifndef SSE_UTILITY_HPP_INCLUDED_2707785305317542711
+#define SSE_UTILITY_HPP_INCLUDED_2707785305317542711 1
+
+//
+// ... Intrinsics header files
+//
+#include <immintrin.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/utility.hpp>
+
+namespace SSE
+{
+
+  using ShortVector::size_type;
+
+  using ShortVector::Private::unaligned;
+  using ShortVector::Private::stream;
+
+  using ShortVector::array;
+
+  namespace Lanes = ShortVector::Private::Lanes;
+
+  struct unaligned_tag{};
+  struct stream_tag{};
+  
+  /** All ones in the first n bytes of a register and zero elsewhere
+   *
+   * The masks of the first lanes of every lane width are made from it.
+   */
+  inline __m128i
+  leading_bytes( size_type n ){
+    n = n < 0 ? 0 : n < 16 ? n : 16;
+    __m128i index = _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+    return _mm_cmpgt_epi8( _mm_set1_epi8( char( n )), index );
+  }
+
+} // end of namespace SSE
+
+#endif // ! defined SSE_UTILITY_HPP_INCLUDED_2707785305317542711
@@ -1,14 +1,235 @@
 #ifndef UTILITY_HPP_INCLUDED_622411775145667441
 #define UTILITY_HPP_INCLUDED_622411775145667441 1
 
+//
+// ... Short Vector header files
+//
+#include <short_vector/import.hpp>
+
 namespace ShortVector::Private
 {
 
+  /** An address aligned for the instruction set */
+  template< typename T >
+  struct aligned{ T* ptr; };
+
   template< typename T >
   struct unaligned{ T* ptr; };
 
   template< typename T >
   struct stream { T* ptr; };
+
+
+  /** A tag indicating automatic vectorization */
+  struct auto_tag{};
+
+  /** A tag indicating explicit vectorization with SSE intrinsics */
+  struct sse_tag{};
+
+  /** A tag indicating explicit vectorization with AVX intrinsics */
+  struct avx_tag{};
+
+  /** A tag indicating explicit vectorization with AVX-512 intrinsics */
+  struct avx512_tag{};
+
+
+  /** A tag indicating the estimates of the instructions, unrefined */
+  struct fast_tag{};
+
+  /** A tag indicating estimates refined to within a few units in the
+   *  last place */
+  struct balanced_tag{};
+
+  /** A tag indicating the results of division and square roots */
+  struct ieee_tag{};
+
+  /** The accuracy of the approximate functions of short vectors with
+   *  the instructions indicated by Inst
+   *
+   * Specialize it to trade the accuracy of a whole instruction set at
+   * once; the functions also take an accuracy at each call.
+   */
+  template< typename Inst >
+  struct Accuracy
+  {
+    using type = ieee_tag;
+  };
+
+
+  /** The register type holding values of type T for the instructions
+   *  indicated by Inst.
+   *
+   * The primary template is left undefined; the header for each
+   * instruction set specializes it for the value types it supports.
+   * The last parameter allows a specialization to be selected by a
+   * constraint on T.
+   */
+  template< typename T, typename Inst, typename = void >
+  struct Register;
+
+  /** The conversions between the lane types of the registers for the
+   *  instructions indicated by Inst
+   *
+   * Left undefined like Register, and specialized by the conversion
+   * header of each instruction set that has them.
+   */
+  template< typename Inst >
+  struct Conversions;
+
+
+  /** Compile time tests and encodings of lane indices
+   *
+   * The register types choose the instruction of a shuffle from the
+   * pattern of its lane indices: lane k of the result is lane index[k]
+   * of the source, or of the concatenation of two sources.
+   */
+  namespace Lanes
+  {
+    /** True if every lane reads a lane of its own block of b lanes */
+    template< std::size_t N >
+    constexpr bool
+    within_blocks( array<size_type,N> index, size_type b ){
+      for( size_type k = 0; k < size_type(N); ++k ){
+	if( index[k]/b != k/b ) return false;
+      }
+      return true;
+    }
+
+    /** True if every lane reads a lane of its own block of b lanes,
+     *  following the same pattern in every block */
+    template< std::size_t N >
+    constexpr bool
+    repeats_in_blocks( array<size_type,N> index, size_type b ){
+      for( size_type k = 0; k < size_type(N); ++k ){
+	if( index[k]/b != k/b || index[k]%b != index[k%b] ) return false;
+      }
+      return true;
+    }
+
+    /** True if every block of b lanes is a whole block of the source */
+    template< std::size_t N >
+    constexpr bool
+    moves_blocks( array<size_type,N> index, size_type b ){
+      for( size_type k = 0; k < size_type(N); ++k ){
+	size_type first = index[ k - k%b ];
+	if( first%b != 0 || index[k] != first + k%b ) return false;
+      }
+      return true;
+    }
+
+    /** True if the first half of every block of b lanes reads the
+     *  same block of the first source, and the second half the same
+     *  block of the second, n lanes further, with the same pattern in
+     *  every block */
+    template< std::size_t N >
+    constexpr bool
+    pairs_in_blocks( array<size_type,N> index, size_type b, size_type n ){
+      for( size_type k = 0; k < size_type(N); ++k ){
+	size_type offset = k%b < b/2 ? 0 : n;
+	if( index[k] < offset || ( index[k] - offset )/b != k/b
+	    || index[k]%b != index[k%b]%b ) return false;
+      }
+      return true;
+    }
+
+    /** True if every block of b lanes alternates the lanes of the
+     *  first, or if high of the second, half of the same block of
+     *  the first source and of the second, n lanes further */
+    template< std::size_t N >
+    constexpr bool
+    unpacks_in_blocks( array<size_type,N> index, size_type b, size_type n, bool high ){
+      for( size_type k = 0; k < size_type(N); ++k ){
+	size_type lane = k - k%b + ( high ? b/2 : 0 ) + k%b/2;
+	if( index[k] != lane + k%2*n ) return false;
+      }
+      return true;
+    }
+
+    /** True if every lane reads the first n lanes */
+    template< std::size_t N >
+    constexpr bool
+    all_below( array<size_type,N> index, size_type n ){
+      for( auto i : index ){
+	if( i >= n ) return false;
+      }
+      return true;
+    }
+
+    /** True if every lane reads beyond the first n lanes */
+    template< std::size_t N >
+    constexpr bool
+    none_below( array<size_type,N> index, size_type n ){
+      for( auto i : index ){
+	if( i < n ) return false;
+      }
+      return true;
+    }
+
+    /** The bits of the lanes reading beyond the first n lanes */
+    template< std::size_t N >
+    constexpr unsigned long long
+    beyond( array<size_type,N> index, size_type n ){
+      unsigned long long result = 0;
+      for( size_type k = 0; k < size_type(N); ++k ){
+	result |= (unsigned long long)( index[k] >= n ) << k;
+      }
+      return result;
+    }
+
+    /** The bits of the lanes reading outside their own block of b lanes */
+    template< std::size_t N >
+    constexpr unsigned long long
+    crossing( array<size_type,N> index, size_type b ){
+      unsigned long long result = 0;
+      for( size_type k = 0; k < size_type(N); ++k ){
+	result |= (unsigned long long)( index[k]/b != k/b ) << k;
+      }
+      return result;
+    }
+
+    /** Lanes of all ones where the bits are set and zero elsewhere */
+    template< typename T, std::size_t N >
+    constexpr array<T,N>
+    expand( unsigned long long bits ){
+      array<T,N> result{};
+      for( size_type k = 0; k < size_type(N); ++k ){
+	result[k] = ( bits >> k ) & 1 ? T(~T(0)) : T(0);
+      }
+      return result;
+    }
+
+    /** Two bits per lane selecting among blocks of 4 lanes, from the
+     *  first four lanes, as the immediate of the shuffles */
+    template< std::size_t N >
+    constexpr int
+    immediate4( array<size_type,N> index ){
+      return int( index[0]%4 | index[1]%4 << 2 | index[2]%4 << 4 | index[3]%4 << 6 );
+    }
+
+    /** One bit per lane selecting among pairs of lanes */
+    template< std::size_t N >
+    constexpr int
+    immediate2( array<size_type,N> index ){
+      int result = 0;
+      for( size_type k = 0; k < size_type(N); ++k ){
+	result |= int( index[k]%2 ) << k;
+      }
+      return result;
+    }
+
+    /** The controls of the byte shuffles moving lanes of s bytes
+     *  within blocks of 16 bytes */
+    template< std::size_t Bytes, std::size_t N >
+    constexpr array<char,Bytes>
+    byte_control( array<size_type,N> index, size_type s ){
+      array<char,Bytes> result{};
+      for( size_type k = 0; k < size_type(Bytes); ++k ){
+	result[k] = char(( index[k/s]*s + k%s )%16 );
+      }
+      return result;
+    }
+
+  } // end of namespace Lanes
   
 } // end of namespace ShortVector::Private
 
@@ -0,0 +1,311 @@
+#ifndef VIEW_HPP_INCLUDED_7310564982217843016
+#define VIEW_HPP_INCLUDED_7310564982217843016 1
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+
+/** Short vectors of values that are not contiguous
+ *
+ * A Strided_view refers to the values ptr[k*stride], such as a column
+ * of a row major matrix or a field of an array of structures, and an
+ * Indexed_view to the values base[indices[k]].  Both are read and
+ * written with gathers and scatters where the instruction set has
+ * them, with the explicit vectorizations requiring the header of the
+ * integer registers, and one value at a time otherwise.  A stride of
+ * 1 reads and writes contiguous values.
+ */
+namespace ShortVector::Private
+{
+
+  /** The stride of a Strided_view given at run time */
+  constexpr size_type dynamic_stride = std::numeric_limits<size_type>::min();
+
+  namespace Views
+  {
+    /** Signed integers of the width of values of type T, as the gathers
+     *  of the registers take them */
+    template< typename T >
+    using Index = std::conditional_t<sizeof(T) == 4,std::int32_t,std::int64_t>;
+
+    /** True where short vectors of values of type T gather and scatter */
+    template< typename T, typename Inst >
+    constexpr bool gathers = is_same_v<Inst,auto_tag>
+      || (( is_same_v<Inst,avx_tag> || is_same_v<Inst,avx512_tag> ) && std::is_floating_point_v<T> );
+
+    /** The arithmetic of views of type D, as short vectors of type V */
+    template< typename D, typename V >
+    class Arithmetic
+    {
+    public:
+      using value_type = typename V::value_type;
+
+      D&
+      operator +=( V const& input ){
+	return self() = V( self()) + input;
+      }
+
+      D&
+      operator -=( V const& input ){
+	return self() = V( self()) - input;
+      }
+
+      D&
+      operator *=( V const& input ){
+	return self() = V( self()) * input;
+      }
+
+      D&
+      operator /=( V const& input ){
+	return self() = V( self()) / input;
+      }
+
+      friend V
+      operator +( D const& a, D const& b ){ return V( a ) + V( b ); }
+
+      friend V
+      operator +( D const& a, V const& b ){ return V( a ) + b; }
+
+      friend V
+      operator +( V const& a, D const& b ){ return a + V( b ); }
+
+      friend V
+      operator +( D const& a, value_type b ){ return V( a ) + b; }
+
+      friend V
+      operator +( value_type a, D const& b ){ return a + V( b ); }
+
+      friend V
+      operator -( D const& a, D const& b ){ return V( a ) - V( b ); }
+
+      friend V
+      operator -( D const& a, V const& b ){ return V( a ) - b; }
+
+      friend V
+      operator -( V const& a, D const& b ){ return a - V( b ); }
+
+      friend V
+      operator -( D const& a, value_type b ){ return V( a ) - b; }
+
+      friend V
+      operator -( value_type a, D const& b ){ return a - V( b ); }
+
+      friend V
+      operator *( D const& a, D const& b ){ return V( a ) * V( b ); }
+
+      friend V
+      operator *( D const& a, V const& b ){ return V( a ) * b; }
+
+      friend V
+      operator *( V const& a, D const& b ){ return a * V( b ); }
+
+      friend V
+      operator *( D const& a, value_type b ){ return V( a ) * b; }
+
+      friend V
+      operator *( value_type a, D const& b ){ return a * V( b ); }
+
+      friend V
+      operator /( D const& a, D const& b ){ return V( a ) / V( b ); }
+
+      friend V
+      operator /( D const& a, V const& b ){ return V( a ) / b; }
+
+      friend V
+      operator /( V const& a, D const& b ){ return a / V( b ); }
+
+      friend V
+      operator /( D const& a, value_type b ){ return V( a ) / b; }
+
+      friend V
+      operator /( value_type a, D const& b ){ return a / V( b ); }
+
+    private:
+      D&
+      self(){ return static_cast<D&>( *this ); }
+    }; // end of class Arithmetic
+
+  } // end of namespace Views
+
+
+  /** A short vector of the values ptr[k*stride]
+   *
+   * The stride is Stride, or given to the constructor if Stride is
+   * dynamic_stride, and may be negative.
+   */
+  template< typename T, size_type N, size_type Align, typename Inst = auto_tag,
+	    size_type Stride = dynamic_stride >
+  class Strided_view : public Views::Arithmetic<Strided_view<T,N,Align,Inst,Stride>,Short_vector<T,N,Align,Inst>>
+  {
+  public:
+    using value_type = T;
+    using pointer = value_type*;
+
+    using short_vector = Short_vector<T,N,Align,Inst>;
+    using index_type = Views::Index<T>;
+    using index_vector = Short_vector<index_type,N,Align,
+				      std::conditional_t<Views::gathers<T,Inst>,Inst,auto_tag>>;
+
+    static constexpr size_type extent = N;
+
+    Strided_view() = delete;
+
+    Strided_view( Strided_view const& input ) = default;
+
+    explicit
+    Strided_view( pointer input, size_type stride = Stride ) : ptr( input ), step( stride )
+    {
+      assert( input );
+      assert( stride != dynamic_stride );
+      assert( Stride == dynamic_stride || stride == Stride );
+    }
+
+    size_type
+    stride() const {
+      if constexpr( Stride == dynamic_stride ){
+	return step;
+      } else {
+	return Stride;
+      }
+    }
+
+    /** The offsets of the values from the first */
+    index_vector
+    indices() const {
+      return index_vector( [s = stride()]( size_type k ){ return index_type( k*s ); }, function_tag{});
+    }
+
+    Strided_view&
+    operator =( Strided_view const& input ){
+      store( input.load());
+      return *this;
+    }
+
+    Strided_view&
+    operator =( short_vector const& input ){
+      store( input );
+      return *this;
+    }
+
+    Strided_view&
+    operator =( value_type input ){
+      store( short_vector( input ));
+      return *this;
+    }
+
+    operator short_vector() const {
+      return load();
+    }
+
+  private:
+    short_vector
+    load() const {
+      if( stride() == 1 ){
+	return short_vector::load( unaligned<value_type>{ ptr });
+      }
+      if constexpr( Views::gathers<T,Inst> ){
+	return short_vector::gather( ptr, indices());
+      } else {
+	return short_vector( [p = ptr, s = stride()]( size_type k ){ return p[ k*s ]; }, function_tag{});
+      }
+    }
+
+    void
+    store( short_vector const& xs ) const {
+      if( stride() == 1 ){
+	xs.store( unaligned<value_type>{ ptr });
+      } else if constexpr( Views::gathers<T,Inst> ){
+	xs.scatter( ptr, indices());
+      } else {
+	for( size_type k = 0; k < extent; ++k ){
+	  ptr[ k*stride() ] = xs[k];
+	}
+      }
+    }
+
+    pointer ptr;
+    size_type step;
+  }; // end of class Strided_view
+
+
+  /** A short vector of the values base[indices[k]]
+   *
+   * Where indices repeat, assignments store the last of their values.
+   */
+  template< typename T, size_type N, size_type Align, typename Inst = auto_tag >
+  class Indexed_view : public Views::Arithmetic<Indexed_view<T,N,Align,Inst>,Short_vector<T,N,Align,Inst>>
+  {
+  public:
+    using value_type = T;
+    using pointer = value_type*;
+
+    using short_vector = Short_vector<T,N,Align,Inst>;
+    using index_type = Views::Index<T>;
+    using index_vector = Short_vector<index_type,N,Align,
+				      std::conditional_t<Views::gathers<T,Inst>,Inst,auto_tag>>;
+
+    static constexpr size_type extent = N;
+
+    Indexed_view() = delete;
+
+    Indexed_view( Indexed_view const& input ) = default;
+
+    Indexed_view( pointer input, index_vector const& index ) : ptr( input ), offsets( index )
+    {
+      assert( input );
+    }
+
+    index_vector const&
+    indices() const { return offsets; }
+
+    Indexed_view&
+    operator =( Indexed_view const& input ){
+      store( input.load());
+      return *this;
+    }
+
+    Indexed_view&
+    operator =( short_vector const& input ){
+      store( input );
+      return *this;
+    }
+
+    Indexed_view&
+    operator =( value_type input ){
+      store( short_vector( input ));
+      return *this;
+    }
+
+    operator short_vector() const {
+      return load();
+    }
+
+  private:
+    short_vector
+    load() const {
+      if constexpr( Views::gathers<T,Inst> ){
+	return short_vector::gather( ptr, offsets );
+      } else {
+	return short_vector( [this]( size_type k ){ return ptr[ offsets[k] ]; }, function_tag{});
+      }
+    }
+
+    void
+    store( short_vector const& xs ) const {
+      if constexpr( Views::gathers<T,Inst> ){
+	xs.scatter( ptr, offsets );
+      } else {
+	for( size_type k = 0; k < extent; ++k ){
+	  ptr[ offsets[k] ] = xs[k];
+	}
+      }
+    }
+
+    pointer ptr;
+    index_vector offsets;
+  }; // end of class Indexed_view
+
+} // end of namespace ShortVector::Private
+
+#endif // ! defined VIEW_HPP_INCLUDED_7310564982217843016
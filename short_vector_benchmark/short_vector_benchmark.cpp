@@ -0,0 +1,137 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//
+// ... System header files
+//
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//
+// ... Benchmark header files
+//
+#include <benchmark/benchmark.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/dispatch.hpp>
+#include <short_vector/array.hpp>
+
+#include "short_vector_benchmark.hpp"
+
+/*
+ * The kernels of short_vector_benchmark.hpp, for every instruction set
+ * built and supported by the host, with short vectors of automatic and
+ * explicit vectorization, over arrays from the first level cache to
+ * main memory.  Besides the time, each benchmark reports the floating
+ * point operations per second (FLOP, printed as G/s for GFLOP/s) and the
+ * bytes read and written per cycle of the time stamp counter, and
+ * --benchmark_out=<file> --benchmark_out_format=json records the
+ * results for comparison between releases.
+ */
+namespace
+{
+  using ShortVector::size_type;
+  using ShortVector::Private::Dispatch;
+  using ShortVector::Private::Isa;
+  using ShortVector::Private::Short_vector_array;
+  using ShortVector::Private::isa_count;
+  using ShortVector::Private::max_isa;
+  using ShortVector::Private::name;
+  using ShortVector::Private::supported;
+
+  using ShortVectorBenchmark::Kernel;
+  using ShortVectorBenchmark::kernel_count;
+  using ShortVectorBenchmark::kernel_traits;
+
+  template< typename T >
+  using Kernel_function = double( int, T const*, T*, std::ptrdiff_t );
+
+  Dispatch<Kernel_function<float>> const float_auto SHORT_VECTOR_KERNELS(ShortVectorBenchmark, float_auto);
+  Dispatch<Kernel_function<float>> const float_explicit SHORT_VECTOR_KERNELS(ShortVectorBenchmark, float_explicit);
+  Dispatch<Kernel_function<double>> const double_auto SHORT_VECTOR_KERNELS(ShortVectorBenchmark, double_auto);
+  Dispatch<Kernel_function<double>> const double_explicit SHORT_VECTOR_KERNELS(ShortVectorBenchmark, double_explicit);
+
+  /** The smallest and largest arrays, in values, from well within the
+   *  first level cache to well beyond the last */
+  constexpr std::int64_t smallest = std::int64_t( 1 ) << 9;
+  constexpr std::int64_t largest = std::int64_t( 1 ) << 24;
+
+  inline std::uint64_t
+  cycles(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+
+  template< typename T >
+  void
+  run( benchmark::State& state, Kernel_function<T>* kernel, Kernel k ){
+    size_type n = size_type( state.range( 0 ));
+    Short_vector_array<T,64/sizeof(T),64> arrays( n, 2 );
+    T* x = arrays.data( 0 );
+    T* y = arrays.data( 1 );
+    for( size_type i = 0; i < n; ++i ){
+      x[i] = T( 1 ) + T( i%13 )/T( 16 );
+      y[i] = T( 1 ) - T( i%7 )/T( 16 );
+    }
+
+    std::uint64_t start = cycles();
+    for( auto _ : state ){
+      benchmark::DoNotOptimize( kernel( int( k ), x, y, n ));
+      benchmark::ClobberMemory();
+    }
+    std::uint64_t elapsed = cycles() - start;
+
+    auto const& traits = kernel_traits[ int( k ) ];
+    double values = double( n )*double( state.iterations());
+    double bytes = values*traits.arrays*double( sizeof(T));
+    state.SetBytesProcessed( std::int64_t( bytes ));
+    state.counters[ "FLOP" ] = benchmark::Counter( values*traits.flops, benchmark::Counter::kIsRate );
+    if( elapsed > 0 ){
+      state.counters[ "bytes/cycle" ] = bytes/double( elapsed );
+    }
+  }
+
+  template< typename T >
+  void
+  add( char const* type, char const* backend, Isa isa, Dispatch<Kernel_function<T>> const& variants ){
+    Kernel_function<T>* kernel = variants.kernel( isa );
+    if( ! kernel ) return;
+    for( size_type k = 0; k < kernel_count; ++k ){
+      std::string label = std::string( kernel_traits[k].name ) + "/" + type + "/" + name( isa ) + "/" + backend;
+      benchmark::RegisterBenchmark( label.c_str(), run<T>, kernel, Kernel( k ))
+	->RangeMultiplier( 8 )
+	->Range( smallest, largest );
+    }
+  }
+
+} // end of namespace
+
+int
+main( int argc, char** argv ){
+  for( int i = 0; i < isa_count; ++i ){
+    Isa isa = Isa( i );
+    if( isa > max_isa() || ! supported( isa )) continue;
+    add<float>( "float", "auto", isa, float_auto );
+    add<double>( "double", "auto", isa, double_auto );
+    if( isa != Isa::scalar ){
+      add<float>( "float", "explicit", isa, float_explicit );
+      add<double>( "double", "explicit", isa, double_explicit );
+    }
+  }
+
+  benchmark::Initialize( &argc, argv );
+  if( benchmark::ReportUnrecognizedArguments( argc, argv )) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef SHORT_VECTOR_BENCHMARK_HPP_INCLUDED_6629017453380215571
+#define SHORT_VECTOR_BENCHMARK_HPP_INCLUDED_6629017453380215571 1
+
+//
+// ... Standard header files
+//
+#include <cstddef>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/dispatch.hpp>
+
+namespace ShortVectorBenchmark
+{
+  using ShortVector::size_type;
+
+  /** The kernels run by every backend, on arrays x and y of n values */
+  enum class Kernel : int
+  {
+    axpy,	// y = a*x + y
+    dot,	// the sum of x*y
+    fma_chain,	// y = p( x ), p a polynomial of degree 16, by Horner
+    cond,	// y = x < y ? x*y : x - y
+    sqrt,	// y = sqrt( x )
+    rsqrt,	// y = 1/sqrt( x ), the estimate alone
+    rsqrt_balanced,	// y = 1/sqrt( x ), refined from the estimate
+    stream_copy	// y = x, bypassing the caches
+  };
+
+  constexpr size_type kernel_count = 8;
+
+  struct Kernel_traits
+  {
+    char const* name;
+    double flops;	// per value
+    double arrays;	// arrays read or written, per value
+  };
+
+  constexpr Kernel_traits kernel_traits[ kernel_count ] = {
+    { "axpy", 2.0, 3.0 },
+    { "dot", 2.0, 2.0 },
+    { "fma_chain", 32.0, 2.0 },
+    { "cond", 2.0, 3.0 },
+    { "sqrt", 1.0, 2.0 },
+    { "rsqrt", 2.0, 2.0 },
+    { "rsqrt_balanced", 2.0, 2.0 },
+    { "stream_copy", 0.0, 2.0 }
+  };
+
+} // end of namespace ShortVectorBenchmark
+
+/*
+ * Each kernel runs one of the kernels above with short vectors of one
+ * register of automatic vectorization (auto) or of the explicit
+ * vectorization of its instruction set (explicit), returning the result
+ * of dot and zero otherwise.  The arrays are aligned to cache lines and
+ * n is a multiple of the lanes of the widest registers.
+ */
+SHORT_VECTOR_DECLARE_KERNEL(ShortVectorBenchmark, float_auto, double(int, float const*, float*, std::ptrdiff_t))
+SHORT_VECTOR_DECLARE_KERNEL(ShortVectorBenchmark, float_explicit, double(int, float const*, float*, std::ptrdiff_t))
+SHORT_VECTOR_DECLARE_KERNEL(ShortVectorBenchmark, double_auto, double(int, double const*, double*, std::ptrdiff_t))
+SHORT_VECTOR_DECLARE_KERNEL(ShortVectorBenchmark, double_explicit, double(int, double const*, double*, std::ptrdiff_t))
+
+#endif // ! defined SHORT_VECTOR_BENCHMARK_HPP_INCLUDED_6629017453380215571
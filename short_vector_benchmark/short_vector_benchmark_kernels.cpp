@@ -0,0 +1,142 @@
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/dispatch.hpp>
+#include <short_vector/algorithm.hpp>
+#include <short_vector/math.hpp>
+
+//
+// Only the registers of the instruction set being compiled are
+// included, since the wider ones cannot be passed by value without it.
+//
+#if defined(__AVX512F__)
+#include <short_vector/avx512/m512.hpp>
+#include <short_vector/avx512/m512d.hpp>
+#elif defined(__AVX2__)
+#include <short_vector/avx/m256.hpp>
+#include <short_vector/avx/m256d.hpp>
+#elif defined(__SSE4_1__)
+#include <short_vector/sse/m128.hpp>
+#include <short_vector/sse/m128d.hpp>
+#endif
+
+#include "short_vector_benchmark.hpp"
+
+//
+// This source is compiled once for each instruction set, with
+// SHORT_VECTOR_ISA naming the instruction set, by short_vector_dispatch.
+//
+namespace ShortVectorBenchmark::SHORT_VECTOR_ISA
+{
+  using ShortVector::Private::Short_vector;
+  using ShortVector::Private::auto_tag;
+  using ShortVector::Private::kernel_inst;
+  using ShortVector::Private::kernel_register_size;
+  using ShortVector::Private::stream;
+  using ShortVector::Private::inverse_sqrt;
+  using ShortVector::Private::fast_tag;
+  using ShortVector::Private::balanced_tag;
+
+  /** A short vector of one register of values of type T */
+  template< typename T, typename Inst >
+  using Vector = Short_vector<T,kernel_register_size/size_type( sizeof(T)),kernel_register_size,Inst>;
+
+  template< typename V >
+  double
+  run( Kernel kernel, typename V::value_type const* x, typename V::value_type* y, size_type n ){
+    using T = typename V::value_type;
+    constexpr size_type lanes = V::extent;
+
+    switch( kernel ){
+    case Kernel::axpy: {
+      V a( T( 0.5 ));
+      for( size_type i = 0; i < n; i += lanes ){
+	fma( a, V::load( x + i ), V::load( y + i )).store( y + i );
+      }
+      return 0.0;
+    }
+    case Kernel::dot: {
+      V s0( T( 0 )), s1( T( 0 )), s2( T( 0 )), s3( T( 0 ));
+      size_type i = 0;
+      for( ; i + 4*lanes <= n; i += 4*lanes ){
+	s0 = fma( V::load( x + i ), V::load( y + i ), s0 );
+	s1 = fma( V::load( x + i + lanes ), V::load( y + i + lanes ), s1 );
+	s2 = fma( V::load( x + i + 2*lanes ), V::load( y + i + 2*lanes ), s2 );
+	s3 = fma( V::load( x + i + 3*lanes ), V::load( y + i + 3*lanes ), s3 );
+      }
+      for( ; i < n; i += lanes ){
+	s0 = fma( V::load( x + i ), V::load( y + i ), s0 );
+      }
+      V s = ( s0 + s1 ) + ( s2 + s3 );
+      double result = 0.0;
+      for( size_type k = 0; k < lanes; ++k ){
+	result += double( s[k] );
+      }
+      return result;
+    }
+    case Kernel::fma_chain: {
+      V c( T( 0.25 ));
+      for( size_type i = 0; i < n; i += lanes ){
+	V xs = V::load( x + i );
+	V p = c;
+	for( int k = 0; k < 16; ++k ){
+	  p = fma( p, xs, c );
+	}
+	p.store( y + i );
+      }
+      return 0.0;
+    }
+    case Kernel::cond:
+      for( size_type i = 0; i < n; i += lanes ){
+	V xs = V::load( x + i );
+	V ys = V::load( y + i );
+	cond( xs < ys, xs*ys, xs - ys ).store( y + i );
+      }
+      return 0.0;
+    case Kernel::sqrt:
+      for( size_type i = 0; i < n; i += lanes ){
+	sqrt( V::load( x + i )).store( y + i );
+      }
+      return 0.0;
+    case Kernel::rsqrt:
+      for( size_type i = 0; i < n; i += lanes ){
+	inverse_sqrt<fast_tag>( V::load( x + i )).store( y + i );
+      }
+      return 0.0;
+    case Kernel::rsqrt_balanced:
+      for( size_type i = 0; i < n; i += lanes ){
+	inverse_sqrt<balanced_tag>( V::load( x + i )).store( y + i );
+      }
+      return 0.0;
+    case Kernel::stream_copy:
+      for( size_type i = 0; i < n; i += lanes ){
+	V::load( x + i ).store( stream<T>{ y + i });
+      }
+      ShortVector::Private::Algorithms::fence();
+      return 0.0;
+    }
+    return 0.0;
+  }
+
+  SHORT_VECTOR_KERNEL double
+  float_auto( int kernel, float const* x, float* y, std::ptrdiff_t n ){
+    return run<Vector<float,auto_tag>>( Kernel( kernel ), x, y, n );
+  }
+
+  SHORT_VECTOR_KERNEL double
+  float_explicit( int kernel, float const* x, float* y, std::ptrdiff_t n ){
+    return run<Vector<float,kernel_inst>>( Kernel( kernel ), x, y, n );
+  }
+
+  SHORT_VECTOR_KERNEL double
+  double_auto( int kernel, double const* x, double* y, std::ptrdiff_t n ){
+    return run<Vector<double,auto_tag>>( Kernel( kernel ), x, y, n );
+  }
+
+  SHORT_VECTOR_KERNEL double
+  double_explicit( int kernel, double const* x, double* y, std::ptrdiff_t n ){
+    return run<Vector<double,kernel_inst>>( Kernel( kernel ), x, y, n );
+  }
+
+} // end of namespace ShortVectorBenchmark::SHORT_VECTOR_ISA
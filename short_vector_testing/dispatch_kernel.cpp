@@ -0,0 +1,59 @@
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/dispatch.hpp>
+
+//
+// Only the registers of the instruction set being compiled are
+// included, since the wider ones cannot be passed by value without it.
+//
+#if defined(__AVX512F__)
+#include <short_vector/avx512/m512.hpp>
+#elif defined(__AVX2__)
+#include <short_vector/avx/m256.hpp>
+#elif defined(__SSE4_1__)
+#include <short_vector/sse/m128.hpp>
+#endif
+
+//
+// This source is compiled once for each instruction set, with
+// SHORT_VECTOR_ISA naming the instruction set, by short_vector_dispatch.
+//
+namespace DispatchTest::SHORT_VECTOR_ISA
+{
+  using ShortVector::size_type;
+  using ShortVector::Private::function_tag;
+  using ShortVector::Private::Short_vector;
+  using ShortVector::Private::kernel_inst;
+  using ShortVector::Private::kernel_register_size;
+
+  constexpr size_type lanes = kernel_register_size/sizeof(float);
+
+  using vector_type = Short_vector<float,lanes,kernel_register_size,kernel_inst>;
+
+  SHORT_VECTOR_KERNEL int
+  isa(){
+    return int(ShortVector::Private::kernel_isa);
+  }
+
+  SHORT_VECTOR_KERNEL float
+  dot( float const* xs, float const* ys, size_type n ){
+    vector_type acc(0.0f);
+    size_type i = 0;
+    for( ; i + lanes <= n; i += lanes ){
+      acc = fma(vector_type([=](auto j){ return xs[i+j]; }, function_tag{}),
+		vector_type([=](auto j){ return ys[i+j]; }, function_tag{}),
+		acc);
+    }
+    float result = 0.0f;
+    for( size_type j = 0; j < lanes; ++j ){
+      result += acc[j];
+    }
+    for( ; i < n; ++i ){
+      result += xs[i]*ys[i];
+    }
+    return result;
+  }
+  
+} // end of namespace DispatchTest::SHORT_VECTOR_ISA
@@ -0,0 +1,77 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <vector>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/dispatch.hpp>
+
+SHORT_VECTOR_DECLARE_KERNEL(DispatchTest, isa, int())
+SHORT_VECTOR_DECLARE_KERNEL(DispatchTest, dot, float(float const*, float const*, std::ptrdiff_t))
+
+namespace 
+{
+  using ShortVector::Private::Isa;
+  using ShortVector::Private::Dispatch;
+  using ShortVector::Private::host_isa;
+  using ShortVector::Private::max_isa;
+  using ShortVector::Private::supported;
+  using ShortVector::Private::isa_count;
+
+  Dispatch<int()> const isa_kernel SHORT_VECTOR_KERNELS(DispatchTest, isa);
+  Dispatch<float(float const*, float const*, std::ptrdiff_t)> const dot_kernel SHORT_VECTOR_KERNELS(DispatchTest, dot);
+  
+
+  TEST( dispatch, host )
+  {
+    EXPECT_TRUE( supported( Isa::scalar ));
+    EXPECT_TRUE( supported( host_isa()));
+    EXPECT_LE( max_isa(), host_isa());
+    
+  } // end of test dispatch.host
+
+
+  TEST( dispatch, selection )
+  {
+    EXPECT_LE( isa_kernel.isa(), max_isa());
+    EXPECT_NE( isa_kernel.kernel( isa_kernel.isa()), nullptr );
+    EXPECT_EQ( isa_kernel(), int( isa_kernel.isa()));
+
+    for( int i = int( isa_kernel.isa()) + 1; i <= int( max_isa()); ++i ){
+      EXPECT_EQ( isa_kernel.kernel( Isa(i)), nullptr );
+    }
+    
+  } // end of test dispatch.selection
+
+  
+  TEST( dispatch, variants )
+  {
+    std::vector<float> xs(103);
+    std::vector<float> ys(103);
+    float expected = 0.0f;
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      xs[i] = float(i % 7);
+      ys[i] = float(i % 5);
+      expected += xs[i]*ys[i];
+    }
+
+    EXPECT_EQ( dot_kernel( xs.data(), ys.data(), xs.size()), expected );
+
+    for( int i = 0; i < isa_count; ++i ){
+      if( dot_kernel.kernel( Isa(i)) && supported( Isa(i))){
+	EXPECT_EQ( dot_kernel.kernel( Isa(i))( xs.data(), ys.data(), xs.size()), expected );
+	EXPECT_EQ( isa_kernel.kernel( Isa(i))(), i );
+      }
+    }
+    
+  } // end of test dispatch.variants
+  
+} // end of namespace
@@ -0,0 +1,357 @@
+#ifndef INTEGER_REGISTER_TEST_HPP_INCLUDED_7315904268127743051
+#define INTEGER_REGISTER_TEST_HPP_INCLUDED_7315904268127743051 1
+
+/** Typed tests of an integer lane register
+ *
+ * The including file declares, in an anonymous namespace, the register
+ * as the alias template integer_register<T>, its width in bytes as
+ * register_width, and its unaligned pointer wrapper as unaligned<T>.
+ */
+
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <utility>
+#include <algorithm>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+namespace 
+{
+  using size_type = std::ptrdiff_t;
+  using std::array;
+
+  template< typename T >
+  struct alignas(register_width) lanes : array<T,register_width/sizeof(T)>
+  {};
+
+  /** Scattered values of T, including negative values for signed T */
+  template< typename T >
+  lanes<T>
+  values( unsigned long long seed ){
+    lanes<T> result;
+    for( std::size_t i = 0; i < result.size(); ++i ){
+      result[i] = T(( (i + seed)*0x9E3779B97F4A7C15ull ) >> (64 - 8*sizeof(T)));
+    }
+    return result;
+  }
+
+  template< typename T >
+  lanes<T>
+  stored( integer_register<T> const& a ){
+    lanes<T> result;
+    a.store( result.data());
+    return result;
+  }
+
+  template< typename T >
+  T
+  wrap_add( T x, T y ){
+    return T( (unsigned long long)( x ) + (unsigned long long)( y ));
+  }
+
+  template< typename T >
+  T
+  wrap_subtract( T x, T y ){
+    return T( (unsigned long long)( x ) - (unsigned long long)( y ));
+  }
+
+  template< typename T >
+  T
+  wrap_multiply( T x, T y ){
+    return T( (unsigned long long)( x )*(unsigned long long)( y ));
+  }
+
+  template< typename R, std::size_t ... I >
+  R
+  swap_pairs( R const& a, std::index_sequence<I...> ){
+    return R::template shuffle<size_type( I^1 ) ...>( a );
+  }
+
+  template< typename T >
+  class integer_register_test : public ::testing::Test
+  {};
+
+  using lane_types = ::testing::Types<
+    std::int8_t, std::uint8_t, std::int16_t, std::uint16_t,
+    std::int32_t, std::uint32_t, std::int64_t, std::uint64_t>;
+
+  TYPED_TEST_SUITE(integer_register_test, lane_types);
+
+
+  TYPED_TEST(integer_register_test, load_store)
+  {
+    using T = TypeParam;
+    constexpr std::size_t n = register_width/sizeof(T);
+    auto xs = values<T>(1);
+    alignas(register_width) T ys[ 2*n ], out[ 2*n ] = {};
+    for( std::size_t i = 0; i < 2*n; ++i ){
+      ys[i] = wrap_add( xs[ i%n ], T( i/n ));
+    }
+
+    EXPECT_EQ( stored( integer_register<T>( xs.data())), xs );
+    
+    integer_register<T>( unaligned<T>{ ys + 1 }).store( unaligned<T>{ out + 1 });
+    EXPECT_EQ( out[0], T(0) );
+    for( std::size_t i = 1; i <= n; ++i ){
+      EXPECT_EQ( out[i], ys[i] );
+    }
+    for( std::size_t i = n + 1; i < 2*n; ++i ){
+      EXPECT_EQ( out[i], T(0) );
+    }
+    
+  } // end of test integer_register_test.load_store
+
+
+  TYPED_TEST(integer_register_test, arithmetic)
+  {
+    using T = TypeParam;
+    auto xs = values<T>(1);
+    auto ys = values<T>(7);
+    integer_register<T> x( xs.data()), y( ys.data());
+
+    auto sum = stored( x + y );
+    auto difference = stored( x - y );
+    auto product = stored( x * y );
+    auto minimum = stored( min( x, y ));
+    auto maximum = stored( max( x, y ));
+
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      EXPECT_EQ( sum[i], wrap_add( xs[i], ys[i] ));
+      EXPECT_EQ( difference[i], wrap_subtract( xs[i], ys[i] ));
+      EXPECT_EQ( product[i], wrap_multiply( xs[i], ys[i] ));
+      EXPECT_EQ( minimum[i], std::min( xs[i], ys[i] ));
+      EXPECT_EQ( maximum[i], std::max( xs[i], ys[i] ));
+    }
+    
+  } // end of test integer_register_test.arithmetic
+
+
+  TYPED_TEST(integer_register_test, bitwise)
+  {
+    using T = TypeParam;
+    auto xs = values<T>(2);
+    auto ys = values<T>(5);
+    integer_register<T> x( xs.data()), y( ys.data());
+
+    auto conjunction = stored( x & y );
+    auto disjunction = stored( x | y );
+    auto exclusive = stored( x ^ y );
+    auto complement = stored( ~x );
+    auto difference = stored( andnot( x, y ));
+
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      EXPECT_EQ( conjunction[i], T( xs[i] & ys[i] ));
+      EXPECT_EQ( disjunction[i], T( xs[i] | ys[i] ));
+      EXPECT_EQ( exclusive[i], T( xs[i] ^ ys[i] ));
+      EXPECT_EQ( complement[i], T( ~xs[i] ));
+      EXPECT_EQ( difference[i], T( ~xs[i] & ys[i] ));
+    }
+    
+  } // end of test integer_register_test.bitwise
+
+
+  TYPED_TEST(integer_register_test, shifts)
+  {
+    using T = TypeParam;
+    auto xs = values<T>(3);
+    integer_register<T> x( xs.data());
+
+    for( int n = 0; n < int( 8*sizeof(T)); n += 3 ){
+      auto left = stored( x << n );
+      auto right = stored( x >> n );
+      for( std::size_t i = 0; i < xs.size(); ++i ){
+	EXPECT_EQ( left[i], T( (unsigned long long)( xs[i] ) << n ));
+	EXPECT_EQ( right[i], T( xs[i] >> n ));
+      }
+    }
+
+    // counts past the lane shift every bit out
+    for( int n : { int( 8*sizeof(T)), int( 8*sizeof(T)) + 1, 100 } ){
+      auto left = stored( x << n );
+      auto right = stored( x >> n );
+      for( std::size_t i = 0; i < xs.size(); ++i ){
+	EXPECT_EQ( left[i], T(0) );
+	EXPECT_EQ( right[i], xs[i] < T(0) ? T(-1) : T(0) );
+      }
+    }
+    
+  } // end of test integer_register_test.shifts
+
+
+  TYPED_TEST(integer_register_test, comparison)
+  {
+    using T = TypeParam;
+    auto xs = values<T>(1);
+    auto ys = values<T>(4);
+    ys[0] = xs[0];
+    integer_register<T> x( xs.data()), y( ys.data());
+
+    auto eq = x == y;
+    auto ne = x != y;
+    auto lt = x < y;
+    auto le = x <= y;
+    auto gt = x > y;
+    auto ge = x >= y;
+    auto selected = stored( cond( x < y, x, y ));
+    auto magnitude = stored( abs( x ));
+
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      EXPECT_EQ( eq[i], xs[i] == ys[i] );
+      EXPECT_EQ( ne[i], xs[i] != ys[i] );
+      EXPECT_EQ( lt[i], xs[i] < ys[i] );
+      EXPECT_EQ( le[i], xs[i] <= ys[i] );
+      EXPECT_EQ( gt[i], xs[i] > ys[i] );
+      EXPECT_EQ( ge[i], xs[i] >= ys[i] );
+      EXPECT_EQ( selected[i], std::min( xs[i], ys[i] ));
+      EXPECT_EQ( magnitude[i], xs[i] < T(0) ? wrap_subtract( T(0), xs[i] ) : xs[i]);
+    }
+    
+    size_type below = 0;
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      below += xs[i] < ys[i];
+    }
+    EXPECT_EQ( popcount( lt ), below );
+    EXPECT_TRUE( none( lt & ge ));
+    EXPECT_TRUE( all( lt | ge ));
+    EXPECT_TRUE( all( ~eq ^ eq ));
+    EXPECT_TRUE( none( ~( le | gt )));
+    EXPECT_TRUE( any( eq ));
+    EXPECT_FALSE( all( eq ));
+    
+  } // end of test integer_register_test.comparison
+
+
+
+  TYPED_TEST(integer_register_test, masked)
+  {
+    using T = TypeParam;
+    constexpr size_type n = integer_register<T>::extent;
+    auto xs = values<T>(5);
+    lanes<T> out;
+    out.fill( T(7) );
+
+    auto tail = integer_register<T>::mask_type::first( n - 3 );
+    EXPECT_EQ( popcount( tail ), n - 3 );
+
+    integer_register<T> x( xs.data() + 3, tail );
+    auto loaded = stored( x );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( loaded[i], i < n - 3 ? xs[i+3] : T(0) );
+    }
+
+    add( tail, x, integer_register<T>( T(1) )).store( out.data() + 3, tail );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], i < 3 ? T(7) : wrap_add( xs[i], T(1) ));
+    }
+
+    auto scaled = stored( multiply( tail, integer_register<T>( T(3) ), x ));
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( scaled[i], i < n - 3 ? wrap_multiply( T(3), xs[i+3] ) : T(3) );
+    }
+    
+  } // end of test integer_register_test.masked
+
+  TYPED_TEST(integer_register_test, gather_scatter)
+  {
+    using T = TypeParam;
+    using I = typename integer_register<T>::index_type;
+    constexpr size_type n = integer_register<T>::extent;
+    auto xs = values<T>(9);
+    lanes<I> offsets;
+    for( size_type i = 0; i < n; ++i ){
+      offsets[i] = I(( 5*i + 2 ) % n );
+    }
+    integer_register<I> index( offsets.data());
+
+    auto gathered = stored( integer_register<T>::gather( xs.data(), index ));
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( gathered[i], xs[ offsets[i] ] );
+    }
+
+    auto m = integer_register<T>::mask_type::first( n/2 );
+    auto masked = stored( integer_register<T>::gather( xs.data(), index, m ));
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( masked[i], i < n/2 ? xs[ offsets[i] ] : T(0) );
+    }
+
+    lanes<T> out;
+    out.fill( T(7) );
+    integer_register<T>( xs.data()).scatter( out.data(), index, m );
+    for( size_type i = 0; i < n; ++i ){
+      auto k = std::find( offsets.begin(), offsets.begin() + n/2, I(i) ) - offsets.begin();
+      EXPECT_EQ( out[i], k < n/2 ? xs[k] : T(7) );
+    }
+
+    integer_register<T>( xs.data()).scatter( out.data(), index );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[ offsets[i] ], xs[i] );
+    }
+    
+  } // end of test integer_register_test.gather_scatter
+
+
+  TYPED_TEST(integer_register_test, reductions)
+  {
+    using T = TypeParam;
+    auto xs = values<T>(9);
+    auto ys = values<T>(2);
+    integer_register<T> x( xs.data()), y( ys.data());
+
+    T sum = 0, product = 1, inner = 0;
+    for( std::size_t i = 0; i < xs.size(); ++i ){
+      sum = wrap_add( sum, xs[i] );
+      product = wrap_multiply( product, xs[i] );
+      inner = wrap_add( inner, wrap_multiply( xs[i], ys[i] ));
+    }
+
+    EXPECT_EQ( hsum( x ), sum );
+    EXPECT_EQ( hprod( x ), product );
+    EXPECT_EQ( dot( x, y ), inner );
+    EXPECT_EQ( hmin( x ), *std::min_element( xs.begin(), xs.end()));
+    EXPECT_EQ( hmax( x ), *std::max_element( xs.begin(), xs.end()));
+    EXPECT_EQ( argmin( x ), std::min_element( xs.begin(), xs.end()) - xs.begin());
+    EXPECT_EQ( argmax( x ), std::max_element( xs.begin(), xs.end()) - xs.begin());
+    
+  } // end of test integer_register_test.reductions
+
+  TYPED_TEST(integer_register_test, shuffle)
+  {
+    using T = TypeParam;
+    using R = integer_register<T>;
+    using ShortVector::Private::rotate;
+    using ShortVector::Private::reverse;
+    using ShortVector::Private::broadcast;
+    using ShortVector::Private::interleave_low;
+    using ShortVector::Private::interleave_high;
+    constexpr size_type n = R::extent;
+    auto xs = values<T>(1);
+    auto ys = values<T>(2);
+    R x( xs.data()), y( ys.data());
+
+    auto swapped = stored( swap_pairs( x, std::make_index_sequence<n>{} ));
+    auto rotated = stored( rotate<3>( x ));
+    auto reversed = stored( reverse( x ));
+    auto broadcasted = stored( broadcast<1>( x ));
+    auto low = stored( interleave_low( x, y ));
+    auto high = stored( interleave_high( x, y ));
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( swapped[i], xs[ i^1 ] );
+      EXPECT_EQ( rotated[i], xs[ (i + 3) % n ] );
+      EXPECT_EQ( reversed[i], xs[ n - 1 - i ] );
+      EXPECT_EQ( broadcasted[i], xs[1] );
+      EXPECT_EQ( low[i], i % 2 ? ys[ i/2 ] : xs[ i/2 ] );
+      EXPECT_EQ( high[i], i % 2 ? ys[ n/2 + i/2 ] : xs[ n/2 + i/2 ] );
+    }
+    
+  } // end of test integer_register_test.shuffle
+
+} // end of namespace 
+
+#endif // ! defined INTEGER_REGISTER_TEST_HPP_INCLUDED_7315904268127743051
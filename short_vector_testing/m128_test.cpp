@@ -0,0 +1,463 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/sse/m128.hpp>
+#include <short_vector/sse/m128d.hpp>
+
+namespace 
+{
+  using size_type = std::ptrdiff_t;
+  using std::array;
+
+  using SSE::m128;
+  using SSE::m128d;
+  using SSE::unaligned;
+  using SSE::stream;
+
+  using ShortVector::Private::function_tag;
+  using ShortVector::Private::sse_tag;
+  using ShortVector::Private::Short_vector;
+
+  template< typename T, size_t N, size_t A >
+  struct alignas(A) aligned_array : array<T,N>
+  {};
+  
+
+  TEST(m128, construction_pointer)
+  {
+    aligned_array<float,4,16> xs{{1.0f,2.0f,3.0f,4.0f}};
+    aligned_array<float,4,16> out;
+
+    m128( xs.data()).store( out.data());
+
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(xs[i], out[i]);
+    }
+
+  } // end of test m128.construction_pointer
+
+
+  TEST(m128, unaligned_and_stream)
+  {
+    aligned_array<float,8,16> xs{{1.0f,2.0f,3.0f,4.0f,5.0f,6.0f,7.0f,8.0f}};
+    aligned_array<float,8,16> out{};
+
+    m128( unaligned<float>{ xs.data() + 1 }).store( unaligned<float>{ out.data() + 1 });
+    m128( stream<float>{ xs.data() + 4 }).store( stream<float>{ out.data() + 4 });
+    _mm_sfence();
+
+    EXPECT_EQ(out[0], 0.0f);
+    for(size_type i = 1; i < 8; ++i){
+      EXPECT_EQ(out[i], xs[i]);
+    }
+
+  } // end of test m128.unaligned_and_stream
+
+  
+  TEST(m128, arithmetic)
+  {
+    aligned_array<float,4,16> xs{{1.0f,2.0f,3.0f,4.0f}};
+    aligned_array<float,4,16> out;
+
+    ((m128( xs.data()) + 3.5f)*m128( xs.data()) - 1.0f/m128( xs.data())).store( out.data());
+
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_FLOAT_EQ(out[i], (xs[i] + 3.5f)*xs[i] - 1.0f/xs[i]);
+    }
+    
+  } // end of test m128.arithmetic
+
+
+  TEST(m128, fma)
+  {
+    aligned_array<float,4,16> as{{1.0f,2.0f,3.0f,4.0f}};
+    aligned_array<float,4,16> bs{{2.0f,3.0f,4.0f,5.0f}};
+    aligned_array<float,4,16> cs{{3.0f,4.0f,5.0f,6.0f}};
+    aligned_array<float,4,16> out;
+
+    m128 a( as.data()), b( bs.data()), c( cs.data());
+
+    fma(a, b, c).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[i], as[i]*bs[i] + cs[i]);
+    }
+
+    fms(a, b, c).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[i], as[i]*bs[i] - cs[i]);
+    }
+
+    fnma(a, b, c).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[i], -as[i]*bs[i] + cs[i]);
+    }
+
+    fnms(a, b, c).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[i], -as[i]*bs[i] - cs[i]);
+    }
+    
+  } // end of test m128.fma
+
+  
+  TEST(m128, rounding)
+  {
+    aligned_array<float,4,16> xs{{-1.5f,-0.25f,0.75f,2.5f}};
+    aligned_array<float,4,16> out;
+
+    ceil( m128( xs.data())).store( out.data());
+    EXPECT_EQ(out[0], -1.0f);
+    EXPECT_EQ(out[1], -0.0f);
+    EXPECT_EQ(out[2], 1.0f);
+    EXPECT_EQ(out[3], 3.0f);
+
+    floor( m128( xs.data())).store( out.data());
+    EXPECT_EQ(out[0], -2.0f);
+    EXPECT_EQ(out[1], -1.0f);
+    EXPECT_EQ(out[2], 0.0f);
+    EXPECT_EQ(out[3], 2.0f);
+
+    round( m128( xs.data())).store( out.data());
+    EXPECT_EQ(out[0], -2.0f);
+    EXPECT_EQ(out[1], -0.0f);
+    EXPECT_EQ(out[2], 1.0f);
+    EXPECT_EQ(out[3], 2.0f);
+    
+  } // end of test m128.rounding
+
+  
+  TEST(m128, sqrt)
+  {
+    aligned_array<float,4,16> xs{{1.0f,4.0f,9.0f,16.0f}};
+    aligned_array<float,4,16> out;
+
+    sqrt( m128( xs.data())).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[i], float(i+1));
+    }
+
+    rsqrt( m128( xs.data())).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_NEAR(out[i], 1.0f/float(i+1), 1.0e-3f);
+    }
+
+    rcp( m128( xs.data())).store( out.data());
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_NEAR(out[i], 1.0f/xs[i], 1.0e-3f);
+    }
+    
+  } // end of test m128.sqrt
+
+  
+  TEST(m128, comparison)
+  {
+    aligned_array<float,4,16> xs{{0.0f,1.0f,2.0f,3.0f}};
+    aligned_array<float,4,16> ys{{3.0f,2.0f,2.0f,0.0f}};
+    aligned_array<float,4,16> out;
+
+    m128 x( xs.data()), y( ys.data());
+
+    auto lt = x < y;
+    EXPECT_TRUE(lt[0]);
+    EXPECT_TRUE(lt[1]);
+    EXPECT_FALSE(lt[2]);
+    EXPECT_FALSE(lt[3]);
+
+    auto ge = x >= y;
+    EXPECT_FALSE(ge[0]);
+    EXPECT_FALSE(ge[1]);
+    EXPECT_TRUE(ge[2]);
+    EXPECT_TRUE(ge[3]);
+
+    EXPECT_TRUE(none( lt & ge ));
+    EXPECT_TRUE(all( lt | ge ));
+    EXPECT_TRUE(all( lt ^ ge ));
+    EXPECT_TRUE(none( ~( lt | ge )));
+    EXPECT_TRUE(any( lt ));
+    EXPECT_EQ(popcount( lt ), 2);
+    EXPECT_EQ(popcount( decltype(lt)( true )), 4);
+
+    cond( x == y, x, m128(-1.0f)).store( out.data());
+    EXPECT_EQ(out[0], -1.0f);
+    EXPECT_EQ(out[1], -1.0f);
+    EXPECT_EQ(out[2], 2.0f);
+    EXPECT_EQ(out[3], -1.0f);
+
+    abs( x - y ).store( out.data());
+    EXPECT_EQ(out[0], 3.0f);
+    EXPECT_EQ(out[1], 1.0f);
+    EXPECT_EQ(out[2], 0.0f);
+    EXPECT_EQ(out[3], 3.0f);
+
+    m128 nan( std::numeric_limits<float>::quiet_NaN());
+    EXPECT_TRUE(all( nan != x ));
+    EXPECT_TRUE(all( nan != nan ));
+    EXPECT_TRUE(none( nan == nan ));
+    
+  } // end of test m128.comparison
+
+  
+  TEST(m128d, arithmetic)
+  {
+    aligned_array<double,2,16> xs{{1.0,2.0}};
+    aligned_array<double,2,16> ys{{3.0,5.0}};
+    aligned_array<double,2,16> out;
+
+    m128d x( xs.data()), y( ys.data());
+
+    fma( x + y, x*y, x/y - 1.0 ).store( out.data());
+    for(size_type i = 0; i < 2; ++i){
+      EXPECT_DOUBLE_EQ(out[i], (xs[i] + ys[i])*(xs[i]*ys[i]) + (xs[i]/ys[i] - 1.0));
+    }
+
+    floor( sqrt( y )).store( out.data());
+    EXPECT_EQ(out[0], 1.0);
+    EXPECT_EQ(out[1], 2.0);
+
+    auto le = x <= 1.0;
+    EXPECT_TRUE(le[0]);
+    EXPECT_FALSE(le[1]);
+    EXPECT_EQ(popcount( le ), 1);
+    EXPECT_TRUE(all( le | ~le ));
+
+    cond( le, x, y ).store( out.data());
+    EXPECT_EQ(out[0], 1.0);
+    EXPECT_EQ(out[1], 5.0);
+    
+  } // end of test m128d.arithmetic
+
+  
+  TEST(short_vector_sse, arithmetic)
+  {
+    Short_vector<float,8,16,sse_tag> xs([](auto x){ return float(x); }, function_tag{});
+    Short_vector<double,4,16,sse_tag> ys([](auto y){ return double(y*y); }, function_tag{});
+
+    auto zs = fma(xs, xs + 1.0f, Short_vector<float,8,16,sse_tag>(2.0f));
+    auto ws = ys/2.0 - cond( ys > 2.0, Short_vector<double,4,16,sse_tag>(1.0), Short_vector<double,4,16,sse_tag>(0.0));
+
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(zs[i], float(i*(i+1) + 2));
+    }
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(ws[i], double(i*i)/2.0 - (i*i > 2 ? 1.0 : 0.0));
+    }
+    
+  } // end of test short_vector_sse.arithmetic
+  
+
+  TEST(m128, masked)
+  {
+    float xs[ 7 ];
+    float out[ 7 ];
+    for(size_type i = 0; i < 7; ++i){
+      xs[i] = float(i + 1);
+      out[i] = -1.0f;
+    }
+
+    auto tail = SSE::m128_mask::first( 3 );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(tail[i], i < 3);
+    }
+    EXPECT_TRUE(none( SSE::m128_mask::first( 0 )));
+    EXPECT_TRUE(all( SSE::m128_mask::first( 7 )));
+
+    m128 x( xs + 4, tail );
+    alignas(16) float lanes[ 4 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], i < 3 ? xs[4+i] : 0.0f);
+    }
+
+    add( tail, x, m128( 1.0f )).store( out + 4, tail );
+    for(size_type i = 0; i < 7; ++i){
+      EXPECT_EQ(out[i], i < 4 ? -1.0f : xs[i] + 1.0f);
+    }
+
+    multiply( tail, m128( 2.0f ), x ).store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], i < 3 ? 2.0f*xs[4+i] : 2.0f);
+    }
+    
+  } // end of test m128.masked
+
+  TEST(m128d, masked)
+  {
+    double xs[ 3 ];
+    double out[ 3 ];
+    for(size_type i = 0; i < 3; ++i){
+      xs[i] = double(i + 1);
+      out[i] = -1.0;
+    }
+
+    auto tail = SSE::m128d_mask::first( 1 );
+    for(size_type i = 0; i < 2; ++i){
+      EXPECT_EQ(tail[i], i < 1);
+    }
+    EXPECT_TRUE(none( SSE::m128d_mask::first( 0 )));
+    EXPECT_TRUE(all( SSE::m128d_mask::first( 5 )));
+
+    m128d x( xs + 2, tail );
+    alignas(16) double lanes[ 2 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 2; ++i){
+      EXPECT_EQ(lanes[i], i < 1 ? xs[2+i] : 0.0);
+    }
+
+    add( tail, x, m128d( 1.0 )).store( out + 2, tail );
+    for(size_type i = 0; i < 3; ++i){
+      EXPECT_EQ(out[i], i < 2 ? -1.0 : xs[i] + 1.0);
+    }
+
+    multiply( tail, m128d( 2.0 ), x ).store( lanes );
+    for(size_type i = 0; i < 2; ++i){
+      EXPECT_EQ(lanes[i], i < 1 ? 2.0*xs[2+i] : 2.0);
+    }
+    
+  } // end of test m128d.masked
+
+
+  TEST(m128, reductions)
+  {
+    alignas(16) float xs[ 4 ];
+    alignas(16) float ys[ 4 ];
+    float sum = 0.0f, product = 1.0f, inner = 0.0f;
+    for(size_type i = 0; i < 4; ++i){
+      xs[i] = float( (i*5) % 4 ) - float( 2 ) + 0.5f;
+      ys[i] = float( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m128 x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 4 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 4 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 4 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 4 ) - xs);
+    EXPECT_EQ(argmax( y ), 3);
+    
+  } // end of test m128.reductions
+
+  TEST(m128d, reductions)
+  {
+    alignas(16) double xs[ 2 ];
+    alignas(16) double ys[ 2 ];
+    double sum = 0.0, product = 1.0, inner = 0.0;
+    for(size_type i = 0; i < 2; ++i){
+      xs[i] = double( (i*5) % 2 ) - double( 1 ) + 0.5;
+      ys[i] = double( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m128d x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 2 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 2 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 2 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 2 ) - xs);
+    EXPECT_EQ(argmax( y ), 1);
+    
+  } // end of test m128d.reductions
+
+  /** Check a shuffle of registers against the lanes it reads */
+  template< typename R, size_type ... I >
+  void
+  expect_shuffle(){
+    using T = typename R::value_type;
+    constexpr size_type n = R::extent;
+    constexpr array<size_type,n> index{{ I ... }};
+    alignas(64) T as[ n ], bs[ n ], out[ n ];
+    for( size_type i = 0; i < n; ++i ){
+      as[i] = T( i + 1 );
+      bs[i] = -T( i + 1 );
+    }
+    if constexpr ((( I < n ) && ... )){
+      R::template shuffle<I...>( R( as )).store( out );
+      for( size_type k = 0; k < n; ++k ){
+	EXPECT_EQ( out[k], as[ index[k] ] );
+      }
+    }
+    R::template shuffle<I...>( R( as ), R( bs )).store( out );
+    for( size_type k = 0; k < n; ++k ){
+      EXPECT_EQ( out[k], index[k] < n ? as[ index[k] ] : bs[ index[k] - n ] );
+    }
+  }
+
+  TEST(m128, shuffle)
+  {
+    expect_shuffle<m128, 1, 0, 3, 2>();
+    expect_shuffle<m128, 3, 3, 0, 1>();
+    expect_shuffle<m128, 2, 0, 5, 7>();
+    expect_shuffle<m128, 6, 4, 1, 1>();
+    expect_shuffle<m128, 0, 5, 2, 7>();
+    expect_shuffle<m128, 4, 5, 6, 7>();
+    
+  } // end of test m128.shuffle
+
+  TEST(m128d, shuffle)
+  {
+    expect_shuffle<m128d, 1, 0>();
+    expect_shuffle<m128d, 1, 1>();
+    expect_shuffle<m128d, 0, 3>();
+    expect_shuffle<m128d, 2, 1>();
+    expect_shuffle<m128d, 3, 2>();
+    
+  } // end of test m128d.shuffle
+
+  TEST(m128, frexp)
+  {
+    alignas(16) float xs[ 4 ] = { 0.75f, -1024.5f, 1e-30f, 6e37f };
+    alignas(16) float ms[ 4 ], es[ 4 ], out[ 4 ];
+    m128 e;
+    frexp( m128( xs ), e ).store( ms );
+    e.store( es );
+    ldexp( m128( ms ), e ).store( out );
+    for( size_type i = 0; i < 4; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], float( n ));
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    
+  } // end of test m128.frexp
+
+  TEST(m128d, frexp)
+  {
+    alignas(16) double xs[ 2 ] = { -1024.5, 1e-300 };
+    alignas(16) double ms[ 2 ], es[ 2 ], out[ 2 ];
+    m128d e;
+    frexp( m128d( xs ), e ).store( ms );
+    e.store( es );
+    ldexp( m128d( ms ), e ).store( out );
+    for( size_type i = 0; i < 2; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], double( n ));
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    
+  } // end of test m128d.frexp
+
+} // end of namespace 
@@ -2,9 +2,15 @@
 // ... Standard header files
 //
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <array>
+#include <algorithm>
 #include <vector>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <complex>
 
 //
 // ... Testing header files
@@ -14,7 +20,11 @@
 //
 // ... Short Vector header files
 //
+#include <short_vector/core.hpp>
 #include <short_vector/avx/m256.hpp>
+#include <short_vector/avx/m256d.hpp>
+#include <short_vector/math.hpp>
+#include <short_vector/avx/complex.hpp>
 
 namespace 
 {
@@ -30,7 +40,17 @@ namespace
 
 
   using AVX::m256;
+  using AVX::m256d;
   using AVX::stream_tag;
+
+  using ShortVector::Private::rotate;
+  using ShortVector::Private::reverse;
+  using ShortVector::Private::broadcast;
+  using ShortVector::Private::interleave_low;
+  using ShortVector::Private::interleave_high;
+  using ShortVector::Private::shift_up;
+  using ShortVector::Private::inclusive_scan;
+  using ShortVector::Private::exclusive_scan;
   
   template< typename T, size_t N, size_t A >
   class alignas(A) aligned_array : public array<T,N>
@@ -204,4 +224,559 @@ namespace
     }
   }
 
+
+  TEST(m256, comparison)
+  {
+    alignas(32) float xs[ 8 ] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    m256 x( xs );
+    m256 nan( std::numeric_limits<float>::quiet_NaN());
+
+    auto ne = x != m256( 3.0f );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(ne[i], i != 3);
+    }
+
+    EXPECT_TRUE(all( nan != x ));
+    EXPECT_TRUE(all( nan != nan ));
+    EXPECT_TRUE(none( nan == nan ));
+    
+  } // end of test m256.comparison
+
+
+  TEST(m256d, comparison)
+  {
+    alignas(32) double xs[ 4 ] = { 0.0, 1.0, 2.0, 3.0 };
+    m256d x( xs );
+    m256d nan( std::numeric_limits<double>::quiet_NaN());
+
+    auto ne = x != m256d( 2.0 );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(ne[i], i != 2);
+    }
+
+    EXPECT_TRUE(all( nan != x ));
+    EXPECT_TRUE(all( nan != nan ));
+    EXPECT_TRUE(none( nan == nan ));
+    
+  } // end of test m256d.comparison
+
+
+  TEST(m256, masked)
+  {
+    float xs[ 15 ];
+    float out[ 15 ];
+    for(size_type i = 0; i < 15; ++i){
+      xs[i] = float(i + 1);
+      out[i] = -1.0f;
+    }
+
+    auto tail = AVX::m256_mask::first( 7 );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(tail[i], i < 7);
+    }
+    EXPECT_TRUE(none( AVX::m256_mask::first( 0 )));
+    EXPECT_TRUE(all( AVX::m256_mask::first( 11 )));
+
+    m256 x( xs + 8, tail );
+    alignas(32) float lanes[ 8 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 7 ? xs[8+i] : 0.0f);
+    }
+
+    add( tail, x, m256( 1.0f )).store( out + 8, tail );
+    for(size_type i = 0; i < 15; ++i){
+      EXPECT_EQ(out[i], i < 8 ? -1.0f : xs[i] + 1.0f);
+    }
+
+    multiply( tail, m256( 2.0f ), x ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 7 ? 2.0f*xs[8+i] : 2.0f);
+    }
+    
+  } // end of test m256.masked
+
+  TEST(m256d, masked)
+  {
+    double xs[ 7 ];
+    double out[ 7 ];
+    for(size_type i = 0; i < 7; ++i){
+      xs[i] = double(i + 1);
+      out[i] = -1.0;
+    }
+
+    auto tail = AVX::m256d_mask::first( 3 );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(tail[i], i < 3);
+    }
+    EXPECT_TRUE(none( AVX::m256d_mask::first( 0 )));
+    EXPECT_TRUE(all( AVX::m256d_mask::first( 7 )));
+
+    m256d x( xs + 4, tail );
+    alignas(32) double lanes[ 4 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], i < 3 ? xs[4+i] : 0.0);
+    }
+
+    add( tail, x, m256d( 1.0 )).store( out + 4, tail );
+    for(size_type i = 0; i < 7; ++i){
+      EXPECT_EQ(out[i], i < 4 ? -1.0 : xs[i] + 1.0);
+    }
+
+    multiply( tail, m256d( 2.0 ), x ).store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], i < 3 ? 2.0*xs[4+i] : 2.0);
+    }
+    
+  } // end of test m256d.masked
+
+  TEST(m256, gather_scatter)
+  {
+    float base[ 64 ];
+    for(size_type i = 0; i < 64; ++i){
+      base[i] = float(i) + 0.5f;
+    }
+    alignas(32) std::int32_t offsets[ 8 ];
+    for(size_type i = 0; i < 8; ++i){
+      offsets[i] = std::int32_t(( 7*i + 3 ) % 64 );
+    }
+    AVX::m256i<std::int32_t> index( offsets );
+
+    alignas(32) float lanes[ 8 ];
+    m256::gather( base, index ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], base[ offsets[i] ]);
+    }
+
+    auto m = AVX::m256_mask::first( 5 );
+    m256::gather( base, index, m ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 5 ? base[ offsets[i] ] : 0.0f);
+    }
+
+    float out[ 64 ];
+    std::fill( out, out + 64, float(-1) );
+    m256 x( lanes );
+    x.scatter( out, index, m );
+    for(size_type i = 0; i < 64; ++i){
+      auto k = std::find( offsets, offsets + 5, std::int32_t(i) ) - offsets;
+      EXPECT_EQ(out[i], k < 5 ? lanes[k] : float(-1));
+    }
+
+    x = m256::gather( base, index );
+    x.scatter( out, index );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[ offsets[i] ], base[ offsets[i] ]);
+    }
+    
+  } // end of test m256.gather_scatter
+
+  TEST(m256d, gather_scatter)
+  {
+    double base[ 64 ];
+    for(size_type i = 0; i < 64; ++i){
+      base[i] = double(i) + 0.5;
+    }
+    alignas(32) std::int64_t offsets[ 4 ];
+    for(size_type i = 0; i < 4; ++i){
+      offsets[i] = std::int64_t(( 7*i + 3 ) % 64 );
+    }
+    AVX::m256i<std::int64_t> index( offsets );
+
+    alignas(32) double lanes[ 4 ];
+    m256d::gather( base, index ).store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], base[ offsets[i] ]);
+    }
+
+    auto m = AVX::m256d_mask::first( 3 );
+    m256d::gather( base, index, m ).store( lanes );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(lanes[i], i < 3 ? base[ offsets[i] ] : 0.0);
+    }
+
+    double out[ 64 ];
+    std::fill( out, out + 64, double(-1) );
+    m256d x( lanes );
+    x.scatter( out, index, m );
+    for(size_type i = 0; i < 64; ++i){
+      auto k = std::find( offsets, offsets + 3, std::int64_t(i) ) - offsets;
+      EXPECT_EQ(out[i], k < 3 ? lanes[k] : double(-1));
+    }
+
+    x = m256d::gather( base, index );
+    x.scatter( out, index );
+    for(size_type i = 0; i < 4; ++i){
+      EXPECT_EQ(out[ offsets[i] ], base[ offsets[i] ]);
+    }
+    
+  } // end of test m256d.gather_scatter
+
+
+  TEST(m256, reductions)
+  {
+    alignas(32) float xs[ 8 ];
+    alignas(32) float ys[ 8 ];
+    float sum = 0.0f, product = 1.0f, inner = 0.0f;
+    for(size_type i = 0; i < 8; ++i){
+      xs[i] = float( (i*5) % 8 ) - float( 4 ) + 0.5f;
+      ys[i] = float( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m256 x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 8 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 8 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 8 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 8 ) - xs);
+    EXPECT_EQ(argmax( y ), 7);
+    
+  } // end of test m256.reductions
+
+  TEST(m256d, reductions)
+  {
+    alignas(32) double xs[ 4 ];
+    alignas(32) double ys[ 4 ];
+    double sum = 0.0, product = 1.0, inner = 0.0;
+    for(size_type i = 0; i < 4; ++i){
+      xs[i] = double( (i*5) % 4 ) - double( 2 ) + 0.5;
+      ys[i] = double( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m256d x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 4 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 4 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 4 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 4 ) - xs);
+    EXPECT_EQ(argmax( y ), 3);
+    
+  } // end of test m256d.reductions
+
+  /** Check a shuffle of registers against the lanes it reads */
+  template< typename R, size_type ... I >
+  void
+  expect_shuffle(){
+    using T = typename R::value_type;
+    constexpr size_type n = R::extent;
+    constexpr array<size_type,n> index{{ I ... }};
+    alignas(64) T as[ n ], bs[ n ], out[ n ];
+    for( size_type i = 0; i < n; ++i ){
+      as[i] = T( i + 1 );
+      bs[i] = -T( i + 1 );
+    }
+    if constexpr ((( I < n ) && ... )){
+      R::template shuffle<I...>( R( as )).store( out );
+      for( size_type k = 0; k < n; ++k ){
+	EXPECT_EQ( out[k], as[ index[k] ] );
+      }
+    }
+    R::template shuffle<I...>( R( as ), R( bs )).store( out );
+    for( size_type k = 0; k < n; ++k ){
+      EXPECT_EQ( out[k], index[k] < n ? as[ index[k] ] : bs[ index[k] - n ] );
+    }
+  }
+
+  TEST(m256, shuffle)
+  {
+    expect_shuffle<m256, 1, 0, 3, 2, 5, 4, 7, 6>();
+    expect_shuffle<m256, 4, 5, 6, 7, 0, 1, 2, 3>();
+    expect_shuffle<m256, 3, 3, 0, 1, 4, 6, 5, 7>();
+    expect_shuffle<m256, 7, 6, 5, 4, 3, 2, 1, 0>();
+    expect_shuffle<m256, 1, 0, 9, 8, 5, 4, 13, 12>();
+    expect_shuffle<m256, 12, 13, 14, 15, 0, 1, 2, 3>();
+    expect_shuffle<m256, 0, 8, 1, 9, 2, 10, 3, 11>();
+    expect_shuffle<m256, 15, 14, 13, 12, 11, 10, 9, 8>();
+    expect_shuffle<m256, 0, 8, 1, 9, 4, 12, 5, 13>();
+    expect_shuffle<m256, 2, 10, 3, 11, 6, 14, 7, 15>();
+
+    alignas(32) float xs[ 8 ] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    alignas(32) float ys[ 8 ] = { -1, -2, -3, -4, -5, -6, -7, -8 };
+    alignas(32) float out[ 8 ];
+    m256 x( xs ), y( ys );
+
+    rotate<3>( x ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], xs[ (i + 3) % 8 ] );
+    }
+    reverse( x ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], xs[ 7 - i ] );
+    }
+    broadcast<5>( x ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], 6.0f );
+    }
+    interleave_low( x, y ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], i % 2 ? ys[ i/2 ] : xs[ i/2 ] );
+    }
+    interleave_high( x, y ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], i % 2 ? ys[ 4 + i/2 ] : xs[ 4 + i/2 ] );
+    }
+    shift_up<3>( x, y ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], i < 3 ? ys[i] : xs[ i - 3 ] );
+    }
+    inclusive_scan( x ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], float( ( i + 1 )*( i + 2 )/2 ));
+    }
+    exclusive_scan( x ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], float( i*( i + 1 )/2 ));
+    }
+    
+  } // end of test m256.shuffle
+
+  TEST(m256d, shuffle)
+  {
+    expect_shuffle<m256d, 1, 0, 3, 3>();
+    expect_shuffle<m256d, 2, 3, 0, 1>();
+    expect_shuffle<m256d, 3, 0, 2, 1>();
+    expect_shuffle<m256d, 1, 5, 2, 7>();
+    expect_shuffle<m256d, 6, 7, 0, 1>();
+    expect_shuffle<m256d, 0, 4, 1, 5>();
+    expect_shuffle<m256d, 7, 6, 5, 4>();
+    
+  } // end of test m256d.shuffle
+
+  /** The distance of x from the reference r, in units of the last
+   *  place of the type of x */
+  template< typename T >
+  double
+  ulps( T x, long double r ){
+    if( std::isnan( r ) || std::isinf( r )){
+      return std::isnan( r ) == std::isnan( x ) && ( std::isnan( r ) || T( r ) == x )
+	? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    int e;
+    std::frexp( r, &e );
+    long double unit = std::max<long double>( std::ldexp( 1.0L, e - std::numeric_limits<T>::digits ),
+					      std::numeric_limits<T>::denorm_min() );
+    return double( std::fabs( x - r )/unit );
+  }
+
+  /** Check a function of registers against its reference on 1024
+   *  points evenly spaced in [lo,hi] */
+  template< typename R, typename F, typename G >
+  void
+  expect_ulps( F f, G g, double lo, double hi, double bound ){
+    using T = typename R::value_type;
+    constexpr size_type n = R::extent;
+    alignas(64) T xs[ n ], out[ n ];
+    for( size_type i = 0; i < 1024; i += n ){
+      for( size_type k = 0; k < n; ++k ){
+	xs[k] = T( lo + ( hi - lo )*double( i + k )/1023 );
+      }
+      f( R( xs )).store( out );
+      for( size_type k = 0; k < n; ++k ){
+	EXPECT_LE( ulps( out[k], g( (long double)( xs[k] ))), bound ) << "at " << xs[k];
+      }
+    }
+  }
+
+  template< typename R >
+  void
+  expect_math(){
+    namespace M = ShortVector::Private;
+    using T = typename R::value_type;
+    constexpr bool single = std::is_same_v<T,float>;
+    expect_ulps<R>( []( R x ){ return M::exp( x ); }, []( long double x ){ return std::exp( x ); }, -100, 88, 1 );
+    expect_ulps<R>( []( R x ){ return M::exp2( x ); }, []( long double x ){ return std::exp2( x ); }, -140, 127, single ? 1 : 1.5 );
+    expect_ulps<R>( []( R x ){ return M::log( x ); }, []( long double x ){ return std::log( x ); }, 1e-3, 1e3, single ? 1 : 1.5 );
+    expect_ulps<R>( []( R x ){ return M::log2( x ); }, []( long double x ){ return std::log2( x ); }, 1e-3, 4, 2 );
+    expect_ulps<R>( []( R x ){ return M::log1p( x ); }, []( long double x ){ return std::log1p( x ); }, -0.9, 2, single ? 1.5 : 2 );
+    expect_ulps<R>( []( R x ){ return M::sin( x ); }, []( long double x ){ return std::sin( x ); }, -100, 100, 2 );
+    expect_ulps<R>( []( R x ){ return M::sin( x ); }, []( long double x ){ return std::sin( x ); }, -1e6, 1e6, 2 );
+    expect_ulps<R>( []( R x ){ return M::cos( x ); }, []( long double x ){ return std::cos( x ); }, -100, 100, 2 );
+    expect_ulps<R>( []( R x ){ return M::cos( x ); }, []( long double x ){ return std::cos( x ); }, -1e6, 1e6, 2 );
+    expect_ulps<R>( []( R x ){ return M::tan( x ); }, []( long double x ){ return std::tan( x ); }, -100, 100, 4 );
+    expect_ulps<R>( []( R x ){ return M::tan( x ); }, []( long double x ){ return std::tan( x ); }, -1e6, 1e6, 4 );
+    expect_ulps<R>( []( R x ){ return M::atan2( x, R( T( -0.75 ))); }, []( long double x ){ return std::atan2( x, -0.75L ); }, -4, 4, 3 );
+    expect_ulps<R>( []( R x ){ return M::tanh( x ); }, []( long double x ){ return std::tanh( x ); }, -10, 10, 1.5 );
+    expect_ulps<R>( []( R x ){ return M::erf( x ); }, []( long double x ){ return std::erf( x ); }, -5, 5, 1 );
+    expect_ulps<R>( []( R x ){ return M::pow( x, R( T( 1.5 ))); }, []( long double x ){ return std::pow( x, 1.5L ); }, 0.5, 2, 2 );
+    expect_ulps<R>( []( R x ){ return M::inverse_sqrt<M::balanced_tag>( x ); }, []( long double x ){ return 1/std::sqrt( x ); }, 1e-3, 1e3, 4 );
+    expect_ulps<R>( []( R x ){ return M::reciprocal<M::balanced_tag>( x ); }, []( long double x ){ return 1/x; }, -1e3, -1e-3, 4 );
+    expect_ulps<R>( []( R x ){ return M::reciprocal<M::ieee_tag>( x ); }, []( long double x ){ return 1/x; }, 1e-3, 1e3, 0.5 );
+
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+    alignas(64) T xs[ R::extent ], out[ R::extent ];
+    std::fill( xs, xs + R::extent, T( 0 ));
+    xs[1] = infinity;
+    xs[2] = -infinity;
+    xs[3] = std::numeric_limits<T>::quiet_NaN();
+    M::exp( R( xs )).store( out );
+    EXPECT_EQ( out[0], T( 1 ));
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::log( R( xs )).store( out );
+    EXPECT_EQ( out[0], -infinity );
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_TRUE( std::isnan( out[2] ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::inverse_sqrt<M::balanced_tag>( R( xs )).store( out );
+    EXPECT_EQ( out[0], infinity );
+    EXPECT_EQ( out[1], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[2] ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::reciprocal<M::balanced_tag>( R( xs )).store( out );
+    EXPECT_EQ( out[0], infinity );
+    EXPECT_EQ( out[1], T( 0 ));
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::pow( R( T( -2 )), R( xs )).store( out );
+    EXPECT_EQ( out[0], T( 1 ));
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::pow( R( T( -2 )), R( T( 3 ))).store( out );
+    EXPECT_EQ( out[0], T( -8 ));
+
+    if constexpr( R::estimate_precision >= std::numeric_limits<T>::digits ){
+      rsqrt( R( T( 4 ))).store( out );
+      EXPECT_EQ( out[0], T( 0.5 ));
+      rcp( R( T( 3 ))).store( out );
+      EXPECT_EQ( out[0], T( 1 )/T( 3 ));
+    }
+    if constexpr( std::is_same_v<T,double> ){
+      for( double x : { 1e300, -1e300, 1e-300, -1e-300, 1e-40, -1e-40, 1e-45, -1e-45 } ){
+	M::reciprocal<M::balanced_tag>( R( x )).store( out );
+	EXPECT_LE( ulps( out[0], 1/(long double)( x )), 4 ) << x;
+	if( x > 0 ){
+	  M::inverse_sqrt<M::balanced_tag>( R( x )).store( out );
+	  EXPECT_LE( ulps( out[0], 1/std::sqrt( (long double)( x ))), 4 ) << x;
+	}
+      }
+    }
+  }
+
+  TEST(m256, math)
+  {
+    expect_math<m256>();
+    
+  } // end of test m256.math
+
+  TEST(m256d, math)
+  {
+    expect_math<m256d>();
+    
+  } // end of test m256d.math
+
+  TEST(m256, frexp)
+  {
+    alignas(32) float xs[ 8 ] = { 1.0f, 0.75f, -3.0f, 1024.5f, 1e-30f, 6e37f, 0.1f, -0.5f };
+    alignas(32) float ms[ 8 ], es[ 8 ], out[ 8 ];
+    m256 e;
+    frexp( m256( xs ), e ).store( ms );
+    e.store( es );
+    for( size_type i = 0; i < 8; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], float( n ));
+    }
+    ldexp( m256( ms ), e ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    ldexp( m256( 1.5f ), m256( -140.0f )).store( out );
+    EXPECT_EQ( out[0], std::ldexp( 1.5f, -140 ));
+    
+  } // end of test m256.frexp
+
+  TEST(m256d, frexp)
+  {
+    alignas(32) double xs[ 4 ] = { 1.0, -1024.5, 1e-300, 6e307 };
+    alignas(32) double ms[ 4 ], es[ 4 ], out[ 4 ];
+    m256d e;
+    frexp( m256d( xs ), e ).store( ms );
+    e.store( es );
+    for( size_type i = 0; i < 4; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], double( n ));
+    }
+    ldexp( m256d( ms ), e ).store( out );
+    for( size_type i = 0; i < 4; ++i ){
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    ldexp( m256d( 1.5 ), m256d( -1070.0 )).store( out );
+    EXPECT_EQ( out[0], std::ldexp( 1.5, -1070 ));
+    
+  } // end of test m256d.frexp
+
+  template< typename R >
+  void
+  expect_complex(){
+    using C = typename R::value_type;
+    using T = typename R::real_type;
+    constexpr size_type n = R::extent;
+    alignas(64) C xs[ 2*n ], ys[ 2*n ], out[ 2*n ];
+    alignas(64) T re[ 2*n ], im[ 2*n ];
+    for( size_type i = 0; i < 2*n; ++i ){
+      xs[i] = C( T( i ) - T( 2.5 ), T( 1 ) + T( 0.5 )*T( i ));
+      ys[i] = C( T( 0.25 )*T( i ) + T( 1 ), T( 3 ) - T( i ));
+    }
+    R x( xs ), y( ys );
+
+    ( x*y ).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], xs[i]*ys[i] );
+    }
+    ( x/y ).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_LE( std::abs( out[i] - xs[i]/ys[i] ), 4*std::numeric_limits<T>::epsilon()*std::abs( xs[i]/ys[i] ));
+    }
+    ( conj( x ) + norm( y )).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], std::conj( xs[i] ) + std::norm( ys[i] ));
+    }
+    ( -x*T( 2 ) - C( 1, -2 )).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], -xs[i]*T( 2 ) - C( 1, -2 ));
+    }
+
+    auto xs_split = split( x, R( xs + n ));
+    auto ys_split = split( y, R( ys + n ));
+    xs_split.real().store( re );
+    xs_split.imag().store( im );
+    for( size_type i = 0; i < 2*n; ++i ){
+      EXPECT_EQ( C( re[i], im[i] ), xs[i] );
+    }
+    norm( xs_split ).store( re );
+    auto products = interleave( xs_split*ys_split );
+    products[0].store( out );
+    products[1].store( out + n );
+    for( size_type i = 0; i < 2*n; ++i ){
+      EXPECT_EQ( re[i], std::norm( xs[i] ));
+      EXPECT_EQ( out[i], xs[i]*ys[i] );
+    }
+  }
+
+  TEST(complex_m256, arithmetic)
+  {
+    expect_complex<AVX::complex_m256>();
+    
+  } // end of test complex_m256.arithmetic
+
+  TEST(complex_m256d, arithmetic)
+  {
+    expect_complex<AVX::complex_m256d>();
+    
+  } // end of test complex_m256d.arithmetic
+
 } // end of namespace 
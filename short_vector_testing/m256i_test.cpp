@@ -0,0 +1,53 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <cstdint>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/avx/m256i.hpp>
+
+namespace 
+{
+  template< typename T >
+  using integer_register = AVX::m256i<T>;
+
+  using AVX::unaligned;
+
+  constexpr std::size_t register_width = 32;
+
+} // end of namespace 
+
+#include "integer_register_test.hpp"
+
+namespace 
+{
+  using ShortVector::Private::function_tag;
+  using ShortVector::Private::avx_tag;
+  using ShortVector::Private::Short_vector;
+
+
+  TEST(short_vector_avx_integer, arithmetic)
+  {
+    Short_vector<std::int32_t,16,32,avx_tag> xs([](auto x){ return std::int32_t(x); }, function_tag{});
+    Short_vector<std::uint16_t,16,32,avx_tag> ys([](auto y){ return std::uint16_t(y*y); }, function_tag{});
+
+    auto zs = xs*xs - cond( xs > 4, decltype(xs)(3), decltype(xs)(0));
+    auto ws = ys + cond( ys < std::uint16_t(10), decltype(ys)(1), decltype(ys)(0));
+
+    for( size_type i = 0; i < 16; ++i ){
+      EXPECT_EQ( zs[i], i*i - 3*(i > 4));
+      EXPECT_EQ( ws[i], i*i + (i*i < 10));
+    }
+    
+  } // end of test short_vector_avx_integer.arithmetic
+
+} // end of namespace 
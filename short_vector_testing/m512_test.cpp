@@ -0,0 +1,834 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <complex>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/avx512/m512.hpp>
+#include <short_vector/avx512/m512d.hpp>
+#include <short_vector/avx512/convert.hpp>
+#include <short_vector/math.hpp>
+#include <short_vector/avx512/complex.hpp>
+
+namespace 
+{
+  using size_type = std::ptrdiff_t;
+  using std::array;
+
+  using AVX512::m512;
+  using AVX512::m512d;
+  using AVX512::unaligned;
+  using AVX512::stream;
+
+  using ShortVector::Private::function_tag;
+  using ShortVector::Private::avx512_tag;
+  using ShortVector::Private::Short_vector;
+  using ShortVector::Private::inclusive_scan;
+  using ShortVector::Private::exclusive_scan;
+
+  template< typename T, size_t N, size_t A >
+  struct alignas(A) aligned_array : array<T,N>
+  {};
+
+  template< typename T, size_t N, size_t A, typename F >
+  aligned_array<T,N,A>
+  generate( F f ){
+    aligned_array<T,N,A> result;
+    for( size_t i = 0; i < N; ++i ){
+      result[i] = f(i);
+    }
+    return result;
+  }
+  
+
+  TEST(m512, load_store)
+  {
+    auto xs = generate<float,48,64>([](auto i){ return float(i); });
+    aligned_array<float,48,64> out{};
+
+    m512( xs.data()).store( out.data());
+    m512( unaligned<float>{ xs.data() + 17 }).store( unaligned<float>{ out.data() + 17 });
+
+    EXPECT_EQ(out[16], 0.0f);
+    EXPECT_EQ(out[33], 0.0f);
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], xs[i]);
+      EXPECT_EQ(out[i+17], xs[i+17]);
+    }
+
+    m512( stream<float>{ xs.data() + 16 }).store( stream<float>{ out.data() });
+    _mm_sfence();
+
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], xs[i+16]);
+    }
+    
+  } // end of test m512.load_store
+
+  
+  TEST(m512, arithmetic)
+  {
+    auto xs = generate<float,16,64>([](auto i){ return float(i+1); });
+    aligned_array<float,16,64> out;
+
+    m512 x( xs.data());
+    
+    ((x + 3.5f)*x - 1.0f/x).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_FLOAT_EQ(out[i], (xs[i] + 3.5f)*xs[i] - 1.0f/xs[i]);
+    }
+
+    x += x;
+    x *= 0.5f;
+    fnms( x, x, x ).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], -xs[i]*xs[i] - xs[i]);
+    }
+
+    abs( neg( x )).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], xs[i]);
+    }
+    
+  } // end of test m512.arithmetic
+
+  
+  TEST(m512, rounding)
+  {
+    auto xs = generate<float,16,64>([](auto i){ return float(i)*0.75f - 6.0f; });
+    aligned_array<float,16,64> ceils, floors, rounds, truncs;
+
+    ceil( m512( xs.data())).store( ceils.data());
+    floor( m512( xs.data())).store( floors.data());
+    round( m512( xs.data())).store( rounds.data());
+    trunc( m512( xs.data())).store( truncs.data());
+
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(ceils[i], std::ceil(xs[i]));
+      EXPECT_EQ(floors[i], std::floor(xs[i]));
+      EXPECT_EQ(rounds[i], std::nearbyint(xs[i]));
+      EXPECT_EQ(truncs[i], std::trunc(xs[i]));
+    }
+    
+  } // end of test m512.rounding
+
+  
+  TEST(m512, sqrt)
+  {
+    auto xs = generate<float,16,64>([](auto i){ return float((i+1)*(i+1)); });
+    aligned_array<float,16,64> out;
+
+    sqrt( m512( xs.data())).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], float(i+1));
+    }
+
+    rsqrt( m512( xs.data())).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_NEAR(out[i]*float(i+1), 1.0f, 1.0f/16384.0f);
+    }
+
+    rcp( m512( xs.data())).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_NEAR(out[i]*xs[i], 1.0f, 1.0f/16384.0f);
+    }
+    
+  } // end of test m512.sqrt
+
+  
+  TEST(m512, comparison)
+  {
+    auto xs = generate<float,16,64>([](auto i){ return float(i); });
+    auto ys = generate<float,16,64>([](auto i){ return float(15-i); });
+    aligned_array<float,16,64> out;
+
+    m512 x( xs.data()), y( ys.data());
+
+    m512::mask_type lt = x < y;
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(lt[i], xs[i] < ys[i]);
+    }
+    EXPECT_EQ(lt.bits(), 0x00FF);
+
+    m512::mask_type eq = x == 3.0f;
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(eq[i], i == 3);
+    }
+
+    EXPECT_EQ(popcount( lt ), 8);
+    EXPECT_EQ(( ~lt ).bits(), 0xFF00);
+    EXPECT_TRUE(any( lt & eq ));
+    EXPECT_TRUE(none( ~lt & eq ));
+    EXPECT_TRUE(all( lt | ( x >= y )));
+    EXPECT_FALSE(all( lt ^ eq ));
+
+    cond( x >= y, x, y ).store( out.data());
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[i], std::max(xs[i], ys[i]));
+    }
+
+    m512 nan( std::numeric_limits<float>::quiet_NaN());
+    EXPECT_EQ(( nan != x ).bits(), 0xFFFF);
+    EXPECT_EQ(( nan != nan ).bits(), 0xFFFF);
+    EXPECT_TRUE(none( nan == nan ));
+    
+  } // end of test m512.comparison
+
+  
+  TEST(m512d, arithmetic)
+  {
+    auto xs = generate<double,8,64>([](auto i){ return double(i+1); });
+    auto ys = generate<double,8,64>([](auto i){ return double(2*i+3); });
+    aligned_array<double,8,64> out;
+
+    m512d x( xs.data()), y( ys.data());
+
+    fma( x + y, x*y, x/y - 1.0 ).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_DOUBLE_EQ(out[i], (xs[i] + ys[i])*(xs[i]*ys[i]) + (xs[i]/ys[i] - 1.0));
+    }
+
+    fms( x, y, x ).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[i], xs[i]*ys[i] - xs[i]);
+    }
+
+    fnma( x, y, x ).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[i], xs[i] - xs[i]*ys[i]);
+    }
+    
+  } // end of test m512d.arithmetic
+
+  
+  TEST(m512d, rounding_and_roots)
+  {
+    auto xs = generate<double,8,64>([](auto i){ return double(i)*1.25 - 4.0; });
+    aligned_array<double,8,64> out;
+
+    floor( m512d( xs.data())).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[i], std::floor(xs[i]));
+    }
+
+    round( m512d( xs.data())).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[i], std::nearbyint(xs[i]));
+    }
+
+    m512d squares = m512d( xs.data())*m512d( xs.data()) + 1.0;
+    
+    sqrt( squares ).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_DOUBLE_EQ(out[i], std::sqrt(xs[i]*xs[i] + 1.0));
+    }
+
+    (rsqrt( squares )*sqrt( squares )).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_NEAR(out[i], 1.0, 1.0/16384.0);
+    }
+
+    (rcp( squares )*squares).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_NEAR(out[i], 1.0, 1.0/16384.0);
+    }
+    
+  } // end of test m512d.rounding_and_roots
+
+  
+  TEST(m512d, comparison)
+  {
+    auto xs = generate<double,8,64>([](auto i){ return double(i); });
+    aligned_array<double,8,64> out;
+
+    m512d x( xs.data());
+
+    m512d::mask_type ne = x != 4.0;
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(ne[i], i != 4);
+    }
+    EXPECT_EQ(popcount( ne ), 7);
+    EXPECT_TRUE(all( ~ne | ne ));
+
+    cond( x > 4.0, m512d( 1.0 ), m512d( -1.0 )).store( out.data());
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[i], i > 4 ? 1.0 : -1.0);
+    }
+
+    m512d nan( std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(popcount( nan != x ), 8);
+    EXPECT_EQ(popcount( nan != nan ), 8);
+    EXPECT_TRUE(none( nan == nan ));
+    
+  } // end of test m512d.comparison
+
+  
+  TEST(short_vector_avx512, arithmetic)
+  {
+    Short_vector<float,32,64,avx512_tag> xs([](auto x){ return float(x); }, function_tag{});
+    Short_vector<double,8,64,avx512_tag> ys([](auto y){ return double(y*y); }, function_tag{});
+
+    auto zs = fma(xs, xs + 1.0f, Short_vector<float,32,64,avx512_tag>(2.0f));
+    auto ws = ys/2.0 - cond( ys > 2.0, Short_vector<double,8,64,avx512_tag>(1.0), Short_vector<double,8,64,avx512_tag>(0.0));
+
+    for(size_type i = 0; i < 32; ++i){
+      EXPECT_EQ(zs[i], float(i*(i+1) + 2));
+    }
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(ws[i], double(i*i)/2.0 - (i*i > 2 ? 1.0 : 0.0));
+    }
+    
+  } // end of test short_vector_avx512.arithmetic
+  
+
+  TEST(m512, masked)
+  {
+    float xs[ 31 ];
+    float out[ 31 ];
+    for(size_type i = 0; i < 31; ++i){
+      xs[i] = float(i + 1);
+      out[i] = -1.0f;
+    }
+
+    auto tail = m512::mask_type::first( 15 );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(tail[i], i < 15);
+    }
+    EXPECT_TRUE(none( m512::mask_type::first( 0 )));
+    EXPECT_TRUE(all( m512::mask_type::first( 19 )));
+
+    m512 x( xs + 16, tail );
+    alignas(64) float lanes[ 16 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(lanes[i], i < 15 ? xs[16+i] : 0.0f);
+    }
+
+    add( tail, x, m512( 1.0f )).store( out + 16, tail );
+    for(size_type i = 0; i < 31; ++i){
+      EXPECT_EQ(out[i], i < 16 ? -1.0f : xs[i] + 1.0f);
+    }
+
+    multiply( tail, m512( 2.0f ), x ).store( lanes );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(lanes[i], i < 15 ? 2.0f*xs[16+i] : 2.0f);
+    }
+    
+  } // end of test m512.masked
+
+  TEST(m512d, masked)
+  {
+    double xs[ 15 ];
+    double out[ 15 ];
+    for(size_type i = 0; i < 15; ++i){
+      xs[i] = double(i + 1);
+      out[i] = -1.0;
+    }
+
+    auto tail = m512d::mask_type::first( 7 );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(tail[i], i < 7);
+    }
+    EXPECT_TRUE(none( m512d::mask_type::first( 0 )));
+    EXPECT_TRUE(all( m512d::mask_type::first( 11 )));
+
+    m512d x( xs + 8, tail );
+    alignas(64) double lanes[ 8 ];
+    x.store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 7 ? xs[8+i] : 0.0);
+    }
+
+    add( tail, x, m512d( 1.0 )).store( out + 8, tail );
+    for(size_type i = 0; i < 15; ++i){
+      EXPECT_EQ(out[i], i < 8 ? -1.0 : xs[i] + 1.0);
+    }
+
+    multiply( tail, m512d( 2.0 ), x ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 7 ? 2.0*xs[8+i] : 2.0);
+    }
+    
+  } // end of test m512d.masked
+
+  TEST(m512, gather_scatter)
+  {
+    float base[ 64 ];
+    for(size_type i = 0; i < 64; ++i){
+      base[i] = float(i) + 0.5f;
+    }
+    alignas(64) std::int32_t offsets[ 16 ];
+    for(size_type i = 0; i < 16; ++i){
+      offsets[i] = std::int32_t(( 7*i + 3 ) % 64 );
+    }
+    AVX512::m512i<std::int32_t> index( offsets );
+
+    alignas(64) float lanes[ 16 ];
+    m512::gather( base, index ).store( lanes );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(lanes[i], base[ offsets[i] ]);
+    }
+
+    auto m = m512::mask_type::first( 9 );
+    m512::gather( base, index, m ).store( lanes );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(lanes[i], i < 9 ? base[ offsets[i] ] : 0.0f);
+    }
+
+    float out[ 64 ];
+    std::fill( out, out + 64, float(-1) );
+    m512 x( lanes );
+    x.scatter( out, index, m );
+    for(size_type i = 0; i < 64; ++i){
+      auto k = std::find( offsets, offsets + 9, std::int32_t(i) ) - offsets;
+      EXPECT_EQ(out[i], k < 9 ? lanes[k] : float(-1));
+    }
+
+    x = m512::gather( base, index );
+    x.scatter( out, index );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(out[ offsets[i] ], base[ offsets[i] ]);
+    }
+    
+  } // end of test m512.gather_scatter
+
+  TEST(m512d, gather_scatter)
+  {
+    double base[ 64 ];
+    for(size_type i = 0; i < 64; ++i){
+      base[i] = double(i) + 0.5;
+    }
+    alignas(64) std::int64_t offsets[ 8 ];
+    for(size_type i = 0; i < 8; ++i){
+      offsets[i] = std::int64_t(( 7*i + 3 ) % 64 );
+    }
+    AVX512::m512i<std::int64_t> index( offsets );
+
+    alignas(64) double lanes[ 8 ];
+    m512d::gather( base, index ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], base[ offsets[i] ]);
+    }
+
+    auto m = m512d::mask_type::first( 5 );
+    m512d::gather( base, index, m ).store( lanes );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(lanes[i], i < 5 ? base[ offsets[i] ] : 0.0);
+    }
+
+    double out[ 64 ];
+    std::fill( out, out + 64, double(-1) );
+    m512d x( lanes );
+    x.scatter( out, index, m );
+    for(size_type i = 0; i < 64; ++i){
+      auto k = std::find( offsets, offsets + 5, std::int64_t(i) ) - offsets;
+      EXPECT_EQ(out[i], k < 5 ? lanes[k] : double(-1));
+    }
+
+    x = m512d::gather( base, index );
+    x.scatter( out, index );
+    for(size_type i = 0; i < 8; ++i){
+      EXPECT_EQ(out[ offsets[i] ], base[ offsets[i] ]);
+    }
+    
+  } // end of test m512d.gather_scatter
+
+
+  TEST(m512, reductions)
+  {
+    alignas(64) float xs[ 16 ];
+    alignas(64) float ys[ 16 ];
+    float sum = 0.0f, product = 1.0f, inner = 0.0f;
+    for(size_type i = 0; i < 16; ++i){
+      xs[i] = float( (i*5) % 16 ) - float( 8 ) + 0.5f;
+      ys[i] = float( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m512 x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 16 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 16 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 16 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 16 ) - xs);
+    EXPECT_EQ(argmax( y ), 15);
+    
+  } // end of test m512.reductions
+
+  TEST(m512d, reductions)
+  {
+    alignas(64) double xs[ 8 ];
+    alignas(64) double ys[ 8 ];
+    double sum = 0.0, product = 1.0, inner = 0.0;
+    for(size_type i = 0; i < 8; ++i){
+      xs[i] = double( (i*5) % 8 ) - double( 4 ) + 0.5;
+      ys[i] = double( i + 1 );
+      sum += xs[i];
+      product *= xs[i] < 0 ? 0.5f : 2.0f;
+      inner += xs[i]*ys[i];
+    }
+    m512d x( xs ), y( ys );
+
+    EXPECT_EQ(hsum( x ), sum);
+    EXPECT_EQ(hprod( cond( x < decltype(x)( 0.0f ), decltype(x)( 0.5f ), decltype(x)( 2.0f ))), product);
+    EXPECT_EQ(dot( x, y ), inner);
+    EXPECT_EQ(hmin( x ), *std::min_element( xs, xs + 8 ));
+    EXPECT_EQ(hmax( x ), *std::max_element( xs, xs + 8 ));
+    EXPECT_EQ(argmin( x ), std::min_element( xs, xs + 8 ) - xs);
+    EXPECT_EQ(argmax( x ), std::max_element( xs, xs + 8 ) - xs);
+    EXPECT_EQ(argmax( y ), 7);
+    
+  } // end of test m512d.reductions
+
+  /** Check a shuffle of registers against the lanes it reads */
+  template< typename R, size_type ... I >
+  void
+  expect_shuffle(){
+    using T = typename R::value_type;
+    constexpr size_type n = R::extent;
+    constexpr array<size_type,n> index{{ I ... }};
+    alignas(64) T as[ n ], bs[ n ], out[ n ];
+    for( size_type i = 0; i < n; ++i ){
+      as[i] = T( i + 1 );
+      bs[i] = -T( i + 1 );
+    }
+    if constexpr ((( I < n ) && ... )){
+      R::template shuffle<I...>( R( as )).store( out );
+      for( size_type k = 0; k < n; ++k ){
+	EXPECT_EQ( out[k], as[ index[k] ] );
+      }
+    }
+    R::template shuffle<I...>( R( as ), R( bs )).store( out );
+    for( size_type k = 0; k < n; ++k ){
+      EXPECT_EQ( out[k], index[k] < n ? as[ index[k] ] : bs[ index[k] - n ] );
+    }
+  }
+
+  TEST(m512, shuffle)
+  {
+    expect_shuffle<m512, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14>();
+    expect_shuffle<m512, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0>();
+    expect_shuffle<m512, 1, 0, 17, 16, 5, 4, 21, 20, 9, 8, 25, 24, 13, 12, 29, 28>();
+    expect_shuffle<m512, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23>();
+    expect_shuffle<m512, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16>();
+    expect_shuffle<m512, 16, 17, 18, 19, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11>();
+
+    alignas(64) float xs[ 16 ], out[ 16 ];
+    for( size_type i = 0; i < 16; ++i ){
+      xs[i] = float( i + 1 );
+    }
+    inclusive_scan( m512( xs )).store( out );
+    for( size_type i = 0; i < 16; ++i ){
+      EXPECT_EQ( out[i], float( ( i + 1 )*( i + 2 )/2 ));
+    }
+    exclusive_scan( m512( xs )).store( out );
+    for( size_type i = 0; i < 16; ++i ){
+      EXPECT_EQ( out[i], float( i*( i + 1 )/2 ));
+    }
+    
+  } // end of test m512.shuffle
+
+  TEST(m512d, shuffle)
+  {
+    expect_shuffle<m512d, 1, 0, 3, 3, 4, 5, 7, 6>();
+    expect_shuffle<m512d, 7, 6, 5, 4, 3, 2, 1, 0>();
+    expect_shuffle<m512d, 1, 9, 2, 11, 5, 12, 7, 15>();
+    expect_shuffle<m512d, 0, 8, 1, 9, 2, 10, 3, 11>();
+    expect_shuffle<m512d, 15, 14, 13, 12, 11, 10, 9, 8>();
+    expect_shuffle<m512d, 8, 9, 0, 1, 2, 3, 4, 5>();
+
+    alignas(64) double xs[ 8 ] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    alignas(64) double out[ 8 ];
+    exclusive_scan( m512d( xs )).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], double( i*( i + 1 )/2 ));
+    }
+    
+  } // end of test m512d.shuffle
+
+  /** The distance of x from the reference r, in units of the last
+   *  place of the type of x */
+  template< typename T >
+  double
+  ulps( T x, long double r ){
+    if( std::isnan( r ) || std::isinf( r )){
+      return std::isnan( r ) == std::isnan( x ) && ( std::isnan( r ) || T( r ) == x )
+	? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    int e;
+    std::frexp( r, &e );
+    long double unit = std::max<long double>( std::ldexp( 1.0L, e - std::numeric_limits<T>::digits ),
+					      std::numeric_limits<T>::denorm_min() );
+    return double( std::fabs( x - r )/unit );
+  }
+
+  /** Check a function of registers against its reference on 1024
+   *  points evenly spaced in [lo,hi] */
+  template< typename R, typename F, typename G >
+  void
+  expect_ulps( F f, G g, double lo, double hi, double bound ){
+    using T = typename R::value_type;
+    constexpr size_type n = R::extent;
+    alignas(64) T xs[ n ], out[ n ];
+    for( size_type i = 0; i < 1024; i += n ){
+      for( size_type k = 0; k < n; ++k ){
+	xs[k] = T( lo + ( hi - lo )*double( i + k )/1023 );
+      }
+      f( R( xs )).store( out );
+      for( size_type k = 0; k < n; ++k ){
+	EXPECT_LE( ulps( out[k], g( (long double)( xs[k] ))), bound ) << "at " << xs[k];
+      }
+    }
+  }
+
+  template< typename R >
+  void
+  expect_math(){
+    namespace M = ShortVector::Private;
+    using T = typename R::value_type;
+    constexpr bool single = std::is_same_v<T,float>;
+    expect_ulps<R>( []( R x ){ return M::exp( x ); }, []( long double x ){ return std::exp( x ); }, -100, 88, 1 );
+    expect_ulps<R>( []( R x ){ return M::exp2( x ); }, []( long double x ){ return std::exp2( x ); }, -140, 127, single ? 1 : 1.5 );
+    expect_ulps<R>( []( R x ){ return M::log( x ); }, []( long double x ){ return std::log( x ); }, 1e-3, 1e3, single ? 1 : 1.5 );
+    expect_ulps<R>( []( R x ){ return M::log2( x ); }, []( long double x ){ return std::log2( x ); }, 1e-3, 4, 2 );
+    expect_ulps<R>( []( R x ){ return M::log1p( x ); }, []( long double x ){ return std::log1p( x ); }, -0.9, 2, single ? 1.5 : 2 );
+    expect_ulps<R>( []( R x ){ return M::sin( x ); }, []( long double x ){ return std::sin( x ); }, -100, 100, 2 );
+    expect_ulps<R>( []( R x ){ return M::sin( x ); }, []( long double x ){ return std::sin( x ); }, -1e6, 1e6, 2 );
+    expect_ulps<R>( []( R x ){ return M::cos( x ); }, []( long double x ){ return std::cos( x ); }, -100, 100, 2 );
+    expect_ulps<R>( []( R x ){ return M::cos( x ); }, []( long double x ){ return std::cos( x ); }, -1e6, 1e6, 2 );
+    expect_ulps<R>( []( R x ){ return M::tan( x ); }, []( long double x ){ return std::tan( x ); }, -100, 100, 4 );
+    expect_ulps<R>( []( R x ){ return M::tan( x ); }, []( long double x ){ return std::tan( x ); }, -1e6, 1e6, 4 );
+    expect_ulps<R>( []( R x ){ return M::atan2( x, R( T( -0.75 ))); }, []( long double x ){ return std::atan2( x, -0.75L ); }, -4, 4, 3 );
+    expect_ulps<R>( []( R x ){ return M::tanh( x ); }, []( long double x ){ return std::tanh( x ); }, -10, 10, 1.5 );
+    expect_ulps<R>( []( R x ){ return M::erf( x ); }, []( long double x ){ return std::erf( x ); }, -5, 5, 1 );
+    expect_ulps<R>( []( R x ){ return M::pow( x, R( T( 1.5 ))); }, []( long double x ){ return std::pow( x, 1.5L ); }, 0.5, 2, 2 );
+    expect_ulps<R>( []( R x ){ return M::inverse_sqrt<M::balanced_tag>( x ); }, []( long double x ){ return 1/std::sqrt( x ); }, 1e-3, 1e3, 4 );
+    expect_ulps<R>( []( R x ){ return M::reciprocal<M::balanced_tag>( x ); }, []( long double x ){ return 1/x; }, -1e3, -1e-3, 4 );
+    expect_ulps<R>( []( R x ){ return M::reciprocal<M::ieee_tag>( x ); }, []( long double x ){ return 1/x; }, 1e-3, 1e3, 0.5 );
+
+    constexpr T infinity = std::numeric_limits<T>::infinity();
+    alignas(64) T xs[ R::extent ], out[ R::extent ];
+    std::fill( xs, xs + R::extent, T( 0 ));
+    xs[1] = infinity;
+    xs[2] = -infinity;
+    xs[3] = std::numeric_limits<T>::quiet_NaN();
+    M::exp( R( xs )).store( out );
+    EXPECT_EQ( out[0], T( 1 ));
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::log( R( xs )).store( out );
+    EXPECT_EQ( out[0], -infinity );
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_TRUE( std::isnan( out[2] ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::inverse_sqrt<M::balanced_tag>( R( xs )).store( out );
+    EXPECT_EQ( out[0], infinity );
+    EXPECT_EQ( out[1], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[2] ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::reciprocal<M::balanced_tag>( R( xs )).store( out );
+    EXPECT_EQ( out[0], infinity );
+    EXPECT_EQ( out[1], T( 0 ));
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::pow( R( T( -2 )), R( xs )).store( out );
+    EXPECT_EQ( out[0], T( 1 ));
+    EXPECT_EQ( out[1], infinity );
+    EXPECT_EQ( out[2], T( 0 ));
+    EXPECT_TRUE( std::isnan( out[3] ));
+    M::pow( R( T( -2 )), R( T( 3 ))).store( out );
+    EXPECT_EQ( out[0], T( -8 ));
+
+    if constexpr( R::estimate_precision >= std::numeric_limits<T>::digits ){
+      rsqrt( R( T( 4 ))).store( out );
+      EXPECT_EQ( out[0], T( 0.5 ));
+      rcp( R( T( 3 ))).store( out );
+      EXPECT_EQ( out[0], T( 1 )/T( 3 ));
+    }
+    if constexpr( std::is_same_v<T,double> ){
+      for( double x : { 1e300, -1e300, 1e-300, -1e-300, 1e-40, -1e-40, 1e-45, -1e-45 } ){
+	M::reciprocal<M::balanced_tag>( R( x )).store( out );
+	EXPECT_LE( ulps( out[0], 1/(long double)( x )), 4 ) << x;
+	if( x > 0 ){
+	  M::inverse_sqrt<M::balanced_tag>( R( x )).store( out );
+	  EXPECT_LE( ulps( out[0], 1/std::sqrt( (long double)( x ))), 4 ) << x;
+	}
+      }
+    }
+  }
+
+  TEST(m512, math)
+  {
+    expect_math<m512>();
+    
+  } // end of test m512.math
+
+  TEST(m512d, math)
+  {
+    expect_math<m512d>();
+    
+  } // end of test m512d.math
+
+  TEST(m512, frexp)
+  {
+    alignas(64) float xs[ 16 ] = { 1.0f, 0.75f, -3.0f, 1024.5f, 1e-30f, 6e37f, 0.1f, -0.5f,
+				3.0f, 1e-3f, -7e20f, 1e10f, 2.0f, 0.25f, -8.0f, 100.0f };
+    alignas(64) float ms[ 16 ], es[ 16 ], out[ 16 ];
+    m512 e;
+    frexp( m512( xs ), e ).store( ms );
+    e.store( es );
+    for( size_type i = 0; i < 16; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], float( n ));
+    }
+    ldexp( m512( ms ), e ).store( out );
+    for( size_type i = 0; i < 16; ++i ){
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    ldexp( m512( 1.5f ), m512( -140.0f )).store( out );
+    EXPECT_EQ( out[0], std::ldexp( 1.5f, -140 ));
+    
+  } // end of test m512.frexp
+
+  TEST(m512d, frexp)
+  {
+    alignas(64) double xs[ 8 ] = { 1.0, -1024.5, 1e-300, 6e307, 0.75, -3.0, 0.1, 1e10 };
+    alignas(64) double ms[ 8 ], es[ 8 ], out[ 8 ];
+    m512d e;
+    frexp( m512d( xs ), e ).store( ms );
+    e.store( es );
+    for( size_type i = 0; i < 8; ++i ){
+      int n;
+      EXPECT_EQ( ms[i], std::frexp( xs[i], &n ));
+      EXPECT_EQ( es[i], double( n ));
+    }
+    ldexp( m512d( ms ), e ).store( out );
+    for( size_type i = 0; i < 8; ++i ){
+      EXPECT_EQ( out[i], xs[i] );
+    }
+    ldexp( m512d( 1.5 ), m512d( -1070.0 )).store( out );
+    EXPECT_EQ( out[0], std::ldexp( 1.5, -1070 ));
+    
+  } // end of test m512d.frexp
+
+  TEST(m512, conversions)
+  {
+    using ShortVector::Private::half;
+    using ShortVector::Private::bfloat16;
+
+    alignas(64) float xs[16];
+    for(size_type i = 0; i < 16; ++i){
+      xs[i] = std::ldexp( 1.0f + float( i )/16.0f + 1.0f/4096.0f, int( 3*i ) - 26 )*( i%2 ? 1.0f : -1.0f );
+    }
+    m512 x( xs );
+
+    half hs[16];
+    bfloat16 bs[16];
+    AVX512::narrow( x, hs );
+    AVX512::narrow( x, bs );
+    alignas(64) float h[16], b[16];
+    AVX512::widen( hs ).store( h );
+    AVX512::widen( bs ).store( b );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(hs[i].bits, half( xs[i] ).bits) << i;
+      EXPECT_EQ(h[i], float( half( xs[i] ))) << i;
+      EXPECT_EQ(b[i], float( bfloat16( xs[i] ))) << i;
+    }
+
+    auto ds = AVX512::widen( x );
+    alignas(64) double d[16];
+    ds[0].store( d );
+    ds[1].store( d + 8 );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(d[i], double( xs[i] ));
+    }
+    alignas(64) float f[16];
+    AVX512::narrow( ds[0], ds[1] ).store( f );
+    for(size_type i = 0; i < 16; ++i){
+      EXPECT_EQ(f[i], xs[i]);
+    }
+    
+  } // end of test m512.conversions
+
+  template< typename R >
+  void
+  expect_complex(){
+    using C = typename R::value_type;
+    using T = typename R::real_type;
+    constexpr size_type n = R::extent;
+    alignas(64) C xs[ 2*n ], ys[ 2*n ], out[ 2*n ];
+    alignas(64) T re[ 2*n ], im[ 2*n ];
+    for( size_type i = 0; i < 2*n; ++i ){
+      xs[i] = C( T( i ) - T( 2.5 ), T( 1 ) + T( 0.5 )*T( i ));
+      ys[i] = C( T( 0.25 )*T( i ) + T( 1 ), T( 3 ) - T( i ));
+    }
+    R x( xs ), y( ys );
+
+    ( x*y ).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], xs[i]*ys[i] );
+    }
+    ( x/y ).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_LE( std::abs( out[i] - xs[i]/ys[i] ), 4*std::numeric_limits<T>::epsilon()*std::abs( xs[i]/ys[i] ));
+    }
+    ( conj( x ) + norm( y )).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], std::conj( xs[i] ) + std::norm( ys[i] ));
+    }
+    ( -x*T( 2 ) - C( 1, -2 )).store( out );
+    for( size_type i = 0; i < n; ++i ){
+      EXPECT_EQ( out[i], -xs[i]*T( 2 ) - C( 1, -2 ));
+    }
+
+    auto xs_split = split( x, R( xs + n ));
+    auto ys_split = split( y, R( ys + n ));
+    xs_split.real().store( re );
+    xs_split.imag().store( im );
+    for( size_type i = 0; i < 2*n; ++i ){
+      EXPECT_EQ( C( re[i], im[i] ), xs[i] );
+    }
+    norm( xs_split ).store( re );
+    auto products = interleave( xs_split*ys_split );
+    products[0].store( out );
+    products[1].store( out + n );
+    for( size_type i = 0; i < 2*n; ++i ){
+      EXPECT_EQ( re[i], std::norm( xs[i] ));
+      EXPECT_EQ( out[i], xs[i]*ys[i] );
+    }
+  }
+
+  TEST(complex_m512, arithmetic)
+  {
+    expect_complex<AVX512::complex_m512>();
+    
+  } // end of test complex_m512.arithmetic
+
+  TEST(complex_m512d, arithmetic)
+  {
+    expect_complex<AVX512::complex_m512d>();
+    
+  } // end of test complex_m512d.arithmetic
+
+} // end of namespace
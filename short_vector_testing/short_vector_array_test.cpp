@@ -0,0 +1,121 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/array.hpp>
+
+namespace
+{
+  using ShortVector::Private::Short_vector_array;
+
+  template< typename T >
+  bool
+  aligned( T const* ptr, std::ptrdiff_t alignment ){
+    return std::uintptr_t( ptr ) % std::uintptr_t( alignment ) == 0;
+  }
+
+
+  TEST( short_vector_array, padding )
+  {
+    Short_vector_array<float,8,32> xs( 21 );
+
+    EXPECT_EQ(xs.size(), 21);
+    EXPECT_EQ(xs.fields(), 1);
+    EXPECT_EQ(xs.stride(), 32);
+    EXPECT_EQ(xs.tiles(), 4);
+    EXPECT_TRUE(aligned( xs.data(), 64 ));
+
+    for(std::ptrdiff_t i = 0; i < xs.stride(); ++i){
+      EXPECT_EQ(xs[i], 0.0f);
+    }
+
+    Short_vector_array<double,16,64> ys( 17 );
+    EXPECT_EQ(ys.stride(), 32);
+    EXPECT_EQ(ys.tiles(), 2);
+
+    Short_vector_array<float,24,32> wide( 10, 3 );
+    EXPECT_EQ(wide.stride(), 48);
+    EXPECT_EQ(wide.tiles(), 2);
+    for(std::ptrdiff_t f = 0; f < 3; ++f){
+      EXPECT_TRUE(aligned( wide.data( f ), 64 ));
+    }
+
+    Short_vector_array<double,4,32> empty( 0 );
+    EXPECT_EQ(empty.tiles(), 0);
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+  } // end of test short_vector_array.padding
+
+
+  TEST( short_vector_array, fields )
+  {
+    Short_vector_array<double,4,32> particles( 10, 4 );
+
+    EXPECT_EQ(particles.fields(), 4);
+    EXPECT_EQ(particles.stride(), 16);
+    for(std::ptrdiff_t f = 0; f < 4; ++f){
+      EXPECT_EQ(particles.data( f ), particles.data() + 16*f);
+      EXPECT_TRUE(aligned( particles.data( f ), 64 ));
+      for(std::ptrdiff_t i = 0; i < 10; ++i){
+	particles( f, i ) = double( 10*f + i );
+      }
+    }
+    EXPECT_EQ(particles[ 16 + 3 ], 13.0);
+
+    auto masses = particles.field( 3 );
+    EXPECT_EQ(masses.size(), 4);
+    std::ptrdiff_t k = 0;
+    for(auto tile : masses){
+      Short_vector_array<double,4,32>::short_vector x = tile;
+      for(std::ptrdiff_t i = 0; i < 4; ++i){
+	EXPECT_EQ(x[i], 4*k + i < 10 ? double( 30 + 4*k + i ) : 0.0);
+      }
+      ++k;
+    }
+    EXPECT_EQ(k, 4);
+
+    particles.tile( 0, 1 ) = particles.tile( 2, 1 );
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      EXPECT_EQ(particles( 0, 4 + i ), double( 24 + i ));
+    }
+
+  } // end of test short_vector_array.fields
+
+
+  TEST( short_vector_array, copy_and_move )
+  {
+    Short_vector_array<float,4,16> xs( 6, 2 );
+    for(std::ptrdiff_t i = 0; i < 6; ++i){
+      xs( 1, i ) = float( i );
+    }
+
+    auto ys = xs;
+    xs( 1, 0 ) = -1.0f;
+    EXPECT_NE(ys.data(), xs.data());
+    EXPECT_EQ(ys( 1, 0 ), 0.0f);
+    EXPECT_EQ(ys( 1, 5 ), 5.0f);
+
+    auto data = ys.data();
+    auto zs = std::move( ys );
+    EXPECT_EQ(zs.data(), data);
+    EXPECT_EQ(zs.fields(), 2);
+
+    zs = xs;
+    EXPECT_EQ(zs( 1, 0 ), -1.0f);
+
+  } // end of test short_vector_array.copy_and_move
+
+} // end of namespace
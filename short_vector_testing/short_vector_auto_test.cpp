@@ -1,3 +1,12 @@
+//
+// ... Standard header files
+//
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <complex>
+#include <type_traits>
+
 //
 // ... Testing header files
 //
@@ -8,11 +17,26 @@
 // ... Short Vector header files
 //
 #include <short_vector/core.hpp>
+#include <short_vector/math.hpp>
+#include <short_vector/expression.hpp>
+#include <short_vector/algorithm.hpp>
+#include <short_vector/view.hpp>
+#include <short_vector/convert.hpp>
+#include <short_vector/matrix.hpp>
+#include <short_vector/complex.hpp>
 
 namespace 
 {
   using ShortVector::Private::function_tag;
   using ShortVector::Private::Short_vector;
+  using ShortVector::Private::rotate;
+  using ShortVector::Private::reverse;
+  using ShortVector::Private::broadcast;
+  using ShortVector::Private::interleave_low;
+  using ShortVector::Private::interleave_high;
+  using ShortVector::Private::shift_up;
+  using ShortVector::Private::inclusive_scan;
+  using ShortVector::Private::exclusive_scan;
 
 
   TEST( short_vector_auto, value_construction )
@@ -280,6 +304,15 @@ namespace
     EXPECT_EQ(zs[1], 1.0);
     EXPECT_EQ(zs[2], 0.0);
     EXPECT_EQ(zs[3], 1.0);
+
+    xs[0] = std::numeric_limits<double>::quiet_NaN();
+    ys[0] = std::numeric_limits<double>::quiet_NaN();
+    xs[2] = std::numeric_limits<double>::quiet_NaN();
+
+    auto ws = xs != ys;
+
+    EXPECT_EQ(ws[0], 1.0);
+    EXPECT_EQ(ws[2], 1.0);
     
   } // end of test short_vector.not_equal
 
@@ -401,8 +434,415 @@ namespace
     
   } // end of test short_vector_auto.fma
 
+
+  TEST( short_vector_auto, mask )
+  {
+    constexpr Short_vector<double,4,64> xs([](auto x){ return double(x); }, function_tag{});
+    constexpr Short_vector<double,4,64> ys([](auto y){ return double(4-y); }, function_tag{});
+
+    constexpr auto lt = xs < ys;
+    constexpr auto ge = xs >= ys;
+
+    static_assert(lt[0] && lt[1] && ! lt[2] && ! lt[3]);
+    static_assert(popcount( lt ) == 2);
+    static_assert(none( lt & ge ));
+    static_assert(all( lt | ge ));
+
+    EXPECT_TRUE(any( lt ));
+    EXPECT_FALSE(all( lt ));
+    EXPECT_TRUE(all( lt ^ ge ));
+    EXPECT_TRUE(none( ~( lt | ge )));
+
+    constexpr auto zs = cond( lt, xs, ys );
+
+    static_assert(zs[0] == 0.0);
+    static_assert(zs[1] == 1.0);
+    static_assert(zs[2] == 2.0);
+    static_assert(zs[3] == 1.0);
+    
+  } // end of test short_vector_auto.mask
+
   
   
+
+  TEST( short_vector_auto, masked )
+  {
+    double xs[6] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    double ys[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    constexpr auto tail = Short_vector<double,4,64>::mask_type::first( 2 );
+    static_assert(tail[0] && tail[1] && ! tail[2] && ! tail[3]);
+
+    Short_vector<double,4,64> x( xs + 4, tail );
+
+    EXPECT_EQ(x[0], 5.0);
+    EXPECT_EQ(x[1], 6.0);
+    EXPECT_EQ(x[2], 0.0);
+    EXPECT_EQ(x[3], 0.0);
+
+    divide( tail, x, Short_vector<double,4,64>( 2.0 )).store( ys + 4, tail );
+
+    EXPECT_EQ(ys[3], 0.0);
+    EXPECT_EQ(ys[4], 2.5);
+    EXPECT_EQ(ys[5], 3.0);
+    
+  } // end of test short_vector_auto.masked
+
+
+  TEST( short_vector_auto, gather_scatter )
+  {
+    double base[8] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 };
+    Short_vector<int,4,64> index( 6, 1, 1, 3 );
+    auto tail = Short_vector<double,4,64>::mask_type::first( 2 );
+
+    auto xs = gather( base, index );
+    auto ys = gather( base, index, tail );
+
+    EXPECT_EQ(xs[0], 6.0);
+    EXPECT_EQ(xs[1], 1.0);
+    EXPECT_EQ(xs[2], 1.0);
+    EXPECT_EQ(xs[3], 3.0);
+    EXPECT_EQ(ys[0], 6.0);
+    EXPECT_EQ(ys[1], 1.0);
+    EXPECT_EQ(ys[2], 0.0);
+    EXPECT_EQ(ys[3], 0.0);
+
+    scatter( base, index, Short_vector<double,4,64>( 10.0, 11.0, 12.0, 13.0 ));
+    EXPECT_EQ(base[6], 10.0);
+    EXPECT_EQ(base[1], 12.0);
+    EXPECT_EQ(base[3], 13.0);
+
+    scatter( base, index, Short_vector<double,4,64>( 20.0, 21.0, 22.0, 23.0 ), tail );
+    EXPECT_EQ(base[6], 20.0);
+    EXPECT_EQ(base[1], 21.0);
+    EXPECT_EQ(base[3], 13.0);
+    
+  } // end of test short_vector_auto.gather_scatter
+
+
+  TEST( short_vector_auto, strided_views )
+  {
+    using ShortVector::Private::Strided_view;
+    using ShortVector::Private::Indexed_view;
+
+    double xs[12] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0 };
+    Strided_view<double,4,32,ShortVector::Private::auto_tag,3> column( xs + 1 );
+    Short_vector<double,4,32> x = column;
+    EXPECT_EQ(x[3], 10.0);
+
+    column -= Short_vector<double,4,32>( 1.0 );
+    EXPECT_EQ(xs[1], 0.0);
+    EXPECT_EQ(xs[2], 2.0);
+    EXPECT_EQ(xs[10], 9.0);
+
+    Indexed_view<double,4,32> picked( xs, Indexed_view<double,4,32>::index_vector( 11, 0, 2, 4 ));
+    Short_vector<double,4,32> y = picked * Short_vector<double,4,32>( column );
+    EXPECT_EQ(y[0], 0.0);
+    EXPECT_EQ(y[1], 0.0);
+    EXPECT_EQ(y[2], 12.0);
+    EXPECT_EQ(y[3], 27.0);
+
+    picked = 7.0;
+    EXPECT_EQ(xs[11], 7.0);
+    EXPECT_EQ(xs[4], 7.0);
+    EXPECT_EQ(xs[5], 5.0);
+
+  } // end of test short_vector_auto.strided_views
+
+
+  TEST( short_vector_auto, conversions )
+  {
+    using ShortVector::Private::half;
+    using ShortVector::Private::bfloat16;
+    using ShortVector::Private::convert;
+    using ShortVector::Private::widen;
+    using ShortVector::Private::narrow;
+
+    for(std::uint32_t bits = 0; bits < 0x10000; ++bits){
+      half h;
+      h.bits = std::uint16_t( bits );
+      float x = float( h );
+      if( std::isnan( x )){
+	EXPECT_EQ(bits & 0x7c00u, 0x7c00u);
+	EXPECT_TRUE(std::isnan( float( half( x ))));
+      } else {
+	EXPECT_EQ(half( x ).bits, bits) << bits;
+      }
+    }
+
+    EXPECT_EQ(float( half( 1.0f + std::ldexp( 1.0f, -11 ))), 1.0f);
+    EXPECT_EQ(float( half( 1.0f + 3.0f*std::ldexp( 1.0f, -11 ))), 1.0f + std::ldexp( 1.0f, -9 ));
+    EXPECT_EQ(float( half( 65519.0f )), 65504.0f);
+    EXPECT_EQ(float( half( 65520.0f )), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(float( half( std::ldexp( 1.0f, -24 ))), std::ldexp( 1.0f, -24 ));
+    EXPECT_EQ(float( half( std::ldexp( 1.0f, -26 ))), 0.0f);
+    EXPECT_EQ(half( -0.0f ).bits, 0x8000);
+
+    EXPECT_EQ(float( bfloat16( 1.0f + std::ldexp( 1.0f, -8 ))), 1.0f);
+    EXPECT_EQ(float( bfloat16( 1.0f + 3.0f*std::ldexp( 1.0f, -8 ))), 1.0f + std::ldexp( 1.0f, -6 ));
+    EXPECT_EQ(float( bfloat16( -3.5f )), -3.5f);
+    EXPECT_TRUE(std::isnan( float( bfloat16( std::numeric_limits<float>::quiet_NaN()))));
+
+    Short_vector<float,4,16> xs( 0.1f, -2.5f, 1e30f, 3.0f );
+    Short_vector<double,4,16> ys = convert<double>( xs );
+    EXPECT_EQ(ys[0], double( 0.1f ));
+    EXPECT_EQ(ys[2], double( 1e30f ));
+    EXPECT_EQ(convert<float>( Short_vector<double,4,16>( 0.1 ))[1], 0.1f);
+
+    half hs[4];
+    narrow( xs, hs );
+    EXPECT_EQ(hs[1].bits, half( -2.5f ).bits);
+    Short_vector<float,4,16> zs = widen<Short_vector<float,4,16>>( hs );
+    EXPECT_EQ(zs[3], 3.0f);
+    EXPECT_EQ(zs[2], std::numeric_limits<float>::infinity());
+
+  } // end of test short_vector_auto.conversions
+
+
+  TEST( short_vector_auto, half_vectors )
+  {
+    using ShortVector::Private::half;
+    using ShortVector::Private::bfloat16;
+    using ShortVector::Private::Short_view;
+    using vector_type = Short_vector<half,8,16>;
+
+    alignas(16) half xs[8];
+    alignas(16) bfloat16 ys[8];
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      xs[i] = half( 0.1f*float( i ));
+      ys[i] = bfloat16( 1000.0f + float( i ));
+    }
+
+    vector_type x = vector_type::load( xs );
+    Short_vector<bfloat16,8,16> y = Short_vector<bfloat16,8,16>::load( ys );
+    vector_type z = fma( x, vector_type( half( 3.0f )), vector_type( y.wide()));
+    z.store( xs );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      float expected = float( half( 0.1f*float( i )))*3.0f + float( bfloat16( 1000.0f + float( i )));
+      EXPECT_EQ(xs[i].bits, half( expected ).bits) << i;
+    }
+
+    Short_view<half,8,16> v( xs );
+    v = cond( x < 0.35f, x, vector_type( -1.0f ));
+    EXPECT_EQ(float( xs[3] ), float( half( 0.3f )));
+    EXPECT_EQ(float( xs[4] ), -1.0f);
+    EXPECT_EQ(hmax( vector_type( v )), float( half( 0.3f )));
+  } // end of test short_vector_auto.half_vectors
+
+
+  TEST( short_vector_auto, matrices )
+  {
+    using ShortVector::Private::Short_matrix;
+    using matrix_type = Short_matrix<double,4,4,32>;
+    using vector_type = Short_vector<double,4,32>;
+
+    // Unimodular, so that its inverse is exact
+    constexpr matrix_type a( vector_type( 1.0, 2.0, 0.0, 1.0 ), vector_type( 2.0, 5.0, 3.0, 2.0 ),
+			     vector_type( -1.0, 1.0, 10.0, 1.0 ), vector_type( 0.0, 1.0, 1.0, -3.0 ));
+    constexpr matrix_type b = inverse( a );
+    constexpr matrix_type c = a*b;
+    constexpr matrix_type t = transpose( a );
+    constexpr vector_type x = a*vector_type( 1.0, -1.0, 2.0, 0.5 );
+    constexpr vector_type y = vector_type( 1.0, -1.0, 2.0, 0.5 )*a;
+
+    static_assert( determinant( a ) == 1.0 );
+    static_assert( b( 0, 0 ) == -161.0 && b( 0, 1 ) == 71.0 && b( 1, 3 ) == 6.0 && b( 3, 3 ) == 1.0 );
+    static_assert( t( 1, 0 ) == 2.0 && t( 0, 1 ) == 2.0 && t( 3, 2 ) == 1.0 && t( 2, 3 ) == 1.0 );
+    static_assert( x[0] == -0.5 && x[1] == 4.0 && x[3] == -0.5 );
+    static_assert( y[0] == -3.0 && y[1] == -0.5 && y[2] == 17.5 );
+
+    constexpr matrix_type identity = matrix_type::identity();
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      for(std::ptrdiff_t j = 0; j < 4; ++j){
+	EXPECT_EQ(c( i, j ), identity( i, j ));
+	EXPECT_EQ(t( i, j ), a( j, i ));
+      }
+    }
+
+    using small_type = Short_matrix<double,3,3,8>;
+    using row_type = Short_vector<double,3,8>;
+    constexpr small_type m( row_type( 2.0, 0.0, 1.0 ), row_type( 1.0, 3.0, 0.0 ), row_type( 0.0, 1.0, 1.0 ));
+    static_assert( determinant( m ) == 7.0 );
+    constexpr small_type n = inverse( m )*7.0;
+    EXPECT_DOUBLE_EQ(n( 0, 0 ), 3.0);
+    EXPECT_DOUBLE_EQ(n( 0, 2 ), -3.0);
+    EXPECT_DOUBLE_EQ(n( 1, 0 ), -1.0);
+    EXPECT_DOUBLE_EQ(n( 2, 1 ), -2.0);
+    EXPECT_DOUBLE_EQ(n( 2, 2 ), 6.0);
+
+    using pair_type = Short_vector<double,2,16>;
+    constexpr Short_matrix<double,2,2,16> p( pair_type( 3.0, 5.0 ), pair_type( 2.0, 4.0 ));
+    static_assert( determinant( p ) == 2.0 );
+    static_assert( inverse( p )( 0, 0 ) == 2.0 && inverse( p )( 0, 1 ) == -2.5 );
+    static_assert( inverse( p )( 1, 0 ) == -1.0 && inverse( p )( 1, 1 ) == 1.5 );
+  } // end of test short_vector_auto.matrices
+
+
+  TEST( short_vector_auto, lazy )
+  {
+    using ShortVector::Private::lazy;
+    using ShortVector::Private::evaluate;
+    Short_vector<double,4,64> as( 1.0, 2.0, 3.0, 4.0 );
+    Short_vector<double,4,64> bs( 2.0, 3.0, 5.0, 7.0 );
+    Short_vector<double,4,64> cs( 0.5, 0.25, 0.125, 1.0 );
+
+    Short_vector<double,4,64> xs = lazy( as )*bs + cs*as - 1.0;
+    auto ys = evaluate(( lazy( as ) + bs )/( cs - 2.0 ));
+    static_assert( std::is_same_v<decltype(ys), Short_vector<double,4,64>> );
+
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      EXPECT_EQ(xs[i], as[i]*bs[i] + cs[i]*as[i] - 1.0);
+      EXPECT_EQ(ys[i], ( as[i] + bs[i] )/( cs[i] - 2.0 ));
+    }
+
+    Short_vector<int,8,32> is([](auto i){ return int(i); }, function_tag{});
+    Short_vector<int,8,32> js = 3*lazy( is )*is - is + 1;
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ(js[i], int( 3*i*i - i + 1 ));
+    }
+    
+  } // end of test short_vector_auto.lazy
+
+
+  TEST( short_vector_auto, algorithms )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<double,4,32>;
+    alignas(32) double xs[23];
+    alignas(32) double ys[23];
+    for(std::ptrdiff_t i = 0; i < 23; ++i){
+      xs[i] = double(i);
+      ys[i] = 0.0;
+    }
+
+    SV::transform<vector_type>( xs + 2, 20, ys + 1, []( vector_type const& x ){ return 3.0*x; });
+    SV::for_each<vector_type>( ys + 5, 6, []( vector_type& x ){ x += 1.0; });
+    SV::fill<vector_type>( ys + 21, 2, 7.0 );
+    for(std::ptrdiff_t i = 0; i < 23; ++i){
+      double expected = i == 0 ? 0.0 : i > 20 ? 7.0 : 3.0*double( i + 1 );
+      EXPECT_EQ(ys[i], expected + ( i >= 5 && i < 11 ? 1.0 : 0.0 ));
+    }
+
+    auto plus = []( auto const& a, auto const& b ){ return a + b; };
+    EXPECT_EQ(SV::transform_reduce<vector_type>( xs + 1, 10, 0.5, plus, []( vector_type const& x ){ return x; }), 55.5);
+    EXPECT_EQ(SV::transform_reduce<vector_type>( xs, ys, 3, 0.0, plus,
+						  []( vector_type const& x, vector_type const& y ){ return x*y; }),
+	      0.0*0.0 + 1.0*6.0 + 2.0*9.0);
+    
+  } // end of test short_vector_auto.algorithms
+
+
+  TEST( short_vector_auto, reductions )
+  {
+    constexpr Short_vector<double,4,64> xs( 3.0, -1.0, 4.0, 2.0 );
+    constexpr Short_vector<double,4,64> ys( 1.0, 2.0, 3.0, 4.0 );
+
+    static_assert(hsum( xs ) == 8.0);
+    static_assert(hprod( xs ) == -24.0);
+    static_assert(hmin( xs ) == -1.0);
+    static_assert(hmax( xs ) == 4.0);
+    static_assert(dot( xs, ys ) == 21.0);
+    static_assert(argmin( xs ) == 1);
+    static_assert(argmax( xs ) == 2);
+    static_assert(find_first( xs > 5.0 ) == 4);
+    
+  } // end of test short_vector_auto.reductions
+
+  TEST( short_vector_auto, shuffle )
+  {
+    using ShortVector::Private::shuffle;
+    constexpr Short_vector<double,4,64> xs( 1.0, 2.0, 3.0, 4.0 );
+    constexpr Short_vector<double,4,64> ys( 5.0, 6.0, 7.0, 8.0 );
+
+    constexpr auto swapped = shuffle<1, 0, 3, 2>( xs );
+    constexpr auto mixed = shuffle<7, 0, 4, 2>( xs, ys );
+    constexpr auto rotated = rotate<1>( xs );
+    constexpr auto reversed = reverse( xs );
+    constexpr auto broadcasted = broadcast<2>( xs );
+    constexpr auto low = interleave_low( xs, ys );
+    constexpr auto high = interleave_high( xs, ys );
+
+    static_assert(swapped[0] == 2.0 && swapped[1] == 1.0 && swapped[2] == 4.0 && swapped[3] == 3.0);
+    static_assert(mixed[0] == 8.0 && mixed[1] == 1.0 && mixed[2] == 5.0 && mixed[3] == 3.0);
+    static_assert(rotated[0] == 2.0 && rotated[1] == 3.0 && rotated[2] == 4.0 && rotated[3] == 1.0);
+    static_assert(reversed[0] == 4.0 && reversed[1] == 3.0 && reversed[2] == 2.0 && reversed[3] == 1.0);
+    static_assert(broadcasted[0] == 3.0 && broadcasted[3] == 3.0);
+    static_assert(low[0] == 1.0 && low[1] == 5.0 && low[2] == 2.0 && low[3] == 6.0);
+    static_assert(high[0] == 3.0 && high[1] == 7.0 && high[2] == 4.0 && high[3] == 8.0);
+
+    constexpr Short_vector<int,8,32> ns( 1, 2, 3, 4, 5, 6, 7, 8 );
+    constexpr auto shifted = shift_up<2>( xs, ys );
+    constexpr auto inclusive = inclusive_scan( ns );
+    constexpr auto exclusive = exclusive_scan( ns );
+
+    static_assert(shifted[0] == 5.0 && shifted[1] == 6.0 && shifted[2] == 1.0 && shifted[3] == 2.0);
+    static_assert(inclusive[0] == 1 && inclusive[3] == 10 && inclusive[7] == 36);
+    static_assert(exclusive[0] == 0 && exclusive[3] == 6 && exclusive[7] == 28);
+    
+  } // end of test short_vector_auto.shuffle
+
+  TEST( short_vector_auto, math )
+  {
+    constexpr Short_vector<double,4,64> xs( 0.5, -1.25, 3.0, 10.5 );
+
+    static_assert(min( xs, Short_vector<double,4,64>( 1.0 ))[3] == 1.0);
+    static_assert(max( xs, Short_vector<double,4,64>( 1.0 ))[1] == 1.0);
+
+    auto exps = exp( xs );
+    auto logs = log1p( abs( xs ));
+    auto cubes = pow( xs, Short_vector<double,4,64>( 3.0 ));
+    auto cosines = cos( xs );
+    auto tangents = tan( xs );
+    auto exponents = xs;
+    auto significands = frexp( xs, exponents );
+    auto scaled = ldexp( significands, exponents );
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      int e;
+      EXPECT_DOUBLE_EQ(exps[i], std::exp( xs[i] ));
+      EXPECT_DOUBLE_EQ(logs[i], std::log1p( std::abs( xs[i] )));
+      EXPECT_DOUBLE_EQ(cubes[i], xs[i]*xs[i]*xs[i]);
+      EXPECT_DOUBLE_EQ(cosines[i], std::cos( xs[i] ));
+      EXPECT_DOUBLE_EQ(tangents[i], std::tan( xs[i] ));
+      EXPECT_EQ(significands[i], std::frexp( xs[i], &e ));
+      EXPECT_EQ(exponents[i], double( e ));
+      EXPECT_EQ(scaled[i], xs[i]);
+    }
+    
+  } // end of test short_vector_auto.math
+
+  TEST( short_vector_auto, complex_values )
+  {
+    using C = std::complex<double>;
+    Short_vector<C,4,64> xs([](auto i){ return C( 1.5*double( i ) - 2.0, 0.5 - double( i )); }, function_tag{});
+    Short_vector<C,4,64> ys( C( 0.25, -2.0 ));
+    alignas(64) C zs[4] = { C( 1, 1 ), C( -2, 0.5 ), C( 0, 3 ), C( 4, -1 ) };
+
+    auto products = xs*ys + Short_vector<C,4,64>::load( zs );
+    auto quotients = xs/ys;
+    auto conjugates = conj( xs )*2.0;
+    auto norms = norm( xs );
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      EXPECT_EQ(products[i], xs[i]*ys[i] + zs[i]);
+      EXPECT_NEAR(quotients[i].real(), ( xs[i]/ys[i] ).real(), 1e-15);
+      EXPECT_NEAR(quotients[i].imag(), ( xs[i]/ys[i] ).imag(), 1e-15);
+      EXPECT_EQ(conjugates[i], std::conj( xs[i] )*2.0);
+      EXPECT_EQ(norms[i], C( std::norm( xs[i] )));
+    }
+
+    products.store( zs );
+    auto split_products = split( products, xs );
+    static_assert(std::is_same_v<decltype( split_products.real()), Short_vector<double,8,64> const&>);
+    auto back = interleave( split_products );
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      EXPECT_EQ(zs[i], products[i]);
+      EXPECT_EQ(split_products.real()[i], products[i].real());
+      EXPECT_EQ(split_products.imag()[i + 4], xs[i].imag());
+      EXPECT_EQ(back[0][i], products[i]);
+      EXPECT_EQ(back[1][i], xs[i]);
+    }
+    
+  } // end of test short_vector_auto.complex_values
+
 } // end of namespace
 
 
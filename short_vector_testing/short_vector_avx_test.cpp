@@ -0,0 +1,1090 @@
+//
+// ... Standard header files
+//
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <utility>
+#include <complex>
+#include <numeric>
+
+//
+// ... Testing header files
+//
+#include <gtest/gtest.h>
+
+
+//
+// ... Short Vector header files
+//
+#include <short_vector/core.hpp>
+#include <short_vector/avx/m256.hpp>
+#include <short_vector/avx/m256d.hpp>
+#include <short_vector/avx/m256i.hpp>
+#include <short_vector/math.hpp>
+#include <short_vector/array.hpp>
+#include <short_vector/expression.hpp>
+#include <short_vector/algorithm.hpp>
+#include <short_vector/view.hpp>
+#include <short_vector/convert.hpp>
+#include <short_vector/avx/convert.hpp>
+#include <short_vector/matrix.hpp>
+#include <short_vector/solve.hpp>
+#include <short_vector/avx/complex.hpp>
+#include <short_vector/parallel.hpp>
+
+namespace 
+{
+  using ShortVector::Private::function_tag;
+  using ShortVector::Private::avx_tag;
+  using ShortVector::Private::Short_vector;
+  using ShortVector::Private::rotate;
+  using ShortVector::Private::reverse;
+  using ShortVector::Private::broadcast;
+  using ShortVector::Private::interleave_low;
+  using ShortVector::Private::interleave_high;
+  using ShortVector::Private::inverse_sqrt;
+  using ShortVector::Private::reciprocal;
+  using ShortVector::Private::fast_tag;
+  using ShortVector::Private::balanced_tag;
+
+  using AVX::m256;
+  using AVX::m256d;
+
+
+  TEST( short_vector_avx, storage )
+  {
+    static_assert( std::is_same_v<Short_vector<float,8,32,avx_tag>::storage_type, std::array<m256,1>> );
+    static_assert( std::is_same_v<Short_vector<float,16,32,avx_tag>::storage_type, std::array<m256,2>> );
+    static_assert( std::is_same_v<Short_vector<double,4,32,avx_tag>::storage_type, std::array<m256d,1>> );
+    static_assert( std::is_same_v<Short_vector<double,8,64,avx_tag>::storage_type, std::array<m256d,2>> );
+
+    static_assert( sizeof(Short_vector<float,8,32,avx_tag>) == sizeof(__m256));
+    static_assert( sizeof(Short_vector<double,8,64,avx_tag>) == 2*sizeof(__m256d));
+    
+  } // end of test short_vector_avx.storage
+  
+
+  TEST( short_vector_avx, value_construction )
+  {
+    Short_vector<float,8,32,avx_tag> xs( 2.0f );
+
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ( xs[i], 2.0f );
+    }
+    
+    EXPECT_EQ( xs.size(), 8 );
+
+  } // end of test short_vector_avx.value_construction
+
+  
+  TEST( short_vector_avx, multivalue_construction )
+  {
+    Short_vector<double,4,32,avx_tag> xs( 1.0, 2.0, 3.0, 4.0 );
+    
+    EXPECT_EQ( xs[0], 1.0);
+    EXPECT_EQ( xs[1], 2.0);
+    EXPECT_EQ( xs[2], 3.0);
+    EXPECT_EQ( xs[3], 4.0);
+    
+  } // end of test short_vector_avx.multivalue_construction
+
+  
+  TEST( short_vector_avx, element_assignment )
+  {
+    Short_vector<float,16,32,avx_tag> xs( 0.0f );
+    xs[3] = 3.0f;
+    xs[12] = 12.0f;
+    
+    EXPECT_EQ( xs[2], 0.0f);
+    EXPECT_EQ( xs[3], 3.0f);
+    EXPECT_EQ( xs[12], 12.0f);
+    EXPECT_EQ( xs[13], 0.0f);
+
+  } // end of test short_vector_avx.element_assignment
+
+  
+  TEST( short_vector_avx, arithmetic )
+  {
+    Short_vector<float,16,32,avx_tag> xs([](auto x){ return float(x); }, function_tag{});
+    Short_vector<float,16,32,avx_tag> ys([](auto y){ return float(y*y); }, function_tag{});
+
+    auto zs = (xs + ys)*2.0f - xs/(ys + 1.0f);
+    
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      float x = i;
+      float y = i*i;
+      EXPECT_FLOAT_EQ( zs[i], (x + y)*2.0f - x/(y + 1.0f));
+    }
+    
+  } // end of test short_vector_avx.arithmetic
+
+  
+  TEST( short_vector_avx, arithmetic_inplace )
+  {
+    Short_vector<double,8,32,avx_tag> xs([](auto x){ return double(x); }, function_tag{});
+    Short_vector<double,8,32,avx_tag> ys([](auto y){ return double(y*y); }, function_tag{});
+
+    xs += ys;
+    xs *= 2.0;
+    xs -= 1.0;
+
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ( xs[i], 2.0*double(i + i*i) - 1.0);
+    }
+    
+  } // end of test short_vector_avx.arithmetic_inplace
+
+  
+  TEST( short_vector_avx, comparison )
+  {
+    Short_vector<double,4,32,avx_tag> xs([](auto x){ return double(x); }, function_tag{});
+    Short_vector<double,4,32,avx_tag> ys([](auto y){ return double(4-y); }, function_tag{});
+
+    auto lt = xs < ys;
+    auto eq = xs == ys;
+    auto ge = xs >= ys;
+
+    EXPECT_EQ(lt[0], 1.0);
+    EXPECT_EQ(lt[1], 1.0);
+    EXPECT_EQ(lt[2], 0.0);
+    EXPECT_EQ(lt[3], 0.0);
+
+    EXPECT_EQ(eq[0], 0.0);
+    EXPECT_EQ(eq[1], 0.0);
+    EXPECT_EQ(eq[2], 1.0);
+    EXPECT_EQ(eq[3], 0.0);
+
+    EXPECT_EQ(ge[0], 0.0);
+    EXPECT_EQ(ge[1], 0.0);
+    EXPECT_EQ(ge[2], 1.0);
+    EXPECT_EQ(ge[3], 1.0);
+
+    xs[0] = std::numeric_limits<double>::quiet_NaN();
+    ys[0] = std::numeric_limits<double>::quiet_NaN();
+    xs[2] = std::numeric_limits<double>::quiet_NaN();
+
+    auto ne = xs != ys;
+
+    EXPECT_EQ(ne[0], 1.0);
+    EXPECT_EQ(ne[1], 1.0);
+    EXPECT_EQ(ne[2], 1.0);
+    EXPECT_EQ(ne[3], 1.0);
+    
+  } // end of test short_vector_avx.comparison
+
+
+  TEST( short_vector_avx, mask )
+  {
+    Short_vector<float,16,32,avx_tag> xs([](auto x){ return float(x); }, function_tag{});
+    Short_vector<float,16,32,avx_tag> ys([](auto y){ return float(15-y); }, function_tag{});
+
+    auto lt = xs < ys;
+    auto eq = xs == 3.0f;
+
+    EXPECT_EQ(popcount( lt ), 8);
+    EXPECT_TRUE(any( lt & eq ));
+    EXPECT_TRUE(none( ~lt & eq ));
+    EXPECT_TRUE(all( lt | ( xs >= ys )));
+    EXPECT_FALSE(all( lt ^ eq ));
+    EXPECT_TRUE(all( decltype(lt)( true )));
+
+    auto zs = cond( lt, xs, ys );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ( lt[i], i < 8 );
+      EXPECT_EQ( zs[i], float( std::min( i, 15 - i )));
+    }
+    
+  } // end of test short_vector_avx.mask
+  
+
+  TEST( short_vector_avx, fma )
+  {
+    Short_vector<float,8,32,avx_tag> as([](auto x){ return float(x+1); }, function_tag{});
+    Short_vector<float,8,32,avx_tag> bs([](auto x){ return float(x+2); }, function_tag{});
+    Short_vector<float,8,32,avx_tag> cs([](auto x){ return float(x+3); }, function_tag{});
+
+    auto ds = fma(as,bs,cs);
+    auto es = fms(as,bs,cs);
+    auto fs = fnma(as,bs,cs);
+    auto gs = fnms(as,bs,cs);
+
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ(ds[i],  as[i]*bs[i] + cs[i]);
+      EXPECT_EQ(es[i],  as[i]*bs[i] - cs[i]);
+      EXPECT_EQ(fs[i], -as[i]*bs[i] + cs[i]);
+      EXPECT_EQ(gs[i], -as[i]*bs[i] - cs[i]);
+    }
+    
+  } // end of test short_vector_avx.fma
+
+
+  TEST( short_vector_avx, lazy )
+  {
+    using ShortVector::Private::lazy;
+    using vector_type = Short_vector<float,64,32,avx_tag>;
+    vector_type as([](auto x){ return 1.0f + float(x)/4096.0f; }, function_tag{});
+    vector_type bs([](auto x){ return 3.0f - float(x)/8192.0f; }, function_tag{});
+    vector_type cs([](auto x){ return float(x%7) + 0.1f; }, function_tag{});
+    vector_type ds([](auto x){ return 1.0f/float(x+1); }, function_tag{});
+    vector_type es([](auto x){ return float(x)*0.3f; }, function_tag{});
+
+    auto expression = lazy( as )*bs + cs*ds - es;
+    auto fused = lazy( as )*bs + lazy( cs )*ds - es;
+    static_assert( ! std::is_same_v<decltype(expression), vector_type> );
+
+    vector_type xs = expression;
+    vector_type ys = 2.0f*lazy( as ) - cs/ds;
+    vector_type zs = es - lazy( as )*bs;
+    for(std::ptrdiff_t i = 0; i < 64; ++i){
+      EXPECT_EQ(xs[i], std::fma( as[i], bs[i], cs[i]*ds[i] ) - es[i]) << i;
+      EXPECT_EQ(vector_type( fused )[i], xs[i]) << i;
+      EXPECT_EQ(ys[i], std::fma( 2.0f, as[i], -( cs[i]/ds[i] ))) << i;
+      EXPECT_EQ(zs[i], std::fma( -as[i], bs[i], es[i] )) << i;
+    }
+
+    vector_type ws = as;
+    ws = lazy( ws )*bs + ws;
+    ws += lazy( as )/bs;
+    for(std::ptrdiff_t i = 0; i < 64; ++i){
+      EXPECT_EQ(ws[i], std::fma( as[i], bs[i], as[i] ) + as[i]/bs[i]) << i;
+    }
+    
+  } // end of test short_vector_avx.lazy
+  
+
+  TEST( short_vector_avx, masked )
+  {
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+    float xs[21];
+    float ys[21];
+    for(std::ptrdiff_t i = 0; i < 21; ++i){
+      xs[i] = float(i);
+      ys[i] = -1.0f;
+    }
+
+    auto tail = vector_type::mask_type::first( 5 );
+    EXPECT_EQ(popcount( tail ), 5);
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(tail[i], i < 5);
+    }
+
+    vector_type x( xs + 16, tail );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(x[i], i < 5 ? xs[16+i] : 0.0f);
+    }
+
+    add( tail, x, vector_type( 1.0f )).store( ys + 16, tail );
+    for(std::ptrdiff_t i = 0; i < 21; ++i){
+      EXPECT_EQ(ys[i], i < 16 ? -1.0f : xs[i] + 1.0f);
+    }
+    
+  } // end of test short_vector_avx.masked
+
+  TEST( short_vector_avx, gather_scatter )
+  {
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+    using index_type = Short_vector<std::int32_t,16,32,avx_tag>;
+    float base[40];
+    for(std::ptrdiff_t i = 0; i < 40; ++i){
+      base[i] = float(i) + 0.25f;
+    }
+
+    index_type index([](auto i){ return std::int32_t(( 3*i + 1 ) % 40 ); }, function_tag{});
+    auto xs = gather( base, index );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(xs[i], base[ index[i] ]);
+    }
+
+    auto tail = vector_type::mask_type::first( 11 );
+    auto ys = gather( base, index, tail );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(ys[i], i < 11 ? base[ index[i] ] : 0.0f);
+    }
+
+    float out[40];
+    for(std::ptrdiff_t i = 0; i < 40; ++i){
+      out[i] = -1.0f;
+    }
+    scatter( out, index, xs + 1.0f, tail );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(out[ index[i] ], i < 11 ? base[ index[i] ] + 1.0f : -1.0f);
+    }
+
+    index_type repeated([](auto i){ return std::int32_t( i % 3 ); }, function_tag{});
+    vector_type zs([](auto i){ return float(i); }, function_tag{});
+    scatter( out, repeated, zs );
+    EXPECT_EQ(out[0], 15.0f);
+    EXPECT_EQ(out[1], 13.0f);
+    EXPECT_EQ(out[2], 14.0f);
+
+    Short_vector<double,8,32,avx_tag> ds([](auto i){ return double(i); }, function_tag{});
+    Short_vector<std::int64_t,8,32,avx_tag> reversed([](auto i){ return std::int64_t(7 - i); }, function_tag{});
+    double buffer[8];
+    ds.scatter( buffer, reversed );
+    auto back = Short_vector<double,8,32,avx_tag>::gather( buffer, reversed );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ(buffer[i], double(7 - i));
+      EXPECT_EQ(back[i], double(i));
+    }
+    
+  } // end of test short_vector_avx.gather_scatter
+
+
+  TEST( short_vector_avx, array )
+  {
+    using ShortVector::Private::Short_vector_array;
+    Short_vector_array<float,16,32,avx_tag> xs( 40, 2 );
+    for(std::ptrdiff_t i = 0; i < 40; ++i){
+      xs( 0, i ) = float(i);
+    }
+
+    EXPECT_EQ(xs.tiles(), 3);
+    for(std::ptrdiff_t k = 0; k < xs.tiles(); ++k){
+      Short_vector<float,16,32,avx_tag> x = xs.tile( 0, k );
+      x.store( xs.data( 1 ) + 16*k, ( 2.0f*x ) > 10.0f );
+    }
+    for(std::ptrdiff_t i = 0; i < xs.stride(); ++i){
+      EXPECT_EQ(xs( 1, i ), i > 5 && i < 40 ? float(i) : 0.0f);
+    }
+    
+  } // end of test short_vector_avx.array
+
+
+  TEST( short_vector_avx, load_store )
+  {
+    using vector_type = Short_vector<double,8,32,avx_tag>;
+    alignas(32) double xs[9];
+    alignas(32) double ys[9];
+    for(std::ptrdiff_t i = 0; i < 9; ++i){
+      xs[i] = double(i);
+      ys[i] = -1.0;
+    }
+
+    auto a = vector_type::load( xs );
+    auto b = vector_type::load( ShortVector::Private::unaligned<double>{ xs + 1 });
+    ( a + b ).store( ShortVector::Private::unaligned<double>{ ys + 1 });
+    EXPECT_EQ(ys[0], -1.0);
+    for(std::ptrdiff_t i = 1; i < 9; ++i){
+      EXPECT_EQ(ys[i], double( 2*i - 1 ));
+    }
+
+    b.store( ShortVector::Private::stream<double>{ ys });
+    a.store( xs );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ(ys[i], double( i + 1 ));
+      EXPECT_EQ(xs[i], double( i ));
+    }
+    
+  } // end of test short_vector_avx.load_store
+
+
+  TEST( short_vector_avx, views )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+    using view_type = SV::Short_view<float,16,32,avx_tag>;
+    using unaligned_view = SV::Short_view<float,16,32,avx_tag,SV::unaligned>;
+    using stream_view = SV::Short_view<float,16,32,avx_tag,SV::stream>;
+
+    alignas(32) float xs[48];
+    for(std::ptrdiff_t i = 0; i < 48; ++i){
+      xs[i] = float( i );
+    }
+
+    view_type a( xs ), b( xs + 16 );
+    vector_type x = b;
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(x[i], float( 16 + i ));
+    }
+
+    (( a += x ) *= 2.0f ) -= 1.0f;
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(xs[i], 2.0f*float( 16 + 2*i ) - 1.0f);
+    }
+    ( a = b ) /= vector_type( 2.0f );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(xs[i], float( 16 + i )/2.0f);
+    }
+
+    unaligned_view c( xs + 3 );
+    vector_type y = vector_type( c ) + b;
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(y[i], xs[ 3 + i ] + float( 16 + i ));
+    }
+    c = 0.5f;
+    EXPECT_EQ(xs[2], 9.0f);
+    for(std::ptrdiff_t i = 3; i < 19; ++i){
+      EXPECT_EQ(xs[i], 0.5f);
+    }
+    EXPECT_EQ(xs[19], 19.0f);
+
+    stream_view d( xs + 32 );
+    d = y;
+    d += vector_type( 1.0f );
+    SV::Algorithms::fence();
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(xs[ 32 + i ], y[i] + 1.0f);
+    }
+    
+  } // end of test short_vector_avx.views
+
+
+  TEST( short_vector_avx, strided_views )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+
+    std::vector<float> xs( 16*5 );
+    for(std::ptrdiff_t i = 0; i < 16*5; ++i){
+      xs[i] = float( i );
+    }
+
+    SV::Strided_view<float,16,32,avx_tag,5> column( xs.data() + 2 );
+    vector_type x = column;
+    for(std::ptrdiff_t k = 0; k < 16; ++k){
+      EXPECT_EQ(x[k], float( 5*k + 2 ));
+    }
+
+    column *= 2.0f;
+    column += column;
+    for(std::ptrdiff_t i = 0; i < 16*5; ++i){
+      EXPECT_EQ(xs[i], i%5 == 2 ? 4.0f*float( i ) : float( i ));
+    }
+
+    SV::Strided_view<float,16,32,avx_tag> backward( xs.data() + 16*5 - 1, -5 ), row( xs.data(), 1 );
+    EXPECT_EQ(backward.stride(), -5);
+    vector_type y = backward - row;
+    for(std::ptrdiff_t k = 0; k < 16; ++k){
+      EXPECT_EQ(y[k], float( 16*5 - 1 - 5*k ) - xs[k]);
+    }
+    row = backward;
+    for(std::ptrdiff_t k = 0; k < 16; ++k){
+      EXPECT_EQ(xs[k], float( 16*5 - 1 - 5*k ));
+    }
+
+    using index_vector = SV::Indexed_view<double,8,32,avx_tag>::index_vector;
+    std::vector<double> ys( 20, 1.0 );
+    SV::Indexed_view<double,8,32,avx_tag> picked( ys.data(), index_vector( 19, 0, 3, 3, 7, 11, 2, 5 ));
+    picked = Short_vector<double,8,32,avx_tag>( 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 );
+    picked /= 2.0;
+    EXPECT_EQ(ys[19], 0.5);
+    EXPECT_EQ(ys[3], 2.0);
+    EXPECT_EQ(ys[5], 4.0);
+    EXPECT_EQ(ys[1], 1.0);
+    Short_vector<double,8,32,avx_tag> z = 1.0 + picked;
+    EXPECT_EQ(z[2], 3.0);
+    EXPECT_EQ(z[3], 3.0);
+    
+  } // end of test short_vector_avx.strided_views
+
+
+  TEST( short_vector_avx, conversions )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+
+    alignas(32) float xs[64];
+    for(std::ptrdiff_t i = 0; i < 64; ++i){
+      xs[i] = std::ldexp( 1.0f + float( i )/64.0f + 1.0f/4096.0f, int( i%40 ) - 26 )*( i%3 ? 1.0f : -1.0f );
+    }
+    xs[5] = std::numeric_limits<float>::infinity();
+    xs[6] = std::numeric_limits<float>::quiet_NaN();
+    xs[7] = 1.0f + std::ldexp( 1.0f, -11 );
+    xs[8] = 1.0f + std::ldexp( 1.0f, -8 );
+
+    for(std::ptrdiff_t k = 0; k < 64; k += 16){
+      vector_type x = vector_type::load( xs + k );
+
+      SV::half hs[16];
+      SV::narrow( x, hs );
+      vector_type h = SV::widen<vector_type>( hs );
+      SV::bfloat16 bs[16];
+      SV::narrow( x, bs );
+      vector_type b = SV::widen<vector_type>( bs );
+      for(std::ptrdiff_t i = 0; i < 16; ++i){
+	float expected = float( SV::half( xs[ k + i ]));
+	if( std::isnan( expected )){
+	  EXPECT_TRUE(std::isnan( h[i] ));
+	} else {
+	  EXPECT_EQ(hs[i].bits, SV::half( xs[ k + i ]).bits) << k + i;
+	  EXPECT_EQ(h[i], expected) << k + i;
+	}
+	EXPECT_EQ(bs[i].bits, SV::bfloat16( xs[ k + i ]).bits) << k + i;
+	float truncated = float( SV::bfloat16( xs[ k + i ]));
+	if( std::isnan( truncated )){
+	  EXPECT_TRUE(std::isnan( b[i] ));
+	} else {
+	  EXPECT_EQ(b[i], truncated) << k + i;
+	}
+      }
+
+      Short_vector<double,16,32,avx_tag> y = SV::convert<double>( x );
+      for(std::ptrdiff_t i = 0; i < 16; ++i){
+	if( ! std::isnan( xs[ k + i ])){
+	  EXPECT_EQ(y[i], double( xs[ k + i ]));
+	}
+      }
+      vector_type z = SV::convert<float>( y*( 1.0 + std::ldexp( 1.0, -30 )));
+      for(std::ptrdiff_t i = 0; i < 16; ++i){
+	if( ! std::isnan( xs[ k + i ])){
+	  EXPECT_EQ(z[i], xs[ k + i ]);
+	}
+      }
+    }
+  } // end of test short_vector_avx.conversions
+
+
+  TEST( short_vector_avx, half_vectors )
+  {
+    namespace SV = ShortVector::Private;
+    using SV::half;
+    using SV::bfloat16;
+    using vector_type = Short_vector<half,16,32,avx_tag>;
+    using view_type = SV::Short_view<half,16,32,avx_tag>;
+    using array_type = SV::Short_vector_array<half,16,32,avx_tag>;
+
+    static_assert( sizeof(half) == 2 && sizeof(bfloat16) == 2 );
+
+    array_type xs( 100, 2 );
+    for(std::ptrdiff_t i = 0; i < 100; ++i){
+      xs( 0, i ) = half( float( i%11 )/8.0f );
+      xs( 1, i ) = half( 1.0f + float( i%7 ));
+    }
+
+    // A kernel written for short vectors of floats
+    vector_type a( 0.5f );
+    for(std::ptrdiff_t k = 0; k < xs.tiles(); ++k){
+      fma( a, vector_type::load( xs.data( 0 ) + 16*k ), vector_type::load( xs.data( 1 ) + 16*k ))
+	.store( xs.data( 1 ) + 16*k );
+    }
+    for(std::ptrdiff_t i = 0; i < 100; ++i){
+      float expected = float( half( 0.5f*float( half( float( i%11 )/8.0f )) + 1.0f + float( i%7 )));
+      EXPECT_EQ(float( xs( 1, i )), expected) << i;
+    }
+
+    // Views narrow on assignment and compute in floats
+    view_type v = xs.tile( 0, 1 );
+    v += vector_type( 1.0f );
+    v = v*half( 2.0f ) - 1.0f;
+    for(std::ptrdiff_t i = 16; i < 32; ++i){
+      float x = float( half( float( i%11 )/8.0f ));
+      EXPECT_EQ(float( xs( 0, i )), float( half( 2.0f*( x + 1.0f ) - 1.0f ))) << i;
+    }
+
+    // The arithmetic between a load and a store rounds as for floats
+    vector_type t = vector_type::load( SV::unaligned<half>{ xs.data( 0 ) + 3 });
+    vector_type u = ( t + 1.0f/4096.0f ) - t;
+    EXPECT_TRUE(all( u == vector_type( 1.0f/4096.0f )));
+    EXPECT_EQ(hsum( t ), hsum( t.wide()));
+
+    std::vector<bfloat16> bs( 40 ), cs( 40 );
+    for(std::ptrdiff_t i = 0; i < 40; ++i){
+      bs[i] = bfloat16( float( i*i ) + 0.25f );
+    }
+    SV::transform<Short_vector<bfloat16,16,32,avx_tag>>( bs.data(), 37, cs.data() + 1,
+      []( auto const& x ){ return sqrt( x ); });
+    EXPECT_EQ(cs[0].bits, 0);
+    EXPECT_EQ(cs[38].bits, 0);
+    for(std::ptrdiff_t i = 0; i < 37; ++i){
+      EXPECT_EQ(cs[ i + 1 ].bits, bfloat16( std::sqrt( float( bs[i] ))).bits) << i;
+    }
+  } // end of test short_vector_avx.half_vectors
+
+
+  TEST( short_vector_avx, matrices )
+  {
+    using ShortVector::Private::Short_matrix;
+    using matrix_type = Short_matrix<double,4,4,32,avx_tag>;
+    using vector_type = Short_vector<double,4,32,avx_tag>;
+
+    alignas(32) double values[16] = { 1.0, 2.0, 0.0, 1.0,  2.0, 5.0, 3.0, 2.0,
+				      -1.0, 1.0, 10.0, 1.0,  0.0, 1.0, 1.0, -3.0 };
+    matrix_type a = matrix_type::load( values );
+    matrix_type b = inverse( a );
+    matrix_type c = a*b;
+    matrix_type t = transpose( a );
+    EXPECT_EQ(determinant( a ), 1.0);
+    EXPECT_EQ(b( 0, 0 ), -161.0);
+    EXPECT_EQ(b( 2, 1 ), 11.0);
+    for(std::ptrdiff_t i = 0; i < 4; ++i){
+      for(std::ptrdiff_t j = 0; j < 4; ++j){
+	EXPECT_EQ(c( i, j ), i == j ? 1.0 : 0.0);
+	EXPECT_EQ(t( i, j ), values[ 4*j + i ]);
+      }
+    }
+    vector_type x = a*vector_type( 1.0, -1.0, 2.0, 0.5 );
+    EXPECT_EQ(x[1], 4.0);
+    EXPECT_EQ(x[3], -0.5);
+
+    alignas(32) double stored[16];
+    ( a + t*2.0 ).store( stored );
+    EXPECT_EQ(stored[1], 2.0 + 4.0);
+
+    using wide_type = Short_matrix<float,8,8,32,avx_tag>;
+    alignas(32) float ws[64];
+    for(std::ptrdiff_t i = 0; i < 64; ++i){
+      ws[i] = float( i%9 ) - float( i/8 );
+    }
+    wide_type w = wide_type::load( ws );
+    wide_type wt = transpose( w );
+    wide_type ww = w*wt;
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      for(std::ptrdiff_t j = 0; j < 8; ++j){
+	EXPECT_EQ(wt( i, j ), ws[ 8*j + i ]);
+	float expected = 0.0f;
+	for(std::ptrdiff_t k = 0; k < 8; ++k){
+	  expected += ws[ 8*i + k ]*ws[ 8*j + k ];
+	}
+	EXPECT_EQ(ww( i, j ), expected) << i << ' ' << j;
+      }
+    }
+  } // end of test short_vector_avx.matrices
+
+
+  /** The array of f( i ) for i from 0 to N - 1 */
+  template< typename V, std::size_t N, typename F, std::size_t ... I >
+  std::array<V,N>
+  generate_array( F const& f, std::index_sequence<I...> ){
+    return {{ f( std::ptrdiff_t( I )) ... }};
+  }
+
+  template< typename V, std::size_t N, typename F >
+  std::array<V,N>
+  generate_array( F const& f ){
+    return generate_array<V,N>( f, std::make_index_sequence<N>{} );
+  }
+
+  TEST( short_vector_avx, solves )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<double,8,32,avx_tag>;
+    constexpr std::size_t n = 5;
+    using row_type = std::array<vector_type,n>;
+
+    // Lane 0 needs pivoting from the first step, lane 3 is singular
+    auto value = []( std::ptrdiff_t lane, std::ptrdiff_t i, std::ptrdiff_t j ){
+      if( lane == 0 && i == 0 && j == 0 ) return 0.0;
+      if( lane == 3 && i == 4 ) return double( j + 1 );
+      if( lane == 3 && i == 3 ) return double( 2*j + 2 );
+      return double(( 3*i + 7*j + 5*lane )%11 ) - 4.0 + ( i == j ? double( lane ) : 0.0 );
+    };
+    SV::Batched_matrix<vector_type,n> a = generate_array<row_type,n>( [&]( std::ptrdiff_t i ){
+      return generate_array<vector_type,n>( [&]( std::ptrdiff_t j ){
+	return vector_type( [&]( std::ptrdiff_t k ){ return value( k, i, j ); }, function_tag{} );
+      });
+    });
+    SV::Batched_vector<vector_type,n> b = generate_array<vector_type,n>( []( std::ptrdiff_t i ){
+      return vector_type( [i]( std::ptrdiff_t k ){ return double( i - k ); }, function_tag{} );
+    });
+    SV::Batched_matrix<vector_type,n> lu = a;
+    SV::Batched_vector<vector_type,n> x = b;
+    SV::Batched_vector<vector_type,n> pivots = b;
+    auto nonsingular = SV::lu_factor( lu, pivots );
+    SV::lu_solve( lu, pivots, x );
+
+    EXPECT_EQ(popcount( nonsingular ), 7);
+    EXPECT_FALSE(nonsingular[3]);
+    EXPECT_NE(pivots[0][0], 0.0);
+    for(std::ptrdiff_t k = 0; k < 8; ++k){
+      if( k == 3 ) continue;
+      for(std::size_t i = 0; i < n; ++i){
+	double r = 0.0;
+	for(std::size_t j = 0; j < n; ++j){
+	  r += a[i][j][k]*x[j][k];
+	}
+	EXPECT_NEAR(r, b[i][k], 1e-12) << k << ' ' << i;
+      }
+    }
+
+    // A NaN pivot marks its lane singular, too
+    lu = a;
+    for(std::size_t j = 0; j < n; ++j){
+      lu[0][j][5] = std::numeric_limits<double>::quiet_NaN();
+    }
+    nonsingular = SV::lu_factor( lu, pivots );
+    EXPECT_EQ(popcount( nonsingular ), 6);
+    EXPECT_FALSE(nonsingular[5]);
+
+    // A = M Mᵀ + I is positive definite, -I is not
+    alignas(32) double lanes[3][3][4];
+    for(std::ptrdiff_t i = 0; i < 3; ++i){
+      for(std::ptrdiff_t j = 0; j < 3; ++j){
+	for(std::ptrdiff_t k = 0; k < 4; ++k){
+	  double sum = i == j ? ( k == 2 ? -1.0 : 1.0 ) : 0.0;
+	  for(std::ptrdiff_t m = 0; m < 3 && k != 2; ++m){
+	    sum += double(( i + m + k )%4 )*double(( j + m + k )%4 );
+	  }
+	  lanes[i][j][k] = sum;
+	}
+      }
+    }
+    SV::Batched_matrix<m256d,3> l;
+    SV::Batched_vector<m256d,3> y;
+    for(std::size_t i = 0; i < 3; ++i){
+      for(std::size_t j = 0; j < 3; ++j){
+	l[i][j] = m256d( lanes[i][j] );
+      }
+      y[i] = m256d( double( i ) + 1.0 );
+    }
+    auto definite = SV::cholesky_factor( l );
+    SV::cholesky_solve( l, y );
+    EXPECT_EQ(popcount( definite ), 3);
+    EXPECT_FALSE(definite[2]);
+
+    alignas(32) double solution[3][4];
+    for(std::size_t i = 0; i < 3; ++i){
+      y[i].store( solution[i] );
+    }
+    for(std::ptrdiff_t k = 0; k < 4; ++k){
+      if( k == 2 ) continue;
+      for(std::ptrdiff_t i = 0; i < 3; ++i){
+	double r = 0.0;
+	for(std::ptrdiff_t j = 0; j < 3; ++j){
+	  r += lanes[i][j][k]*solution[j][k];
+	}
+	EXPECT_NEAR(r, double( i ) + 1.0, 1e-12) << k << ' ' << i;
+      }
+    }
+  } // end of test short_vector_avx.solves
+
+
+  TEST( short_vector_avx, algorithms )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<float,16,32,avx_tag>;
+    std::vector<float> xs( 203 ), ys( 203 ), zs( 203, -1.0f );
+    for(std::ptrdiff_t i = 0; i < 203; ++i){
+      xs[i] = float( i%17 ) - 8.0f;
+      ys[i] = float( i%5 );
+    }
+
+    auto threshold = SV::streaming_threshold();
+    for(std::ptrdiff_t streaming = 0; streaming < 2; ++streaming){
+      SV::streaming_threshold() = streaming ? 0 : threshold;
+      for(std::ptrdiff_t offset = 0; offset < 3; ++offset){
+	std::ptrdiff_t n = 200 - offset;
+	SV::transform<vector_type>( xs.data() + offset, n, zs.data() + offset + 1,
+				    []( vector_type const& x ){ return abs( x ) + 1.0f; });
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  EXPECT_EQ(zs[ offset + 1 + i ], std::abs( xs[ offset + i ]) + 1.0f);
+	}
+	EXPECT_EQ(zs[ offset + 1 + n ], -1.0f);
+
+	SV::transform<vector_type>( xs.data(), ys.data() + offset, n, zs.data(),
+				    []( vector_type const& x, vector_type const& y ){ return x*y; });
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  EXPECT_EQ(zs[i], xs[i]*ys[ offset + i ]);
+	}
+
+	SV::fill<vector_type>( zs.data() + offset, n, 2.5f );
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  EXPECT_EQ(zs[ offset + i ], 2.5f);
+	}
+	zs[ offset + n ] = -1.0f;
+      }
+    }
+    SV::streaming_threshold() = threshold;
+
+    SV::for_each<vector_type>( zs.data() + 3, 37, []( vector_type& x ){ x = 2.0f*x + 1.0f; });
+    for(std::ptrdiff_t i = 2; i < 41; ++i){
+      EXPECT_EQ(zs[i], i > 2 && i < 40 ? 6.0f : 2.5f);
+    }
+
+    auto plus = []( auto const& a, auto const& b ){ return a + b; };
+    auto larger = []( auto const& a, auto const& b ){ using std::max; return max( a, b ); };
+    for(std::ptrdiff_t n : { 0, 5, 16, 37, 203 }){
+      float sum = 0.0f, largest = -100.0f, inner = 0.0f;
+      for(std::ptrdiff_t i = 0; i < n; ++i){
+	sum += xs[i]*xs[i];
+	largest = std::max( largest, xs[i] + 1.0f );
+	inner += xs[i]*ys[i];
+      }
+      EXPECT_EQ(SV::transform_reduce<vector_type>( xs.data(), n, 0.0f, plus,
+						    []( vector_type const& x ){ return x*x; }), sum) << n;
+      EXPECT_EQ(SV::transform_reduce<vector_type>( xs.data() + 1, n, 0.0f, plus,
+						    []( vector_type const& x ){ return x*x; }),
+		SV::transform_reduce<vector_type>( xs.data(), n + 1, 0.0f, plus,
+						   []( vector_type const& x ){ return x*x; }) - 64.0f) << n;
+      EXPECT_EQ(SV::transform_reduce<vector_type>( xs.data(), n, -100.0f, larger,
+						    []( vector_type const& x ){ return x + 1.0f; }), largest) << n;
+      EXPECT_EQ(SV::transform_reduce<vector_type>( xs.data(), ys.data(), n, 0.0f, plus,
+						    []( vector_type const& x, vector_type const& y ){ return x*y; }),
+		inner) << n;
+    }
+
+    using long_type = Short_vector<std::int64_t,8,32,avx_tag>;
+    std::vector<std::int64_t> lengths( 203 ), offsets( 204, -1 );
+    for(std::ptrdiff_t i = 0; i < 203; ++i){
+      lengths[i] = i%13 + 1;
+    }
+    for(std::ptrdiff_t offset = 0; offset < 3; ++offset){
+      std::ptrdiff_t n = 200 - offset;
+      std::vector<std::int64_t> expected( n + 1, 5 );
+      std::partial_sum( lengths.begin() + offset, lengths.begin() + offset + n, expected.begin() + 1 );
+      for(std::ptrdiff_t i = 1; i <= n; ++i){
+	expected[i] += 5;
+      }
+
+      EXPECT_EQ(SV::exclusive_scan<long_type>( lengths.data() + offset, n, offsets.data() + 1, 5 ), expected[n]);
+      for(std::ptrdiff_t i = 0; i < n; ++i){
+	ASSERT_EQ(offsets[ 1 + i ], expected[i]) << offset << ' ' << i;
+      }
+      EXPECT_EQ(offsets[ 1 + n ], -1);
+
+      EXPECT_EQ(SV::inclusive_scan<long_type>( lengths.data() + offset, n, offsets.data(), 5 ), expected[n]);
+      for(std::ptrdiff_t i = 0; i < n; ++i){
+	ASSERT_EQ(offsets[i], expected[ i + 1 ]) << offset << ' ' << i;
+      }
+      offsets[n] = -1;
+
+      std::copy( xs.begin(), xs.end(), zs.begin());
+      float sum = SV::inclusive_scan<vector_type>( zs.data() + offset, n, zs.data() + offset );
+      float total = 0.0f;
+      for(std::ptrdiff_t i = 0; i < n; ++i){
+	total += xs[ offset + i ];
+	ASSERT_EQ(zs[ offset + i ], total) << offset << ' ' << i;
+      }
+      EXPECT_EQ(sum, total);
+    }
+    
+  } // end of test short_vector_avx.algorithms
+
+
+  TEST( short_vector_avx, parallel )
+  {
+    namespace SV = ShortVector::Private;
+    using vector_type = Short_vector<double,12,32,avx_tag>;
+    SV::Thread_pool pool( 3 );
+    EXPECT_EQ(pool.size(), 3);
+
+    std::ptrdiff_t size = 50000;
+    std::vector<double> xs( size ), ys( size ), zs( size + 2, -1.0 );
+    for(std::ptrdiff_t i = 0; i < size; ++i){
+      xs[i] = double( i%23 ) - 11.0;
+      ys[i] = double( i%7 );
+    }
+
+    auto plus = []( auto const& a, auto const& b ){ return a + b; };
+    for(std::ptrdiff_t n : { 0, 7, 1000, 49997 }){
+      for(std::ptrdiff_t offset = 0; offset < 3; ++offset){
+	SV::Parallel::transform<vector_type>( xs.data() + offset, n, zs.data() + offset + 1,
+					      []( vector_type const& x ){ return 2.0*x; }, pool );
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  ASSERT_EQ(zs[ offset + 1 + i ], 2.0*xs[ offset + i ]) << n << ' ' << i;
+	}
+	EXPECT_EQ(zs[ offset + 1 + n ], -1.0);
+
+	SV::Parallel::transform<vector_type>( xs.data(), ys.data() + offset, n, zs.data() + offset,
+					      []( vector_type const& x, vector_type const& y ){ return x*y; },
+					      pool );
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  ASSERT_EQ(zs[ offset + i ], xs[i]*ys[ offset + i ]) << n << ' ' << i;
+	}
+
+	SV::Parallel::for_each<vector_type>( zs.data() + offset, n, []( vector_type& x ){ x = x + 1.0; },
+					     pool );
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  ASSERT_EQ(zs[ offset + i ], xs[i]*ys[ offset + i ] + 1.0) << n << ' ' << i;
+	}
+
+	SV::Parallel::fill<vector_type>( zs.data() + offset, n, 0.5, pool );
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  ASSERT_EQ(zs[ offset + i ], 0.5) << n << ' ' << i;
+	}
+	zs[ offset + n ] = -1.0;
+
+	double sum = 1.0, inner = 0.0;
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  sum += xs[ offset + i ];
+	  inner += xs[ offset + i ]*ys[i];
+	}
+	EXPECT_EQ(SV::Parallel::reduce<vector_type>( xs.data() + offset, n, 1.0, plus, pool ), sum) << n;
+	EXPECT_EQ(SV::reduce<vector_type>( xs.data() + offset, n, 1.0, plus ), sum) << n;
+	EXPECT_EQ(SV::Parallel::transform_reduce<vector_type>(
+		    xs.data() + offset, ys.data(), n, 0.0, plus,
+		    []( vector_type const& x, vector_type const& y ){ return x*y; }, pool ), inner) << n;
+
+	zs[ 1 + n ] = -1.0;
+	EXPECT_EQ(SV::Parallel::exclusive_scan<vector_type>( xs.data() + offset, n, zs.data() + 1, 1.0, pool ),
+		  sum) << n;
+	double total = 1.0;
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  ASSERT_EQ(zs[ 1 + i ], total) << n << ' ' << i;
+	  total += xs[ offset + i ];
+	}
+	EXPECT_EQ(zs[ 1 + n ], -1.0);
+
+	EXPECT_EQ(SV::Parallel::inclusive_scan<vector_type>( xs.data() + offset, n, zs.data() + offset, 0.0, pool ),
+		  sum - 1.0) << n;
+	total = 0.0;
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+	  total += xs[ offset + i ];
+	  ASSERT_EQ(zs[ offset + i ], total) << n << ' ' << i;
+	}
+	zs[ offset + n ] = -1.0;
+      }
+    }
+
+    EXPECT_THROW(pool.parallel_for( 10, []( std::ptrdiff_t k ){ if( k == 7 ) throw std::runtime_error( "7" ); }),
+		 std::runtime_error);
+
+    SV::Thread_pool pinned( 2, true );
+    std::vector<std::ptrdiff_t> calls( 100, 0 );
+    pinned.parallel_for( 100, [&]( std::ptrdiff_t k ){ ++calls[k]; });
+    EXPECT_EQ(std::count( calls.begin(), calls.end(), 1 ), 100);
+
+  } // end of test short_vector_avx.parallel
+
+
+  TEST( short_vector_avx, reductions )
+  {
+    Short_vector<double,12,32,avx_tag> xs([](auto x){ return double((x*7) % 12) - 5.0; }, function_tag{});
+    Short_vector<double,12,32,avx_tag> ys([](auto y){ return double(y + 1); }, function_tag{});
+
+    double sum = 0.0, product = 1.0, inner = 0.0;
+    for(std::ptrdiff_t i = 0; i < 12; ++i){
+      sum += xs[i];
+      product *= xs[i] + 5.5;
+      inner += xs[i]*ys[i];
+    }
+
+    EXPECT_EQ(hsum( xs ), sum);
+    EXPECT_EQ(hprod( xs + 5.5 ), product);
+    EXPECT_EQ(dot( xs, ys ), inner);
+    EXPECT_EQ(hmin( xs ), -5.0);
+    EXPECT_EQ(hmax( xs ), 6.0);
+    EXPECT_EQ(argmin( xs ), 0);
+    EXPECT_EQ(argmax( xs ), 5);
+    EXPECT_EQ(find_first( xs > 100.0 ), 12);
+    
+  } // end of test short_vector_avx.reductions
+
+  TEST( short_vector_avx, shuffle )
+  {
+    using ShortVector::Private::shuffle;
+    Short_vector<float,16,32,avx_tag> xs([](auto x){ return float(x + 1); }, function_tag{});
+    Short_vector<float,16,32,avx_tag> ys([](auto y){ return -float(y + 1); }, function_tag{});
+    Short_vector<float,24,32,avx_tag> zs([](auto z){ return float(z); }, function_tag{});
+
+    auto reversed = reverse( xs );
+    auto rotated = rotate<4>( xs );
+    auto low = interleave_low( xs, ys );
+    auto high = interleave_high( xs, ys );
+    auto broadcasted = broadcast<11>( xs );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_EQ(reversed[i], xs[15 - i]);
+      EXPECT_EQ(rotated[i], xs[(i + 4) % 16]);
+      EXPECT_EQ(low[i], i % 2 ? ys[i/2] : xs[i/2]);
+      EXPECT_EQ(high[i], i % 2 ? ys[8 + i/2] : xs[8 + i/2]);
+      EXPECT_EQ(broadcasted[i], 12.0f);
+    }
+
+    auto transposed = shuffle<0, 8, 16, 1, 9, 17, 2, 10, 18, 3, 11, 19,
+			      4, 12, 20, 5, 13, 21, 6, 14, 22, 7, 15, 23>( zs );
+    for(std::ptrdiff_t i = 0; i < 24; ++i){
+      EXPECT_EQ(transposed[i], float(i % 3 * 8 + i / 3));
+    }
+    
+  } // end of test short_vector_avx.shuffle
+
+  TEST( short_vector_avx, math )
+  {
+    Short_vector<float,16,32,avx_tag> xs([](auto x){ return 0.75f*float(x) - 5.5f; }, function_tag{});
+    Short_vector<double,8,32,avx_tag> ys([](auto y){ return 1.25*double(y) - 4.0; }, function_tag{});
+
+    auto exps = exp( xs );
+    auto logs = log( abs( xs ));
+    auto roots = pow( abs( xs ), Short_vector<float,16,32,avx_tag>( 0.5f ));
+    auto sines = sin( xs );
+    auto tanhs = tanh( xs );
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_FLOAT_EQ(exps[i], std::exp( xs[i] ));
+      EXPECT_FLOAT_EQ(logs[i], std::log( std::abs( xs[i] )));
+      EXPECT_FLOAT_EQ(roots[i], std::sqrt( std::abs( xs[i] )));
+      EXPECT_FLOAT_EQ(sines[i], std::sin( xs[i] ));
+      EXPECT_FLOAT_EQ(tanhs[i], std::tanh( xs[i] ));
+    }
+
+    auto sines_d = ys;
+    auto cosines_d = ys;
+    sincos( ys, sines_d, cosines_d );
+    auto erfs_d = erf( ys );
+    auto angles_d = atan2( ys, Short_vector<double,8,32,avx_tag>( -1.0 ));
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_DOUBLE_EQ(sines_d[i], std::sin( ys[i] ));
+      EXPECT_DOUBLE_EQ(cosines_d[i], std::cos( ys[i] ));
+      EXPECT_DOUBLE_EQ(erfs_d[i], std::erf( ys[i] ));
+      EXPECT_DOUBLE_EQ(angles_d[i], std::atan2( ys[i], -1.0 ));
+    }
+
+    auto exponents = ys;
+    auto significands = frexp( ys, exponents );
+    auto scaled = ldexp( significands, exponents );
+    auto floors = floor( ys );
+    auto rounded = round( ys );
+    auto smaller = min( ys, floors + 0.5 );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      int e;
+      EXPECT_EQ(significands[i], std::frexp( ys[i], &e ));
+      EXPECT_EQ(exponents[i], double( e ));
+      EXPECT_EQ(scaled[i], ys[i]);
+      EXPECT_EQ(floors[i], std::floor( ys[i] ));
+      EXPECT_EQ(rounded[i], std::nearbyint( ys[i] ));
+      EXPECT_EQ(smaller[i], std::min( ys[i], std::floor( ys[i] ) + 0.5 ));
+    }
+
+    auto positive = abs( ys ) + 0.125;
+    auto estimates = inverse_sqrt<fast_tag>( positive );
+    auto refined = inverse_sqrt<balanced_tag>( positive );
+    auto exact = inverse_sqrt( positive );
+    auto inverses = reciprocal<balanced_tag>( xs );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      double r = 1/std::sqrt( positive[i] );
+      EXPECT_EQ(estimates[i], rsqrt( positive )[i]);
+      EXPECT_NEAR(estimates[i], r, 0x1.8p-12*r);
+      EXPECT_NEAR(refined[i], r, 0x1p-50*r);
+      EXPECT_EQ(exact[i], 1.0/std::sqrt( positive[i] ));
+    }
+    for(std::ptrdiff_t i = 0; i < 16; ++i){
+      EXPECT_NEAR(inverses[i], 1.0/xs[i], 0x1p-21/std::abs( xs[i] ));
+    }
+    
+  } // end of test short_vector_avx.math
+
+  TEST( short_vector_avx, complex_values )
+  {
+    using C = std::complex<float>;
+    using V = Short_vector<C,8,32,avx_tag>;
+    alignas(32) C xs[8], ys[8], zs[8];
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      xs[i] = C( float( i ) - 3.5f, 0.25f*float( i ));
+      ys[i] = C( 2.0f - 0.5f*float( i ), float( i % 3 ) - 1.0f );
+    }
+    V x = V::load( xs ), y = V::load( ys );
+
+    x *= y;
+    x.store( zs );
+    auto magnitudes = norm( split( x, y ));
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      EXPECT_EQ(zs[i], xs[i]*ys[i]);
+      EXPECT_EQ(magnitudes[i], std::norm( zs[i] ));
+      EXPECT_EQ(magnitudes[i + 8], std::norm( ys[i] ));
+    }
+
+    ( x/y ).store( zs );
+    for(std::ptrdiff_t i = 0; i < 8; ++i){
+      if( std::norm( ys[i] ) > 0 ){
+	EXPECT_LE(std::abs( zs[i] - xs[i] ), 1e-6f*std::abs( xs[i] ) + 1e-6f);
+      }
+    }
+    
+  } // end of test short_vector_avx.complex_values
+
+} // end of namespace